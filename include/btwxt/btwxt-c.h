@@ -0,0 +1,92 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#ifndef BTWXT_C_H_
+#define BTWXT_C_H_
+
+/* C interface to Btwxt::RegularGridInterpolator for callers that cannot use C++ (e.g., Fortran or
+ * Modelica through a foreign function interface). Functions never throw; each returns a status
+ * code, and the message of the most recent error on the calling thread is available from
+ * btwxt_get_last_error_message. Results are written into caller-provided buffers. An interpolator
+ * may be used by one thread at a time. */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct btwxt_interpolator btwxt_interpolator; /* Opaque handle */
+
+typedef enum btwxt_status {
+    BTWXT_SUCCESS = 0,
+    BTWXT_ERROR_INVALID_ARGUMENT = 1, /* A null pointer or an unknown method */
+    BTWXT_ERROR_INTERPOLATOR = 2,     /* An error reported by the interpolator (e.g., a target
+                                         beyond the extrapolation limits) */
+    BTWXT_ERROR_OUT_OF_MEMORY = 3,
+    BTWXT_ERROR_UNKNOWN = 4
+} btwxt_status;
+
+typedef enum btwxt_interpolation_method {
+    BTWXT_INTERPOLATION_LINEAR = 0,
+    BTWXT_INTERPOLATION_CUBIC = 1,
+    BTWXT_INTERPOLATION_SIMPLEX = 2
+} btwxt_interpolation_method;
+
+typedef enum btwxt_extrapolation_method {
+    BTWXT_EXTRAPOLATION_CONSTANT = 0,
+    BTWXT_EXTRAPOLATION_LINEAR = 1
+} btwxt_extrapolation_method;
+
+/* Creates an interpolator. axis_values holds the values of each axis in turn (axis_lengths[i]
+ * values for axis i). grid_point_data holds number_of_data_sets data sets in turn, each with a
+ * value for every grid point in row-major order (the last axis varies fastest). The arrays are
+ * copied. */
+btwxt_status btwxt_create_interpolator(size_t number_of_axes,
+                                       const size_t* axis_lengths,
+                                       const double* axis_values,
+                                       size_t number_of_data_sets,
+                                       const double* grid_point_data,
+                                       btwxt_interpolator** interpolator);
+
+void btwxt_destroy_interpolator(btwxt_interpolator* interpolator);
+
+btwxt_status btwxt_set_axis_interpolation_method(btwxt_interpolator* interpolator,
+                                                 size_t axis_index,
+                                                 btwxt_interpolation_method method);
+
+btwxt_status btwxt_set_axis_extrapolation_method(btwxt_interpolator* interpolator,
+                                                 size_t axis_index,
+                                                 btwxt_extrapolation_method method);
+
+btwxt_status btwxt_set_axis_extrapolation_limits(btwxt_interpolator* interpolator,
+                                                 size_t axis_index,
+                                                 double lower_limit,
+                                                 double upper_limit);
+
+btwxt_status btwxt_get_number_of_dimensions(const btwxt_interpolator* interpolator,
+                                            size_t* number_of_dimensions);
+
+btwxt_status btwxt_get_number_of_data_sets(const btwxt_interpolator* interpolator,
+                                           size_t* number_of_data_sets);
+
+/* Writes a result for each data set */
+btwxt_status
+btwxt_evaluate(btwxt_interpolator* interpolator, const double* target, double* results);
+
+/* targets holds number_of_targets rows of a value for each dimension; results receives
+ * number_of_targets rows of a result for each data set */
+btwxt_status btwxt_evaluate_batch(btwxt_interpolator* interpolator,
+                                  const double* targets,
+                                  size_t number_of_targets,
+                                  double* results);
+
+/* Message of the most recent error on the calling thread (empty if none). Valid until the next
+ * failing call on the thread. */
+const char* btwxt_get_last_error_message(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* define BTWXT_C_H_ */
@@ -8,5 +8,10 @@
 #include "messaging.h"
 #include "regular-grid-interpolator.h"
 #include "grid-point-data.h"
+#include "task-executor.h"
+#include "table-generator.h"
+#include "chebyshev-surrogate.h"
+#include "sparse-grid-interpolator.h"
+#include "tracing.h"
 
 #endif // define BTWXT_H_
\ No newline at end of file
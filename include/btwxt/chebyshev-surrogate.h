@@ -0,0 +1,109 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// btwxt
+#include "messaging.h"
+#include "regular-grid-interpolator.h"
+#include "task-executor.h"
+
+namespace Btwxt {
+
+class ChebyshevSurrogate : public Courier::Sender {
+    // Tensor-product Chebyshev polynomial fitted to an interpolator's results over a region of its
+    // grid, for smooth, low-dimensional tables where evaluating a polynomial is cheaper than a
+    // table lookup. Each data set is interpolated at Chebyshev points (of the first kind) along
+    // every axis. The number of points along an axis is doubled, starting from two, for the axes
+    // whose highest-degree coefficients are largest, until the surrogate reproduces the table
+    // within tolerance. Errors are measured at the grid points and cell midpoints of the fitted
+    // region. Targets outside the fitted region are evaluated by (a copy of) the interpolator.
+  public:
+    // fitted_region holds the lower and upper bounds of each axis (the whole grid if empty)
+    ChebyshevSurrogate(
+        const RegularGridInterpolator& interpolator,
+        double tolerance,
+        std::vector<std::pair<double, double>> fitted_region = {},
+        std::size_t maximum_points_per_axis = 64,
+        const TaskExecutor& executor = nullptr,
+        std::string name = "Unnamed ChebyshevSurrogate",
+        const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
+
+    double get_value_at_target(const std::vector<double>& target, std::size_t data_set_index);
+
+    double operator()(const std::vector<double>& target, const std::size_t data_set_index)
+    {
+        return get_value_at_target(target, data_set_index);
+    }
+
+    std::vector<double> get_values_at_target(const std::vector<double>& target);
+
+    std::vector<double> operator()(const std::vector<double>& target)
+    {
+        return get_values_at_target(target);
+    }
+
+    std::vector<std::vector<double>>
+    get_values_at_targets(const std::vector<std::vector<double>>& targets);
+
+    [[nodiscard]] bool is_in_fitted_region(const std::vector<double>& target) const;
+
+    [[nodiscard]] const std::vector<std::pair<double, double>>& get_fitted_region() const
+    {
+        return fitted_region;
+    }
+
+    // Number of Chebyshev points (polynomial degree plus one) along each axis
+    [[nodiscard]] const std::vector<std::size_t>& get_points_per_axis() const
+    {
+        return points_per_axis;
+    }
+
+    // For each data set
+    [[nodiscard]] std::size_t get_number_of_coefficients() const;
+
+    // Maximum difference from the interpolator, for each data set, at the grid points and cell
+    // midpoints of the fitted region
+    [[nodiscard]] const std::vector<double>& get_maximum_errors() const { return maximum_errors; }
+
+    // Time taken by the interpolator divided by the time taken by the surrogate to evaluate a
+    // sample of targets within the fitted region (measured when fitted)
+    [[nodiscard]] double get_speedup() const { return speedup; }
+
+    RegularGridInterpolator& get_interpolator() { return interpolator; }
+
+  private:
+    RegularGridInterpolator interpolator; // Evaluates targets outside the fitted region
+    std::size_t number_of_dimensions;
+    std::size_t number_of_data_sets;
+    std::vector<std::pair<double, double>> fitted_region;
+    std::vector<std::size_t> points_per_axis;
+    std::vector<std::vector<double>> coefficients; // For each data set, in row-major order
+    std::vector<double> maximum_errors;
+    double speedup {1.0};
+
+    // Evaluation scratch space
+    std::vector<std::vector<double>> chebyshev_polynomials; // T_j of each axis at the target
+    std::vector<double> contraction;
+    std::vector<double> results;
+
+    void fit(double tolerance,
+             std::size_t maximum_points_per_axis,
+             const TaskExecutor& executor);
+
+    void calculate_coefficients(const std::vector<double>& values_at_chebyshev_points);
+
+    void set_chebyshev_polynomials(const std::vector<double>& target);
+
+    double evaluate_data_set(std::size_t data_set_index);
+
+    void measure_speedup(const std::vector<std::vector<double>>& sample_targets);
+};
+
+} // namespace Btwxt
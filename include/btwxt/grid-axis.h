@@ -17,7 +17,11 @@
 
 namespace Btwxt {
 
-enum class InterpolationMethod { linear, cubic };
+// Axes interpolated with simplex share one simplex of each grid cell: the cell is divided into
+// simplices (Kuhn triangulation) by the order of the target's fractions along those axes, and only
+// the simplex's vertices (one more than the number of simplex axes) are weighted. Along a single
+// axis, simplex is the same as linear.
+enum class InterpolationMethod { linear, cubic, simplex };
 enum class ExtrapolationMethod { constant, linear };
 
 class RegularGridInterpolatorImplementation;
@@ -73,8 +77,32 @@ class GridAxis : public Courier::Sender {
     [[nodiscard]] const std::vector<double>&
     get_cubic_spacing_ratios(std::size_t floor_or_ceiling) const;
 
+    // Index of the last value at or below value, within [0, length - 2] (0 for a single value).
+    // The search walks the values' search tree without branches, taking the same number of steps
+    // for any value.
+    [[nodiscard]] std::size_t get_floor_index(double value) const
+    {
+        std::size_t node = 1u;
+        for (std::size_t depth = 0; depth < search_tree_height; ++depth) {
+            node = 2u * node + static_cast<std::size_t>(search_tree[node] <= value);
+        }
+        const std::size_t number_at_or_below = node - (std::size_t {1u} << search_tree_height);
+        const std::size_t maximum_floor_index = std::max(values.size(), std::size_t {2u}) - 2u;
+        return std::min(number_at_or_below - static_cast<std::size_t>(number_at_or_below > 0u),
+                        maximum_floor_index);
+    }
+
+    // Values in Eytzinger (breadth-first) order, starting at index 1: the children of element k
+    // are elements 2k and 2k + 1. The tree is padded with infinity to be complete, so that every
+    // search has search_tree_height steps. After the last step, k - 2^search_tree_height is the
+    // number of values at or below the searched value.
+    [[nodiscard]] const std::vector<double>& get_search_tree() const { return search_tree; }
+    [[nodiscard]] std::size_t get_search_tree_height() const { return search_tree_height; }
+
   private:
     std::vector<double> values;
+    std::vector<double> search_tree;
+    std::size_t search_tree_height {0u};
     InterpolationMethod interpolation_method {InterpolationMethod::linear};
     ExtrapolationMethod extrapolation_method {ExtrapolationMethod::constant};
     std::pair<double, double> extrapolation_limits {-DBL_MAX, DBL_MAX};
@@ -84,6 +112,7 @@ class GridAxis : public Courier::Sender {
                               // of axis values, but the floor vector doesn't use the first entry
                               // and the ceiling doesn't use the last entry.
     void calculate_cubic_spacing_ratios();
+    void build_search_tree();
     void check_grid_sorted();
     void check_extrapolation_limits();
 };
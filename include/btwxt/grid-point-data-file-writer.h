@@ -0,0 +1,61 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// btwxt
+#include "grid-point-data.h"
+#include "messaging.h"
+
+namespace Btwxt {
+
+class GridPointDataFileWriter : public Courier::Sender {
+    // Writes grid point data in the binary block format read by
+    // RegularGridInterpolator::set_grid_point_data_file. Data for one grid point (a value for each
+    // data set) is appended at a time, in row-major order, so tables need not fit in memory. Each
+    // block of block_size grid points is stored contiguously (interleaved by grid point) in native
+    // byte order.
+  public:
+    GridPointDataFileWriter(
+        const std::string& path,
+        const std::vector<std::string>& data_set_names,
+        std::uint64_t number_of_grid_points,
+        std::uint64_t block_size = 4096,
+        const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
+
+    ~GridPointDataFileWriter();
+
+    GridPointDataFileWriter(const GridPointDataFileWriter&) = delete;
+
+    GridPointDataFileWriter& operator=(const GridPointDataFileWriter&) = delete;
+
+    void append(const std::vector<double>& grid_point_values);
+
+    // Sends an error if fewer grid points were appended than declared
+    void close();
+
+  private:
+    std::ofstream file;
+    std::uint64_t number_of_data_sets;
+    std::uint64_t number_of_grid_points;
+    std::uint64_t block_size;
+    std::uint64_t number_of_appended_grid_points {0u};
+    std::vector<double> block_values; // Current (partial) block
+
+    void write_block();
+};
+
+void write_grid_point_data_file(
+    const std::string& path,
+    const std::vector<GridPointDataSet>& grid_point_data_sets,
+    std::uint64_t block_size = 4096,
+    const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
+
+} // namespace Btwxt
@@ -16,6 +16,12 @@
 
 namespace Btwxt {
 
+enum class GridPointDataLayout {
+    row_major, // Last axis varies fastest (the order grid point data is provided in)
+    blocked    // Grid points are grouped into hyper-rectangular blocks so that neighboring grid
+               // points along every axis are stored close to each other
+};
+
 class GridPointDataSet {
     // Data corresponding to all points within a collection of grid axes. Length of data should
     // equal the total number of permutations of grid axes points.
@@ -31,4 +37,10 @@ class GridPointDataSet {
     std::string name;
 };
 
+struct GridPointDataPagingStatistics {
+    std::size_t number_of_block_reads {0u};
+    std::size_t number_of_resident_blocks {0u};
+    std::size_t maximum_number_of_resident_blocks {0u};
+};
+
 } // namespace Btwxt
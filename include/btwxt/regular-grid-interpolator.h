@@ -5,6 +5,7 @@
 
 // Standard
 #include <functional>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #include "grid-axis.h"
 #include "grid-point-data.h"
 #include "messaging.h"
+#include "task-executor.h"
 
 namespace Btwxt {
 
@@ -27,42 +29,103 @@ enum class TargetBoundsStatus {
     above_upper_extrapolation_limit
 };
 
+struct ResultCacheStatistics {
+    std::size_t number_of_hits {0u};
+    std::size_t number_of_misses {0u};
+    std::size_t number_of_evictions {0u};
+    std::size_t number_of_entries {0u};
+    std::size_t memory_size {0u}; // Estimated, in bytes
+
+    [[nodiscard]] double get_hit_rate() const
+    {
+        std::size_t number_of_lookups = number_of_hits + number_of_misses;
+        return number_of_lookups > 0u
+                   ? static_cast<double>(number_of_hits) / static_cast<double>(number_of_lookups)
+                   : 0.0;
+    }
+};
+
+struct MemoryUsage { // Estimated, in bytes
+    std::size_t grid_axes {0u};       // Axis values and cubic spacing ratios
+    std::size_t grid_point_data {0u}; // Stored (or compressed, resident paged, or mapped shared
+                                      // table) grid point data, which may be shared with copies of
+                                      // the interpolator (or other processes)
+    std::size_t hypercube_cache {0u};
+    std::size_t result_cache {0u};
+    std::size_t scratch {0u}; // Target state, weights, and gathered or decoded grid point data
+
+    [[nodiscard]] std::size_t get_total() const
+    {
+        return grid_axes + grid_point_data + hypercube_cache + result_cache + scratch;
+    }
+};
+
+struct EvaluationCost {
+    // Number of axes evaluated with each method (a combination reachable within the extrapolation
+    // limits of each axis)
+    std::size_t number_of_constant_axes {0u};
+    std::size_t number_of_linear_axes {0u};
+    std::size_t number_of_cubic_axes {0u};
+    std::size_t number_of_simplex_axes {0u};
+    std::size_t number_of_vertices {0u}; // Grid points weighted for each target (at most)
+    std::size_t bytes_gathered {0u};     // Grid point data read for each target (at most, when the
+                                         // hypercube is not already cached)
+};
+
+enum class SharedTableStorage {
+    shared_memory, // POSIX shared memory object (the name begins with '/')
+    file           // Memory-mapped file (the name is a path)
+};
+
+enum class InverseSolutionStatus { unique, multiple, none };
+
+struct InverseSolution {
+    InverseSolutionStatus status {InverseSolutionStatus::none};
+    std::vector<double> axis_values; // Every solution, in ascending order
+    bool is_monotonic {true}; // Whether the result never reverses direction along the axis (within
+                              // its extrapolation limits)
+};
+
+struct CoarsenedInterpolator;
+
 // this will be the public-facing class.
 class RegularGridInterpolator {
   public:
     RegularGridInterpolator();
 
+    // Axis and grid point data vectors are taken by value: pass them with std::move to avoid
+    // copying large tables
     explicit RegularGridInterpolator(
-        const std::vector<std::vector<double>>& grid_axis_vectors,
+        std::vector<std::vector<double>> grid_axis_vectors,
         std::string name = "Unnamed RegularGridInterpolator",
         const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
 
     RegularGridInterpolator(
-        const std::vector<std::vector<double>>& grid_axis_vectors,
-        const std::vector<std::vector<double>>& grid_point_data_vectors,
+        std::vector<std::vector<double>> grid_axis_vectors,
+        std::vector<std::vector<double>> grid_point_data_vectors,
         std::string name = "Unnamed RegularGridInterpolator",
         const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
 
     explicit RegularGridInterpolator(
-        const std::vector<GridAxis>& grid_axes,
+        std::vector<GridAxis> grid_axes,
         std::string name = "Unnamed RegularGridInterpolator",
         const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
 
     RegularGridInterpolator(
-        const std::vector<GridAxis>& grid_axes,
-        const std::vector<std::vector<double>>& grid_point_data_vectors,
+        std::vector<GridAxis> grid_axes,
+        std::vector<std::vector<double>> grid_point_data_vectors,
         std::string name = "Unnamed RegularGridInterpolator",
         const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
 
     RegularGridInterpolator(
-        const std::vector<std::vector<double>>& grid_axis_vectors,
-        const std::vector<GridPointDataSet>& grid_point_data_sets,
+        std::vector<std::vector<double>> grid_axis_vectors,
+        std::vector<GridPointDataSet> grid_point_data_sets,
         std::string name = "Unnamed RegularGridInterpolator",
         const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
 
     RegularGridInterpolator(
-        const std::vector<GridAxis>& grid_axes,
-        const std::vector<GridPointDataSet>& grid_point_data_sets,
+        std::vector<GridAxis> grid_axes,
+        std::vector<GridPointDataSet> grid_point_data_sets,
         std::string name = "Unnamed RegularGridInterpolator",
         const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
 
@@ -73,12 +136,16 @@ class RegularGridInterpolator {
     RegularGridInterpolator(const RegularGridInterpolator& source,
                             const std::shared_ptr<Courier::Courier>& courier);
 
+    RegularGridInterpolator(RegularGridInterpolator&& source) noexcept;
+
     RegularGridInterpolator& operator=(const RegularGridInterpolator& source);
 
-    std::size_t add_grid_point_data_set(const std::vector<double>& grid_point_data_vector,
+    RegularGridInterpolator& operator=(RegularGridInterpolator&& source) noexcept;
+
+    std::size_t add_grid_point_data_set(std::vector<double> grid_point_data_vector,
                                         const std::string& name = "");
 
-    std::size_t add_grid_point_data_set(const GridPointDataSet& grid_point_data_set);
+    std::size_t add_grid_point_data_set(GridPointDataSet grid_point_data_set);
 
     void set_axis_extrapolation_method(std::size_t axis_index, ExtrapolationMethod method);
 
@@ -87,6 +154,66 @@ class RegularGridInterpolator {
     void set_axis_extrapolation_limits(std::size_t axis_index,
                                        const std::pair<double, double>& extrapolation_limits);
 
+    // Reorders stored grid point data. A blocked layout keeps the neighborhood of a grid cell
+    // within a few cache lines for high-dimensional grids. block_length (a power of two) is the
+    // number of grid points per block along each axis.
+    void set_grid_point_data_layout(GridPointDataLayout layout, std::size_t block_length = 4);
+
+    // Stores grid point data compressed in blocks of block_size (stored) grid points, which are
+    // decoded as they are needed. Values are reproduced within maximum_error (exactly if zero).
+    // Grid point data sets cannot be retrieved while compressed.
+    void set_grid_point_data_compression(double maximum_error, std::size_t block_size = 64);
+
+    void clear_grid_point_data_compression();
+
+    // Uncompressed size divided by compressed size (1 if not compressed)
+    double get_grid_point_data_compression_ratio();
+
+    // Replaces stored grid point data with a file written by GridPointDataFileWriter (or
+    // write_grid_point_data_file). Blocks of the file are read as they are needed, keeping at most
+    // maximum_resident_size bytes of recently used blocks (shared with copies of this
+    // interpolator). Each interpolator, and each concurrently running task of a batch evaluation,
+    // also holds on to up to 16 blocks it is using, so resident memory can exceed
+    // maximum_resident_size by that many blocks per interpolator and running task. Paged grid
+    // point data cannot be modified, reordered, or compressed.
+    void set_grid_point_data_file(const std::string& path,
+                                  std::size_t maximum_resident_size = std::size_t {1} << 28u);
+
+    GridPointDataPagingStatistics get_grid_point_data_paging_statistics();
+
+    // Publishes the grid axes (with their settings) and grid point data as a named table that
+    // other processes on the node can attach to read-only, sharing one copy of the grid point data.
+    // Publishing over an existing table does not affect interpolators already attached to it.
+    void publish_shared_table(const std::string& table_name,
+                              SharedTableStorage storage = SharedTableStorage::shared_memory) const;
+
+    // Returns an interpolator whose grid point data is mapped from a published table. Each
+    // interpolator keeps only its own axes and evaluation state. The grid point data cannot be
+    // modified, reordered, or compressed.
+    static RegularGridInterpolator attach_shared_table(
+        const std::string& table_name,
+        SharedTableStorage storage = SharedTableStorage::shared_memory,
+        std::string name = "Unnamed RegularGridInterpolator",
+        const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
+
+    // Removes a published table's name (attached interpolators keep their mappings). Returns
+    // false if the table does not exist.
+    static bool remove_shared_table(const std::string& table_name,
+                                    SharedTableStorage storage = SharedTableStorage::shared_memory);
+
+    // Returns an interpolator of the remaining axes whose grid point data sets are contracted along
+    // the fixed axes (axis index -> fixed value) using the same weights and methods. Evaluating
+    // it matches evaluating this interpolator with the fixed values included in the target. Axes
+    // interpolated with simplex cannot be fixed when more than one axis is (their weights do not
+    // separate by axis).
+    [[nodiscard]] RegularGridInterpolator
+    get_reduced_interpolator(const std::map<std::size_t, double>& fixed_axis_values) const;
+
+    // Returns an interpolator on a subset of this interpolator's grid axis points (with the same
+    // axis settings) that reproduces the grid point data of every data set within tolerance at
+    // every grid point. Axis points are removed greedily.
+    [[nodiscard]] CoarsenedInterpolator get_coarsened_interpolator(double tolerance) const;
+
     // Public getters
     std::size_t get_number_of_dimensions();
 
@@ -94,8 +221,11 @@ class RegularGridInterpolator {
 
     std::size_t get_number_of_grid_point_data_sets();
 
+    // Data is returned in storage order (see set_grid_point_data_layout)
     const GridPointDataSet& get_grid_point_data_set(std::size_t data_set_index);
 
+    GridPointDataLayout get_grid_point_data_layout();
+
     const GridAxis& get_grid_axis(std::size_t axis_index);
 
     // Public normalization methods
@@ -115,6 +245,11 @@ class RegularGridInterpolator {
     // Get results
     void set_target(const std::vector<double>& target);
 
+    // Change the target along a single axis (a target must already be set). Only this axis is
+    // recalculated, and the gathered grid point data is reused when the target stays in the same
+    // grid cell.
+    void set_target_axis(std::size_t axis_index, double value);
+
     double get_value_at_target(const std::vector<double>& target, std::size_t data_set_index);
 
     double operator()(const std::vector<double>& target, const std::size_t data_set_index)
@@ -140,6 +275,97 @@ class RegularGridInterpolator {
 
     std::vector<double> operator()() { return get_values_at_target(); }
 
+    // Finds the values along one axis at which a data set equals result, with the other axes at
+    // their target values (target[axis_index] is ignored). The other axes are contracted once to a
+    // curve along the axis, which is then solved analytically within each grid cell (and linear
+    // extrapolation segment). A constant segment equal to result is reported by its end points.
+    // Not available when more than one axis is interpolated with simplex.
+    [[nodiscard]] InverseSolution solve_for_axis_value(const std::vector<double>& target,
+                                                       std::size_t axis_index,
+                                                       std::size_t data_set_index,
+                                                       double result) const;
+
+    // Integral of each data set over a box (from range.first to range.second along each
+    // integrated axis), with the other axes at their target values (target values of integrated
+    // axes are ignored). The interpolant is integrated exactly, cell by cell, including any
+    // extrapolated parts of the ranges. Not available when more than one axis is interpolated
+    // with simplex.
+    [[nodiscard]] std::vector<double>
+    get_integral(const std::vector<double>& target,
+                 const std::map<std::size_t, std::pair<double, double>>& axis_ranges) const;
+
+    // Integral divided by the size of the box. Along axes with empty ranges, the interpolant is
+    // evaluated at the range instead.
+    [[nodiscard]] std::vector<double>
+    get_mean(const std::vector<double>& target,
+             const std::map<std::size_t, std::pair<double, double>>& axis_ranges) const;
+
+    // Batch evaluation. With an executor, large batches are split into tasks that each evaluate
+    // with their own scratch state; results do not depend on how the batch is split. Batches with
+    // fewer than twice the minimum number of targets per task are evaluated serially. The current
+    // target may be changed by a batch evaluation.
+    std::vector<std::vector<double>>
+    get_values_at_targets(const std::vector<std::vector<double>>& targets,
+                          const TaskExecutor& executor = nullptr);
+
+    // Flattened batch evaluation: targets holds number_of_targets rows of
+    // get_number_of_dimensions() values; results receives number_of_targets rows of
+    // get_number_of_grid_point_data_sets() values.
+    void get_values_at_targets(const double* targets,
+                               std::size_t number_of_targets,
+                               double* results,
+                               const TaskExecutor& executor = nullptr);
+
+    // Structure-of-arrays batch evaluation: target_columns[axis_index][target_index] and
+    // result_columns[data_set_index][target_index]. Grids that are linearly interpolated along
+    // every axis (with row-major, uncompressed grid point data in memory) are evaluated several
+    // targets at a time, one per SIMD lane (using gather instructions when compiled for AVX2 or
+    // AVX-512). Other grids are evaluated one target at a time. Results match single-target
+    // evaluation. The current target may be changed.
+    void get_values_at_target_columns(const double* const* target_columns,
+                                      std::size_t number_of_targets,
+                                      double* const* result_columns);
+
+    std::vector<std::vector<double>>
+    get_values_at_target_columns(const std::vector<std::vector<double>>& target_columns);
+
+    void set_minimum_targets_per_task(std::size_t minimum_targets_per_task);
+
+    // Remembers the results of recent targets so that repeated targets skip interpolation. Target
+    // values are rounded to the nearest multiple of tolerance (if nonzero), so targets that round
+    // the same way share the results of the first one evaluated. The least recently used results
+    // are discarded to stay within maximum_memory_size (bytes). Any change to the grid point data
+    // or axis settings clears the cache. Copies of an interpolator start with an empty cache.
+    // Targets beyond the extrapolation limits always send their errors. Batch evaluation (which
+    // may be split among tasks) only uses the cache when tolerance is zero.
+    void enable_result_cache(double tolerance = 0.0, std::size_t maximum_memory_size = 1u << 20u);
+
+    void disable_result_cache();
+
+    [[nodiscard]] ResultCacheStatistics get_result_cache_statistics() const;
+
+    // Grid point data gathered for each grid cell is cached (the hypercube cache). By default the
+    // cache grows without limit; with a budget, no more cells are cached once it would exceed
+    // maximum_memory_size (bytes). The result cache has its own limit (see enable_result_cache).
+    // Copies of an interpolator keep the budget but start with an empty cache.
+    void set_hypercube_cache_memory_budget(std::size_t maximum_memory_size = SIZE_MAX);
+
+    // Replaces the hypercube cache with a fixed-size cache shared by every evaluator of this
+    // interpolator (the tasks of a batch evaluation, and copies until their grid point data
+    // changes), so that threads evaluating the same table share gathered cells. Lookups are
+    // lock-free and insertions never wait; cells overwrite (evict) others that map to the same
+    // slot.
+    void enable_shared_hypercube_cache(std::size_t maximum_memory_size = 1u << 24u);
+
+    void disable_shared_hypercube_cache();
+
+    [[nodiscard]] MemoryUsage get_memory_usage() const;
+
+    // Cost of evaluating a target for each combination of axis methods that targets can reach,
+    // from the most to the fewest vertices
+    [[nodiscard]] std::vector<EvaluationCost> get_evaluation_costs() const;
+
+    // Row-major indices of the grid points surrounding the target (for any data layout)
     [[nodiscard]] std::vector<std::size_t> get_neighboring_indices_at_target() const;
 
     std::vector<std::size_t> get_neighboring_indices_at_target(const std::vector<double>& target);
@@ -156,7 +382,15 @@ class RegularGridInterpolator {
     std::shared_ptr<Courier::Courier> get_courier();
 
   private:
+    explicit RegularGridInterpolator(
+        std::unique_ptr<RegularGridInterpolatorImplementation> implementation);
+
     std::unique_ptr<RegularGridInterpolatorImplementation> implementation;
 };
 
+struct CoarsenedInterpolator {
+    RegularGridInterpolator interpolator;
+    std::vector<double> maximum_errors; // For each grid point data set, at the original grid points
+};
+
 } // namespace Btwxt
@@ -0,0 +1,161 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// btwxt
+#include "grid-axis.h"
+#include "grid-point-data.h"
+#include "messaging.h"
+#include "task-executor.h"
+
+namespace Btwxt {
+
+class SparseGridInterpolator : public Courier::Sender {
+    // Interpolates over a sparse grid (the Smolyak combination of nested levels along each axis),
+    // for high-dimensional tables whose full grids would not fit in memory. The values of each
+    // grid axis are the finest level of a hierarchy, so axes must have 2^k + 1 values (or one):
+    // level 0 is the first value, level 1 adds the last value, and each further level adds the
+    // midpoints (by index) of the previous level's intervals. A sparse grid of a given level holds
+    // the grid points whose axis levels sum to at most that level.
+    // Data is stored as hierarchical surpluses (the difference between the value at a grid point
+    // and the interpolation of coarser levels) of piecewise-linear basis functions along each
+    // axis: a constant (level 0), a ramp between the first and last values (level 1), and hat
+    // functions spanning neighboring grid points of coarser levels (further levels). When the
+    // level includes every grid point, results equal linear interpolation of the full grid.
+    // Axes are always interpolated linearly, and are extrapolated (within their extrapolation
+    // limits) according to their extrapolation methods.
+  public:
+    // Returns a value for each data set at the grid point with the given axis values
+    using GridPointFunction = std::function<std::vector<double>(const std::vector<double>&)>;
+
+    // Samples grid_point_function at every grid point. With an executor, grid points are sampled
+    // as concurrent tasks, so the function must then be safe to call from multiple threads.
+    SparseGridInterpolator(
+        std::vector<GridAxis> grid_axes,
+        std::size_t level,
+        std::vector<std::string> data_set_names,
+        const GridPointFunction& grid_point_function,
+        const TaskExecutor& executor = nullptr,
+        std::string name = "Unnamed SparseGridInterpolator",
+        const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
+
+    // Replaces the data with values at each grid point, in the order of get_grid_points()
+    void set_grid_point_data_sets(const std::vector<GridPointDataSet>& grid_point_data_sets);
+
+    double get_value_at_target(const std::vector<double>& target, std::size_t data_set_index);
+
+    double operator()(const std::vector<double>& target, const std::size_t data_set_index)
+    {
+        return get_value_at_target(target, data_set_index);
+    }
+
+    std::vector<double> get_values_at_target(const std::vector<double>& target);
+
+    std::vector<double> operator()(const std::vector<double>& target)
+    {
+        return get_values_at_target(target);
+    }
+
+    // With an executor, targets are split into chunks evaluated as concurrent tasks
+    std::vector<std::vector<double>>
+    get_values_at_targets(const std::vector<std::vector<double>>& targets,
+                          const TaskExecutor& executor = nullptr) const;
+
+    // Flattened batch evaluation: targets holds number_of_targets rows of
+    // get_number_of_dimensions() values; results receives number_of_targets rows of
+    // get_number_of_data_sets() values
+    void get_values_at_targets(const double* targets,
+                               std::size_t number_of_targets,
+                               double* results,
+                               const TaskExecutor& executor = nullptr) const;
+
+    [[nodiscard]] std::size_t get_number_of_dimensions() const { return grid_axes.size(); }
+
+    [[nodiscard]] std::size_t get_number_of_data_sets() const { return data_set_names.size(); }
+
+    [[nodiscard]] const std::vector<std::string>& get_data_set_names() const
+    {
+        return data_set_names;
+    }
+
+    [[nodiscard]] const std::vector<GridAxis>& get_grid_axes() const { return grid_axes; }
+
+    [[nodiscard]] std::size_t get_level() const { return level; }
+
+    [[nodiscard]] std::size_t get_number_of_grid_points() const { return subspace_offsets.back(); }
+
+    [[nodiscard]] std::vector<std::vector<double>> get_grid_points() const;
+
+    // Hierarchical surplus of each data set at a grid point (in the order of get_grid_points())
+    [[nodiscard]] std::vector<double>
+    get_hierarchical_surpluses(std::size_t grid_point_index) const;
+
+    // Bytes held by the grid axes, surpluses, and evaluation scratch space
+    [[nodiscard]] std::size_t get_memory_size() const;
+
+  private:
+    std::vector<GridAxis> grid_axes;
+    std::size_t level;
+    std::vector<std::string> data_set_names;
+    std::size_t number_of_data_sets;
+    std::vector<std::size_t> maximum_axis_levels;
+    std::vector<std::size_t> axis_level_offsets; // Of each axis's levels in the scratch tables
+
+    // Subspaces (one level along each axis, holding the grid points first added at those levels)
+    // are enumerated in lexicographic order of their levels
+    std::vector<std::uint8_t> subspace_levels; // number_of_dimensions levels for each subspace
+    std::vector<std::size_t> subspace_offsets; // Index of each subspace's first grid point
+    std::vector<double> surpluses; // number_of_data_sets values for each grid point
+
+    struct EvaluationScratch {
+        // For each axis and level, the value and index of the basis function that is nonzero (or
+        // is extended linearly) at the target
+        std::vector<double> basis_values;
+        std::vector<std::size_t> basis_indices;
+    };
+    EvaluationScratch scratch;
+    std::vector<double> results;
+
+    static std::size_t get_number_of_level_points(std::size_t axis_level)
+    {
+        return axis_level < 2u ? 1u : std::size_t {1u} << (axis_level - 2u);
+    }
+
+    // Index of the point along an axis (among all of its values) of basis function
+    // basis_index at axis_level
+    [[nodiscard]] std::size_t get_axis_value_index(std::size_t axis_index,
+                                                   std::size_t axis_level,
+                                                   std::size_t basis_index) const;
+
+    void enumerate_subspaces(std::size_t axis_index,
+                             std::size_t remaining_level,
+                             std::vector<std::uint8_t>& levels);
+
+    void get_grid_point(std::size_t grid_point_index, std::vector<double>& coordinates) const;
+
+    void hierarchize();
+
+    void set_basis_functions(const double* target, EvaluationScratch& evaluation_scratch) const;
+
+    void accumulate(std::size_t axis_index,
+                    std::size_t remaining_level,
+                    double weight,
+                    std::size_t local_index,
+                    std::size_t& subspace_index,
+                    const EvaluationScratch& evaluation_scratch,
+                    double* results_at_target) const;
+
+    void evaluate(const double* target,
+                  double* results_at_target,
+                  EvaluationScratch& evaluation_scratch) const;
+};
+
+} // namespace Btwxt
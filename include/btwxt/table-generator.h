@@ -0,0 +1,81 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// btwxt
+#include "grid-axis.h"
+#include "messaging.h"
+#include "regular-grid-interpolator.h"
+#include "task-executor.h"
+
+namespace Btwxt {
+
+class TableGenerator : public Courier::Sender {
+    // Builds a table by evaluating a function at every grid point of a set of grid axes. Grid
+    // points are visited in row-major order (last axis varies fastest) without materializing the
+    // grid. With an executor, grid points are split into contiguous ranges evaluated as concurrent
+    // tasks, so the function must then be safe to call from multiple threads.
+  public:
+    // Returns a value for each data set at the grid point with the given axis values
+    using GridPointFunction = std::function<std::vector<double>(const std::vector<double>&)>;
+
+    // Receives the values (one for each data set) of consecutive grid points in row-major order
+    using GridPointDataSink = std::function<void(const std::vector<double>&)>;
+
+    TableGenerator(
+        std::vector<GridAxis> grid_axes,
+        std::vector<std::string> data_set_names,
+        GridPointFunction grid_point_function,
+        std::string name = "Unnamed TableGenerator",
+        const std::shared_ptr<Courier::Courier>& courier = std::make_shared<BtwxtDefaultCourier>());
+
+    // Evaluated values are written directly into the interpolator's grid point data sets
+    [[nodiscard]] RegularGridInterpolator
+    generate_interpolator(const TaskExecutor& executor = nullptr) const;
+
+    // Streams grid point values to sink in order. Only chunk_size grid points are held in memory
+    // at a time, so tables need not fit in memory.
+    void generate(const GridPointDataSink& sink,
+                  const TaskExecutor& executor = nullptr,
+                  std::size_t chunk_size = 1u << 16u) const;
+
+    // Streams the table to a grid point data file (see GridPointDataFileWriter)
+    void generate_grid_point_data_file(const std::string& path,
+                                       std::uint64_t block_size = 4096,
+                                       const TaskExecutor& executor = nullptr) const;
+
+    void set_grid_points_per_task(std::size_t grid_points_per_task_in);
+
+    [[nodiscard]] const std::vector<GridAxis>& get_grid_axes() const { return grid_axes; }
+
+    [[nodiscard]] const std::vector<std::string>& get_data_set_names() const
+    {
+        return data_set_names;
+    }
+
+    [[nodiscard]] std::uint64_t get_number_of_grid_points() const { return number_of_grid_points; }
+
+  private:
+    std::vector<GridAxis> grid_axes;
+    std::vector<std::string> data_set_names;
+    GridPointFunction grid_point_function;
+    std::uint64_t number_of_grid_points {1u};
+    std::size_t grid_points_per_task {256u};
+
+    // Calls store(grid_point_index, values) for each grid point in [first, first + count)
+    template <typename Store>
+    void evaluate_grid_points(std::uint64_t first_grid_point_index,
+                              std::uint64_t number_of_grid_points_to_evaluate,
+                              const Store& store,
+                              const TaskExecutor& executor) const;
+};
+
+} // namespace Btwxt
@@ -0,0 +1,64 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Btwxt {
+
+// Runs task(task_index) for every task_index in [0, number_of_tasks) and returns once all tasks
+// have completed. Tasks may be run concurrently and in any order. Any thread pool can be used by
+// wrapping it in this signature.
+using TaskExecutor = std::function<void(std::size_t number_of_tasks,
+                                        const std::function<void(std::size_t task_index)>& task)>;
+
+class ThreadPool {
+    // A fixed set of worker threads. The calling thread also runs tasks, so a pool of N threads
+    // starts N - 1 workers.
+  public:
+    explicit ThreadPool(std::size_t number_of_threads = std::thread::hardware_concurrency());
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Blocks until all tasks are complete. The first exception thrown by a task is rethrown.
+    // Calls from within a task of this pool run the nested tasks serially on the calling thread.
+    // Calls from other threads wait for the current run to finish.
+    void run(std::size_t number_of_tasks, const std::function<void(std::size_t)>& task);
+
+    [[nodiscard]] std::size_t get_number_of_threads() const { return workers.size() + 1; }
+
+    // The returned executor refers to this pool and must not outlive it
+    [[nodiscard]] TaskExecutor get_executor();
+
+  private:
+    std::vector<std::thread> workers;
+    std::mutex run_mutex; // Serializes concurrent calls to run()
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_complete;
+    const std::function<void(std::size_t)>* current_task {nullptr};
+    std::size_t number_of_tasks {0u};
+    std::size_t next_task_index {0u};
+    std::size_t number_of_completed_tasks {0u};
+    std::size_t generation {0u};
+    std::exception_ptr first_exception;
+    bool stopping {false};
+
+    void work(std::unique_lock<std::mutex>& lock);
+
+    void worker_loop();
+};
+
+} // namespace Btwxt
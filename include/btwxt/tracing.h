@@ -0,0 +1,67 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace Btwxt {
+
+// Stages of single-target evaluation
+enum class TraceStage {
+    floor_search,        // Finding the grid cell containing the target
+    fractions,           // Fractions of the target between floor and ceiling along each axis
+    consolidate_methods, // Interpolation or extrapolation method of each axis at the target
+    coefficients,        // Interpolation coefficients (weighting factors) of each axis
+    hypercube,           // Vertices with nonzero weights
+    gather,              // Reading grid point data of the vertices
+    reduction            // Weighted sums of the gathered grid point data
+};
+
+constexpr std::size_t number_of_trace_stages {7u};
+
+// Latency histogram buckets are powers of two: bucket i counts durations in [2^(i-1), 2^i) ns
+// (bucket 0 counts durations under 1 ns)
+constexpr std::size_t number_of_trace_histogram_buckets {40u};
+
+struct TraceStageProfile {
+    TraceStage stage {TraceStage::floor_search};
+    std::uint64_t count {0u};
+    std::uint64_t total_duration {0u}; // ns
+    std::uint64_t minimum_duration {0u};
+    std::uint64_t maximum_duration {0u};
+    std::array<std::uint64_t, number_of_trace_histogram_buckets> histogram {};
+
+    // Estimated from the histogram (upper bound of the bucket containing the quantile), in ns
+    [[nodiscard]] double get_quantile(double quantile) const;
+};
+
+std::string_view get_trace_stage_name(TraceStage stage);
+
+// Stages are only timed when the library is built with tracing (-Dbtwxt_TRACING=ON). Otherwise
+// the timers are compiled out entirely and profiles are empty.
+bool tracing_is_enabled();
+
+// Timings from all threads, combined, since the last reset
+std::vector<TraceStageProfile> get_trace_stage_profiles();
+
+void reset_trace();
+
+// Individual stage events are recorded for trace export only while recording is on (up to a
+// maximum number of events per thread). Histograms are always collected.
+void set_trace_event_recording(bool record_events,
+                               std::size_t maximum_events_per_thread = 1u << 20u);
+
+// Chrome trace-event JSON (load in chrome://tracing or Perfetto)
+void write_chrome_trace(std::ostream& stream);
+
+// One row per stage: count, total, mean, minimum, maximum, and quantile durations (ns)
+void write_trace_profile_csv(std::ostream& stream);
+
+} // namespace Btwxt
@@ -0,0 +1,267 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// pybind11
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+// btwxt
+#include <btwxt/btwxt.h>
+
+namespace py = pybind11;
+
+namespace {
+
+// Arrays are only copied when they are not already C-contiguous float64
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+class PythonCourier : public Courier::DefaultCourier {
+    // Errors are raised as exceptions (RuntimeError); other messages are issued as Python warnings
+  protected:
+    void write_message(const std::string& message_type, const std::string& message) override
+    {
+        if (message_type == "ERROR") {
+            return;
+        }
+        py::gil_scoped_acquire acquire;
+        if (PyErr_WarnEx(PyExc_RuntimeWarning,
+                         fmt::format("[{}] {}", message_type, message).c_str(),
+                         1) != 0) {
+            PyErr_Clear(); // Warnings filtered as errors cannot be raised from here
+        }
+    }
+};
+
+class PythonInterpolator {
+    // Evaluation changes an interpolator's target and caches, so each concurrent evaluation uses
+    // its own copy of the prototype (copies share grid point data). Idle copies are reused until
+    // the prototype is modified.
+  public:
+    explicit PythonInterpolator(Btwxt::RegularGridInterpolator prototype_in)
+        : prototype(std::move(prototype_in))
+    {
+    }
+
+    template <typename Function> auto query(Function&& function)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return function(prototype);
+    }
+
+    template <typename Function> void modify(Function&& function)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        function(prototype);
+        idle_evaluators.clear();
+        ++generation;
+    }
+
+    // Called without the GIL
+    void evaluate(const double* targets, std::size_t number_of_targets, double* results)
+    {
+        std::unique_ptr<Btwxt::RegularGridInterpolator> evaluator;
+        std::size_t evaluator_generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            evaluator_generation = generation;
+            if (idle_evaluators.empty()) {
+                evaluator = std::make_unique<Btwxt::RegularGridInterpolator>(prototype);
+            }
+            else {
+                evaluator = std::move(idle_evaluators.back());
+                idle_evaluators.pop_back();
+            }
+        }
+        evaluator->get_values_at_targets(targets, number_of_targets, results);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (evaluator_generation == generation) {
+            idle_evaluators.push_back(std::move(evaluator));
+        }
+    }
+
+  private:
+    Btwxt::RegularGridInterpolator prototype;
+    std::vector<std::unique_ptr<Btwxt::RegularGridInterpolator>> idle_evaluators;
+    std::size_t generation {0u};
+    std::mutex mutex;
+};
+
+std::unique_ptr<PythonInterpolator> construct_interpolator(const std::vector<DoubleArray>& axes,
+                                                           const DoubleArray& grid_point_data,
+                                                           const std::string& name)
+{
+    const auto number_of_axes = static_cast<py::ssize_t>(axes.size());
+    std::vector<std::vector<double>> grid_axis_vectors;
+    grid_axis_vectors.reserve(axes.size());
+    for (const auto& axis : axes) {
+        if (axis.ndim() != 1) {
+            throw py::value_error("Each grid axis must be a one-dimensional array.");
+        }
+        grid_axis_vectors.emplace_back(axis.data(), axis.data() + axis.size());
+    }
+
+    // grid_point_data has the shape of the grid, optionally preceded by a data set dimension
+    py::ssize_t number_of_data_sets;
+    if (grid_point_data.ndim() == number_of_axes) {
+        number_of_data_sets = 1;
+    }
+    else if (grid_point_data.ndim() == number_of_axes + 1) {
+        number_of_data_sets = grid_point_data.shape(0);
+    }
+    else {
+        throw py::value_error(fmt::format("Grid point data must have {} or {} dimensions (has {}).",
+                                          number_of_axes,
+                                          number_of_axes + 1,
+                                          grid_point_data.ndim()));
+    }
+    const py::ssize_t first_axis_dimension = grid_point_data.ndim() - number_of_axes;
+    for (py::ssize_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        if (grid_point_data.shape(first_axis_dimension + axis_index) !=
+            static_cast<py::ssize_t>(grid_axis_vectors[axis_index].size())) {
+            throw py::value_error(fmt::format(
+                "Grid point data dimension {} has length {} (axis {} has {} values).",
+                first_axis_dimension + axis_index,
+                grid_point_data.shape(first_axis_dimension + axis_index),
+                axis_index,
+                grid_axis_vectors[axis_index].size()));
+        }
+    }
+
+    // Interpolators own their grid point data (there is no non-owning storage for it), so each data
+    // set is copied once, directly from the array, rather than used in place
+    const py::ssize_t number_of_grid_points =
+        number_of_data_sets > 0 ? grid_point_data.size() / number_of_data_sets : 0;
+    std::vector<std::vector<double>> grid_point_data_vectors;
+    grid_point_data_vectors.reserve(number_of_data_sets);
+    for (py::ssize_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        const double* data_set = grid_point_data.data() + data_set_index * number_of_grid_points;
+        grid_point_data_vectors.emplace_back(data_set, data_set + number_of_grid_points);
+    }
+    return std::make_unique<PythonInterpolator>(
+        Btwxt::RegularGridInterpolator(std::move(grid_axis_vectors),
+                                       std::move(grid_point_data_vectors),
+                                       name,
+                                       std::make_shared<PythonCourier>()));
+}
+
+py::array_t<double> evaluate(PythonInterpolator& interpolator, const DoubleArray& targets)
+{
+    auto [number_of_dimensions, number_of_data_sets] =
+        interpolator.query([](Btwxt::RegularGridInterpolator& prototype) {
+            return std::make_pair(prototype.get_number_of_dimensions(),
+                                  prototype.get_number_of_grid_point_data_sets());
+        });
+    const bool is_single_target = targets.ndim() == 1;
+    if ((targets.ndim() != 1 && targets.ndim() != 2) ||
+        targets.shape(targets.ndim() - 1) != static_cast<py::ssize_t>(number_of_dimensions)) {
+        throw py::value_error(
+            fmt::format("Targets must have shape (n, {0}) or ({0},).", number_of_dimensions));
+    }
+    const std::size_t number_of_targets = is_single_target ? 1u : targets.shape(0);
+
+    py::array_t<double> results(
+        is_single_target
+            ? std::vector<py::ssize_t> {static_cast<py::ssize_t>(number_of_data_sets)}
+            : std::vector<py::ssize_t> {static_cast<py::ssize_t>(number_of_targets),
+                                        static_cast<py::ssize_t>(number_of_data_sets)});
+    const double* target_values = targets.data();
+    double* result_values = results.mutable_data();
+    {
+        py::gil_scoped_release release;
+        interpolator.evaluate(target_values, number_of_targets, result_values);
+    }
+    return results;
+}
+
+} // namespace
+
+PYBIND11_MODULE(btwxt, module)
+{
+    module.doc() = "N-dimensional regular grid interpolation";
+
+    py::enum_<Btwxt::InterpolationMethod>(module, "InterpolationMethod")
+        .value("linear", Btwxt::InterpolationMethod::linear)
+        .value("cubic", Btwxt::InterpolationMethod::cubic)
+        .value("simplex", Btwxt::InterpolationMethod::simplex);
+
+    py::enum_<Btwxt::ExtrapolationMethod>(module, "ExtrapolationMethod")
+        .value("constant", Btwxt::ExtrapolationMethod::constant)
+        .value("linear", Btwxt::ExtrapolationMethod::linear);
+
+    py::class_<PythonInterpolator>(module, "RegularGridInterpolator")
+        .def(py::init(&construct_interpolator),
+             py::arg("grid_axes"),
+             py::arg("grid_point_data"),
+             py::arg("name") = "Unnamed RegularGridInterpolator",
+             "grid_point_data has shape (len(grid_axes[0]), ...) or "
+             "(number of data sets, len(grid_axes[0]), ...)")
+        .def(
+            "set_axis_interpolation_method",
+            [](PythonInterpolator& interpolator,
+               std::size_t axis_index,
+               Btwxt::InterpolationMethod method) {
+                interpolator.modify([&](Btwxt::RegularGridInterpolator& prototype) {
+                    prototype.set_axis_interpolation_method(axis_index, method);
+                });
+            },
+            py::arg("axis_index"),
+            py::arg("method"))
+        .def(
+            "set_axis_extrapolation_method",
+            [](PythonInterpolator& interpolator,
+               std::size_t axis_index,
+               Btwxt::ExtrapolationMethod method) {
+                interpolator.modify([&](Btwxt::RegularGridInterpolator& prototype) {
+                    prototype.set_axis_extrapolation_method(axis_index, method);
+                });
+            },
+            py::arg("axis_index"),
+            py::arg("method"))
+        .def(
+            "set_axis_extrapolation_limits",
+            [](PythonInterpolator& interpolator,
+               std::size_t axis_index,
+               double lower_limit,
+               double upper_limit) {
+                interpolator.modify([&](Btwxt::RegularGridInterpolator& prototype) {
+                    prototype.set_axis_extrapolation_limits(axis_index, {lower_limit, upper_limit});
+                });
+            },
+            py::arg("axis_index"),
+            py::arg("lower_limit"),
+            py::arg("upper_limit"))
+        .def_property_readonly("number_of_dimensions",
+                               [](PythonInterpolator& interpolator) {
+                                   return interpolator.query(
+                                       [](Btwxt::RegularGridInterpolator& prototype) {
+                                           return prototype.get_number_of_dimensions();
+                                       });
+                               })
+        .def_property_readonly("number_of_grid_points",
+                               [](PythonInterpolator& interpolator) {
+                                   return interpolator.query(
+                                       [](Btwxt::RegularGridInterpolator& prototype) {
+                                           return prototype.get_number_of_grid_points();
+                                       });
+                               })
+        .def_property_readonly("number_of_data_sets",
+                               [](PythonInterpolator& interpolator) {
+                                   return interpolator.query(
+                                       [](Btwxt::RegularGridInterpolator& prototype) {
+                                           return prototype.get_number_of_grid_point_data_sets();
+                                       });
+                               })
+        .def("__call__",
+             &evaluate,
+             py::arg("targets"),
+             "Evaluates an (n, number_of_dimensions) array of targets (or a single target) in one "
+             "call, returning an (n, number_of_data_sets) array (or one result per data set). The "
+             "GIL is released during evaluation.");
+}
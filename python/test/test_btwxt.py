@@ -0,0 +1,76 @@
+# Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+# See the LICENSE file for additional terms and conditions.
+
+import threading
+import unittest
+
+import numpy as np
+
+import btwxt
+
+
+class RegularGridInterpolatorTest(unittest.TestCase):
+    # Same grid as the Grid2DFixture tests
+    def setUp(self):
+        self.interpolator = btwxt.RegularGridInterpolator(
+            [np.array([0.0, 10.0, 15.0]), np.array([4.0, 6.0])],
+            np.array([[[6, 3], [2, 8], [4, 2]], [[12, 6], [4, 16], [8, 4]]], dtype=float),
+        )
+
+    def test_dimensions(self):
+        self.assertEqual(self.interpolator.number_of_dimensions, 2)
+        self.assertEqual(self.interpolator.number_of_grid_points, 6)
+        self.assertEqual(self.interpolator.number_of_data_sets, 2)
+
+    def test_single_target(self):
+        np.testing.assert_allclose(self.interpolator(np.array([12.0, 5.0])), [4.2, 8.4])
+
+    def test_batch(self):
+        targets = np.array([[12.0, 5.0], [8.1, 4.2], [17.0, 5.0]])
+        self.interpolator.set_axis_extrapolation_method(0, btwxt.ExtrapolationMethod.linear)
+        results = self.interpolator(targets)
+        self.assertEqual(results.shape, (3, 2))
+        np.testing.assert_allclose(results[:, 0], [4.2, 3.189, 2.2])
+        np.testing.assert_allclose(results[:, 1], 2.0 * results[:, 0])
+
+    def test_non_contiguous_targets(self):
+        targets = np.asfortranarray([[12.0, 5.0], [8.1, 4.2]])
+        np.testing.assert_allclose(
+            self.interpolator(targets), self.interpolator(np.ascontiguousarray(targets)))
+
+    def test_single_data_set(self):
+        interpolator = btwxt.RegularGridInterpolator(
+            [np.array([0.0, 10.0, 15.0]), np.array([4.0, 6.0])],
+            np.array([[6, 3], [2, 8], [4, 2]]))
+        np.testing.assert_allclose(interpolator(np.array([[12.0, 5.0]])), [[4.2]])
+
+    def test_errors(self):
+        with self.assertRaises(ValueError):
+            btwxt.RegularGridInterpolator([np.array([0.0, 1.0])], np.zeros((3,)))
+        with self.assertRaises(ValueError):
+            self.interpolator(np.zeros((4, 3)))
+        self.interpolator.set_axis_extrapolation_limits(0, 0.0, 20.0)
+        with self.assertRaises(RuntimeError):
+            self.interpolator(np.array([25.0, 5.0]))
+
+    def test_concurrent_evaluation(self):
+        self.interpolator.set_axis_interpolation_method(0, btwxt.InterpolationMethod.cubic)
+        rng = np.random.default_rng(0)
+        targets = np.column_stack([rng.uniform(0, 15, 10000), rng.uniform(4, 6, 10000)])
+        expected = self.interpolator(targets)
+        results = [None] * 4
+
+        def evaluate(thread_index):
+            results[thread_index] = self.interpolator(targets)
+
+        threads = [threading.Thread(target=evaluate, args=(i,)) for i in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for result in results:
+            np.testing.assert_array_equal(result, expected)
+
+
+if __name__ == "__main__":
+    unittest.main()
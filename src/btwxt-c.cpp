@@ -0,0 +1,212 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <new>
+#include <stdexcept>
+#include <string>
+
+// btwxt
+#include <btwxt/btwxt.h>
+#include <btwxt/btwxt-c.h>
+
+namespace {
+
+thread_local std::string last_error_message;
+
+class CApiCourier : public Courier::DefaultCourier {
+    // Errors are returned to C callers as status codes (with messages); nothing is written
+  protected:
+    void write_message(const std::string&, const std::string&) override {}
+};
+
+btwxt_status set_last_error(btwxt_status status, std::string message)
+{
+    last_error_message = std::move(message);
+    return status;
+}
+
+// Calls function, translating exceptions into status codes
+template <typename Function> btwxt_status call(Function&& function)
+{
+    try {
+        function();
+        return BTWXT_SUCCESS;
+    }
+    catch (const std::bad_alloc&) {
+        return set_last_error(BTWXT_ERROR_OUT_OF_MEMORY, "Out of memory.");
+    }
+    catch (const std::exception& exception) {
+        return set_last_error(BTWXT_ERROR_INTERPOLATOR, exception.what());
+    }
+    catch (...) {
+        return set_last_error(BTWXT_ERROR_UNKNOWN, "Unknown error.");
+    }
+}
+
+btwxt_status null_argument_error(const char* argument_name)
+{
+    return set_last_error(BTWXT_ERROR_INVALID_ARGUMENT,
+                          fmt::format("Argument '{}' must not be null.", argument_name));
+}
+
+} // namespace
+
+struct btwxt_interpolator {
+    Btwxt::RegularGridInterpolator interpolator;
+    std::size_t number_of_dimensions;
+    std::size_t number_of_data_sets;
+};
+
+extern "C" {
+
+btwxt_status btwxt_create_interpolator(size_t number_of_axes,
+                                       const size_t* axis_lengths,
+                                       const double* axis_values,
+                                       size_t number_of_data_sets,
+                                       const double* grid_point_data,
+                                       btwxt_interpolator** interpolator)
+{
+    if (!interpolator) {
+        return null_argument_error("interpolator");
+    }
+    *interpolator = nullptr;
+    if (!axis_lengths || !axis_values) {
+        return null_argument_error(!axis_lengths ? "axis_lengths" : "axis_values");
+    }
+    if (!grid_point_data && number_of_data_sets > 0u) {
+        return null_argument_error("grid_point_data");
+    }
+    return call([&]() {
+        std::vector<std::vector<double>> grid_axis_vectors(number_of_axes);
+        std::size_t number_of_grid_points = 1u;
+        for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+            grid_axis_vectors[axis_index].assign(axis_values,
+                                                 axis_values + axis_lengths[axis_index]);
+            axis_values += axis_lengths[axis_index];
+            number_of_grid_points *= axis_lengths[axis_index];
+        }
+        std::vector<std::vector<double>> grid_point_data_vectors(number_of_data_sets);
+        for (auto& grid_point_data_vector : grid_point_data_vectors) {
+            grid_point_data_vector.assign(grid_point_data,
+                                          grid_point_data + number_of_grid_points);
+            grid_point_data += number_of_grid_points;
+        }
+        *interpolator = new btwxt_interpolator {
+            Btwxt::RegularGridInterpolator(std::move(grid_axis_vectors),
+                                           std::move(grid_point_data_vectors),
+                                           "C API RegularGridInterpolator",
+                                           std::make_shared<CApiCourier>()),
+            number_of_axes,
+            number_of_data_sets};
+    });
+}
+
+void btwxt_destroy_interpolator(btwxt_interpolator* interpolator)
+{
+    delete interpolator;
+}
+
+btwxt_status btwxt_set_axis_interpolation_method(btwxt_interpolator* interpolator,
+                                                 size_t axis_index,
+                                                 btwxt_interpolation_method method)
+{
+    if (!interpolator) {
+        return null_argument_error("interpolator");
+    }
+    if (method != BTWXT_INTERPOLATION_LINEAR && method != BTWXT_INTERPOLATION_CUBIC &&
+        method != BTWXT_INTERPOLATION_SIMPLEX) {
+        return set_last_error(
+            BTWXT_ERROR_INVALID_ARGUMENT,
+            fmt::format("Unknown interpolation method ({}).", static_cast<int>(method)));
+    }
+    return call([&]() {
+        interpolator->interpolator.set_axis_interpolation_method(
+            axis_index,
+            method == BTWXT_INTERPOLATION_CUBIC     ? Btwxt::InterpolationMethod::cubic
+            : method == BTWXT_INTERPOLATION_SIMPLEX ? Btwxt::InterpolationMethod::simplex
+                                                    : Btwxt::InterpolationMethod::linear);
+    });
+}
+
+btwxt_status btwxt_set_axis_extrapolation_method(btwxt_interpolator* interpolator,
+                                                 size_t axis_index,
+                                                 btwxt_extrapolation_method method)
+{
+    if (!interpolator) {
+        return null_argument_error("interpolator");
+    }
+    if (method != BTWXT_EXTRAPOLATION_CONSTANT && method != BTWXT_EXTRAPOLATION_LINEAR) {
+        return set_last_error(
+            BTWXT_ERROR_INVALID_ARGUMENT,
+            fmt::format("Unknown extrapolation method ({}).", static_cast<int>(method)));
+    }
+    return call([&]() {
+        interpolator->interpolator.set_axis_extrapolation_method(
+            axis_index,
+            method == BTWXT_EXTRAPOLATION_LINEAR ? Btwxt::ExtrapolationMethod::linear
+                                                 : Btwxt::ExtrapolationMethod::constant);
+    });
+}
+
+btwxt_status btwxt_set_axis_extrapolation_limits(btwxt_interpolator* interpolator,
+                                                 size_t axis_index,
+                                                 double lower_limit,
+                                                 double upper_limit)
+{
+    if (!interpolator) {
+        return null_argument_error("interpolator");
+    }
+    return call([&]() {
+        interpolator->interpolator.set_axis_extrapolation_limits(axis_index,
+                                                                 {lower_limit, upper_limit});
+    });
+}
+
+btwxt_status btwxt_get_number_of_dimensions(const btwxt_interpolator* interpolator,
+                                            size_t* number_of_dimensions)
+{
+    if (!interpolator || !number_of_dimensions) {
+        return null_argument_error(!interpolator ? "interpolator" : "number_of_dimensions");
+    }
+    *number_of_dimensions = interpolator->number_of_dimensions;
+    return BTWXT_SUCCESS;
+}
+
+btwxt_status btwxt_get_number_of_data_sets(const btwxt_interpolator* interpolator,
+                                           size_t* number_of_data_sets)
+{
+    if (!interpolator || !number_of_data_sets) {
+        return null_argument_error(!interpolator ? "interpolator" : "number_of_data_sets");
+    }
+    *number_of_data_sets = interpolator->number_of_data_sets;
+    return BTWXT_SUCCESS;
+}
+
+btwxt_status
+btwxt_evaluate(btwxt_interpolator* interpolator, const double* target, double* results)
+{
+    return btwxt_evaluate_batch(interpolator, target, 1u, results);
+}
+
+btwxt_status btwxt_evaluate_batch(btwxt_interpolator* interpolator,
+                                  const double* targets,
+                                  size_t number_of_targets,
+                                  double* results)
+{
+    if (!interpolator || !targets || !results) {
+        return null_argument_error(!interpolator ? "interpolator"
+                                   : !targets    ? "targets"
+                                                 : "results");
+    }
+    return call([&]() {
+        interpolator->interpolator.get_values_at_targets(targets, number_of_targets, results);
+    });
+}
+
+const char* btwxt_get_last_error_message(void)
+{
+    return last_error_message.c_str();
+}
+
+} // extern "C"
@@ -0,0 +1,429 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <fmt/format.h>
+
+// btwxt
+#include <btwxt/chebyshev-surrogate.h>
+
+namespace Btwxt {
+
+namespace {
+
+constexpr double pi {3.14159265358979323846};
+
+constexpr std::size_t maximum_number_of_validation_targets {1u << 16u};
+constexpr std::size_t maximum_number_of_speedup_targets {1024u};
+
+// Row-major cartesian product of the values along each axis, flattened
+std::vector<double> get_flattened_product(const std::vector<std::vector<double>>& axis_values)
+{
+    std::size_t number_of_targets = 1u;
+    for (const auto& values : axis_values) {
+        number_of_targets *= values.size();
+    }
+    const std::size_t number_of_axes = axis_values.size();
+    std::vector<double> targets(number_of_targets * number_of_axes);
+    for (std::size_t target_index = 0; target_index < number_of_targets; ++target_index) {
+        std::size_t remainder = target_index;
+        for (std::size_t axis_index = number_of_axes; axis_index-- > 0;) {
+            const auto& values = axis_values[axis_index];
+            targets[target_index * number_of_axes + axis_index] = values[remainder % values.size()];
+            remainder /= values.size();
+        }
+    }
+    return targets;
+}
+
+} // namespace
+
+ChebyshevSurrogate::ChebyshevSurrogate(const RegularGridInterpolator& interpolator_in,
+                                       double tolerance,
+                                       std::vector<std::pair<double, double>> fitted_region_in,
+                                       std::size_t maximum_points_per_axis,
+                                       const TaskExecutor& executor,
+                                       std::string name,
+                                       const std::shared_ptr<Courier::Courier>& courier)
+    : Courier::Sender(std::move(name), courier)
+    , interpolator(interpolator_in)
+    , number_of_dimensions(interpolator.get_number_of_dimensions())
+    , number_of_data_sets(interpolator.get_number_of_grid_point_data_sets())
+    , fitted_region(std::move(fitted_region_in))
+{
+    class_name = "ChebyshevSurrogate";
+    if (number_of_data_sets == 0u) {
+        send_error("Cannot fit surrogate. There are no grid point data sets.");
+    }
+    if (tolerance < 0.0) {
+        send_error(
+            fmt::format("Cannot fit surrogate. Tolerance ({}) must not be negative.", tolerance));
+    }
+    if (fitted_region.empty()) {
+        for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+            const auto& axis_values = interpolator.get_grid_axis(axis_index).get_values();
+            fitted_region.emplace_back(axis_values.front(), axis_values.back());
+        }
+    }
+    if (fitted_region.size() != number_of_dimensions) {
+        send_error(fmt::format("Cannot fit surrogate. Number of fitted region bounds ({}) does not "
+                               "match number of grid axes ({}).",
+                               fitted_region.size(),
+                               number_of_dimensions));
+    }
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        if (fitted_region[axis_index].first > fitted_region[axis_index].second) {
+            send_error(fmt::format("Cannot fit surrogate. Lower bound ({}) of axis {} is greater "
+                                   "than its upper bound ({}).",
+                                   fitted_region[axis_index].first,
+                                   axis_index,
+                                   fitted_region[axis_index].second));
+        }
+    }
+    fit(tolerance, std::max(maximum_points_per_axis, std::size_t {2u}), executor);
+}
+
+void ChebyshevSurrogate::fit(double tolerance,
+                             std::size_t maximum_points_per_axis,
+                             const TaskExecutor& executor)
+{
+    // Validation targets: grid points and cell midpoints within the fitted region (thinned if
+    // there are too many)
+    std::vector<std::vector<double>> validation_axis_values(number_of_dimensions);
+    std::size_t number_of_validation_targets = 1u;
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        const auto [lower_bound, upper_bound] = fitted_region[axis_index];
+        const auto& axis_values = interpolator.get_grid_axis(axis_index).get_values();
+        auto& values = validation_axis_values[axis_index];
+        values = {lower_bound, upper_bound};
+        for (std::size_t index = 0; index < axis_values.size(); ++index) {
+            values.push_back(axis_values[index]);
+            if (index + 1u < axis_values.size()) {
+                values.push_back(0.5 * (axis_values[index] + axis_values[index + 1u]));
+            }
+        }
+        values.erase(std::remove_if(values.begin(),
+                                    values.end(),
+                                    [&](double value) {
+                                        return value < lower_bound || value > upper_bound;
+                                    }),
+                     values.end());
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        number_of_validation_targets *= values.size();
+    }
+    while (number_of_validation_targets > maximum_number_of_validation_targets) {
+        auto& values = *std::max_element(
+            validation_axis_values.begin(),
+            validation_axis_values.end(),
+            [](const auto& a, const auto& b) { return a.size() < b.size(); });
+        number_of_validation_targets /= values.size();
+        std::vector<double> thinned_values;
+        for (std::size_t index = 0; index < values.size(); index += 2u) {
+            thinned_values.push_back(values[index]);
+        }
+        if (thinned_values.back() != values.back()) {
+            thinned_values.push_back(values.back());
+        }
+        values = std::move(thinned_values);
+        number_of_validation_targets *= values.size();
+    }
+    const std::vector<double> validation_targets = get_flattened_product(validation_axis_values);
+    std::vector<double> expected_results(number_of_validation_targets * number_of_data_sets);
+    interpolator.get_values_at_targets(
+        validation_targets.data(), number_of_validation_targets, expected_results.data(), executor);
+
+    points_per_axis.resize(number_of_dimensions);
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        const bool is_degenerate =
+            fitted_region[axis_index].first == fitted_region[axis_index].second;
+        points_per_axis[axis_index] = is_degenerate ? 1u : 2u;
+    }
+    chebyshev_polynomials.resize(number_of_dimensions);
+    results.resize(number_of_data_sets);
+    std::vector<double> target(number_of_dimensions);
+    while (true) {
+        // Sample the interpolator at the Chebyshev points of the fitted region
+        std::vector<std::vector<double>> chebyshev_points(number_of_dimensions);
+        for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+            const auto [lower_bound, upper_bound] = fitted_region[axis_index];
+            const std::size_t number_of_points = points_per_axis[axis_index];
+            for (std::size_t point_index = 0; point_index < number_of_points; ++point_index) {
+                const double node = std::cos(pi * (static_cast<double>(point_index) + 0.5) /
+                                             static_cast<double>(number_of_points));
+                chebyshev_points[axis_index].push_back(0.5 * (lower_bound + upper_bound) +
+                                                       0.5 * (upper_bound - lower_bound) * node);
+            }
+        }
+        const std::size_t number_of_coefficients = get_number_of_coefficients();
+        const std::vector<double> chebyshev_targets = get_flattened_product(chebyshev_points);
+        std::vector<double> values_at_chebyshev_points(number_of_coefficients *
+                                                       number_of_data_sets);
+        interpolator.get_values_at_targets(chebyshev_targets.data(),
+                                           number_of_coefficients,
+                                           values_at_chebyshev_points.data(),
+                                           executor);
+        calculate_coefficients(values_at_chebyshev_points);
+        contraction.resize(number_of_coefficients);
+
+        // Validate (stopping at the first error beyond tolerance)
+        maximum_errors.assign(number_of_data_sets, 0.0);
+        bool is_within_tolerance = true;
+        for (std::size_t target_index = 0;
+             target_index < number_of_validation_targets && is_within_tolerance;
+             ++target_index) {
+            std::copy_n(validation_targets.begin() +
+                            static_cast<std::ptrdiff_t>(target_index * number_of_dimensions),
+                        number_of_dimensions,
+                        target.begin());
+            set_chebyshev_polynomials(target);
+            for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+                 ++data_set_index) {
+                const double error =
+                    std::abs(evaluate_data_set(data_set_index) -
+                             expected_results[target_index * number_of_data_sets + data_set_index]);
+                maximum_errors[data_set_index] = std::max(maximum_errors[data_set_index], error);
+                is_within_tolerance = is_within_tolerance && error <= tolerance;
+            }
+        }
+        if (is_within_tolerance) {
+            break;
+        }
+
+        // Refine the axes whose upper half of coefficients (the highest degrees) are largest
+        std::vector<double> tail_magnitudes(number_of_dimensions, 0.0);
+        std::size_t stride = number_of_coefficients;
+        for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+            const std::size_t number_of_points = points_per_axis[axis_index];
+            stride /= number_of_points;
+            if (number_of_points < 2u || number_of_points >= maximum_points_per_axis) {
+                continue;
+            }
+            for (const auto& data_set_coefficients : coefficients) {
+                for (std::size_t index = 0; index < number_of_coefficients; ++index) {
+                    if ((index / stride) % number_of_points >= number_of_points / 2u) {
+                        tail_magnitudes[axis_index] =
+                            std::max(tail_magnitudes[axis_index],
+                                     std::abs(data_set_coefficients[index]));
+                    }
+                }
+            }
+        }
+        const double largest_tail_magnitude =
+            *std::max_element(tail_magnitudes.begin(), tail_magnitudes.end());
+        bool is_refined = false;
+        for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+            const std::size_t number_of_points = points_per_axis[axis_index];
+            if (number_of_points >= 2u && number_of_points < maximum_points_per_axis &&
+                tail_magnitudes[axis_index] >= 0.5 * largest_tail_magnitude) {
+                points_per_axis[axis_index] =
+                    std::min(2u * number_of_points, maximum_points_per_axis);
+                is_refined = true;
+            }
+        }
+        if (!is_refined) {
+            send_error(fmt::format("Cannot fit surrogate within tolerance ({}) using at most {} "
+                                   "points per axis (error of data set {}: {}).",
+                                   tolerance,
+                                   maximum_points_per_axis,
+                                   std::distance(maximum_errors.begin(),
+                                                 std::max_element(maximum_errors.begin(),
+                                                                  maximum_errors.end())),
+                                   *std::max_element(maximum_errors.begin(),
+                                                     maximum_errors.end())));
+        }
+    }
+
+    std::vector<std::vector<double>> sample_targets;
+    const std::size_t sample_step =
+        std::max(number_of_validation_targets / maximum_number_of_speedup_targets, std::size_t {1});
+    for (std::size_t target_index = 0; target_index < number_of_validation_targets;
+         target_index += sample_step) {
+        auto first = validation_targets.begin() +
+                     static_cast<std::ptrdiff_t>(target_index * number_of_dimensions);
+        sample_targets.emplace_back(first,
+                                    first + static_cast<std::ptrdiff_t>(number_of_dimensions));
+    }
+    measure_speedup(sample_targets);
+}
+
+void ChebyshevSurrogate::calculate_coefficients(
+    const std::vector<double>& values_at_chebyshev_points)
+{
+    // Discrete cosine transform along each axis in turn:
+    //   c_j = (2 - [j == 0]) / n * sum_k f(x_k) * cos(pi * j * (k + 1/2) / n)
+    const std::size_t number_of_coefficients = get_number_of_coefficients();
+    coefficients.assign(number_of_data_sets, std::vector<double>(number_of_coefficients));
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        auto& data_set_coefficients = coefficients[data_set_index];
+        for (std::size_t index = 0; index < number_of_coefficients; ++index) {
+            data_set_coefficients[index] =
+                values_at_chebyshev_points[index * number_of_data_sets + data_set_index];
+        }
+    }
+    std::size_t stride = number_of_coefficients;
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        const std::size_t number_of_points = points_per_axis[axis_index];
+        stride /= number_of_points;
+        std::vector<double> cosines(number_of_points * number_of_points);
+        for (std::size_t degree = 0; degree < number_of_points; ++degree) {
+            for (std::size_t point_index = 0; point_index < number_of_points; ++point_index) {
+                cosines[degree * number_of_points + point_index] =
+                    (degree == 0u ? 1.0 : 2.0) / static_cast<double>(number_of_points) *
+                    std::cos(pi * static_cast<double>(degree) *
+                             (static_cast<double>(point_index) + 0.5) /
+                             static_cast<double>(number_of_points));
+            }
+        }
+        std::vector<double> line(number_of_points);
+        for (auto& data_set_coefficients : coefficients) {
+            for (std::size_t outer_index = 0; outer_index < number_of_coefficients;
+                 outer_index += number_of_points * stride) {
+                for (std::size_t inner_index = 0; inner_index < stride; ++inner_index) {
+                    double* first = data_set_coefficients.data() + outer_index + inner_index;
+                    for (std::size_t point_index = 0; point_index < number_of_points;
+                         ++point_index) {
+                        line[point_index] = first[point_index * stride];
+                    }
+                    for (std::size_t degree = 0; degree < number_of_points; ++degree) {
+                        double coefficient = 0.0;
+                        for (std::size_t point_index = 0; point_index < number_of_points;
+                             ++point_index) {
+                            coefficient += cosines[degree * number_of_points + point_index] *
+                                           line[point_index];
+                        }
+                        first[degree * stride] = coefficient;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChebyshevSurrogate::set_chebyshev_polynomials(const std::vector<double>& target)
+{
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        const auto [lower_bound, upper_bound] = fitted_region[axis_index];
+        const double x = upper_bound > lower_bound ? (2.0 * target[axis_index] - lower_bound -
+                                                      upper_bound) /
+                                                         (upper_bound - lower_bound)
+                                                   : 0.0;
+        auto& polynomials = chebyshev_polynomials[axis_index];
+        const std::size_t number_of_points = points_per_axis[axis_index];
+        polynomials.resize(number_of_points);
+        polynomials[0] = 1.0;
+        if (number_of_points > 1u) {
+            polynomials[1] = x;
+        }
+        for (std::size_t degree = 2; degree < number_of_points; ++degree) {
+            polynomials[degree] = 2.0 * x * polynomials[degree - 1] - polynomials[degree - 2];
+        }
+    }
+}
+
+double ChebyshevSurrogate::evaluate_data_set(std::size_t data_set_index)
+{
+    // Contract the coefficients with each axis's polynomials, starting from the last axis
+    const double* source = coefficients[data_set_index].data();
+    std::size_t size = contraction.size();
+    for (std::size_t axis_index = number_of_dimensions; axis_index-- > 0;) {
+        const auto& polynomials = chebyshev_polynomials[axis_index];
+        const std::size_t number_of_points = polynomials.size();
+        size /= number_of_points;
+        for (std::size_t index = 0; index < size; ++index) {
+            const double* line = source + index * number_of_points;
+            double sum = 0.0;
+            for (std::size_t degree = 0; degree < number_of_points; ++degree) {
+                sum += line[degree] * polynomials[degree];
+            }
+            contraction[index] = sum;
+        }
+        source = contraction.data();
+    }
+    return source[0];
+}
+
+void ChebyshevSurrogate::measure_speedup(const std::vector<std::vector<double>>& sample_targets)
+{
+    auto time = [&](auto evaluate) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& sample_target : sample_targets) {
+            evaluate(sample_target);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(stop - start).count();
+    };
+    const double interpolator_duration = time([&](const std::vector<double>& target) {
+        return interpolator.get_values_at_target(target);
+    });
+    const double surrogate_duration =
+        time([&](const std::vector<double>& target) { return get_values_at_target(target); });
+    speedup = surrogate_duration > 0.0 ? interpolator_duration / surrogate_duration : 1.0;
+}
+
+std::size_t ChebyshevSurrogate::get_number_of_coefficients() const
+{
+    std::size_t number_of_coefficients = 1u;
+    for (auto number_of_points : points_per_axis) {
+        number_of_coefficients *= number_of_points;
+    }
+    return number_of_coefficients;
+}
+
+bool ChebyshevSurrogate::is_in_fitted_region(const std::vector<double>& target) const
+{
+    if (target.size() != number_of_dimensions) {
+        return false;
+    }
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        if (!(target[axis_index] >= fitted_region[axis_index].first &&
+              target[axis_index] <= fitted_region[axis_index].second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<double> ChebyshevSurrogate::get_values_at_target(const std::vector<double>& target)
+{
+    if (!is_in_fitted_region(target)) {
+        return interpolator.get_values_at_target(target);
+    }
+    set_chebyshev_polynomials(target);
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        results[data_set_index] = evaluate_data_set(data_set_index);
+    }
+    return results;
+}
+
+double ChebyshevSurrogate::get_value_at_target(const std::vector<double>& target,
+                                               std::size_t data_set_index)
+{
+    if (!is_in_fitted_region(target)) {
+        return interpolator.get_value_at_target(target, data_set_index);
+    }
+    if (data_set_index >= number_of_data_sets) {
+        send_error(fmt::format("Data set index ({}) is out of range ({} data sets).",
+                               data_set_index,
+                               number_of_data_sets));
+    }
+    set_chebyshev_polynomials(target);
+    return evaluate_data_set(data_set_index);
+}
+
+std::vector<std::vector<double>>
+ChebyshevSurrogate::get_values_at_targets(const std::vector<std::vector<double>>& targets)
+{
+    std::vector<std::vector<double>> results_at_targets;
+    results_at_targets.reserve(targets.size());
+    for (const auto& target : targets) {
+        results_at_targets.push_back(get_values_at_target(target));
+    }
+    return results_at_targets;
+}
+
+} // namespace Btwxt
@@ -1,6 +1,9 @@
 /* Copyright (c) 2018 Big Ladder Software LLC. All rights reserved.
  * See the LICENSE file for additional terms and conditions. */
 
+// Standard
+#include <limits>
+
 // btwxt
 #include <btwxt/btwxt.h>
 #include "regular-grid-interpolator-implementation.h"
@@ -30,6 +33,7 @@ GridAxis::GridAxis(std::vector<double> values_in,
     if (interpolation_method == InterpolationMethod::cubic) {
         calculate_cubic_spacing_ratios();
     }
+    build_search_tree();
 }
 
 void GridAxis::set_interpolation_method(InterpolationMethod interpolation_method_in)
@@ -83,6 +87,31 @@ void GridAxis::calculate_cubic_spacing_ratios()
     }
 }
 
+void GridAxis::build_search_tree()
+{
+    // Element k at depth d (2^d <= k < 2^(d + 1)) of a complete tree of height h holds sorted
+    // value (2 (k - 2^d) + 1) 2^(h - 1 - d) - 1
+    search_tree_height = 0u;
+    while ((std::size_t {1u} << search_tree_height) - 1u < values.size()) {
+        ++search_tree_height;
+    }
+    const std::size_t tree_size = std::size_t {1u} << search_tree_height;
+    search_tree.assign(tree_size, std::numeric_limits<double>::infinity());
+    std::size_t depth = 0u;
+    for (std::size_t node = 1u; node < tree_size; ++node) {
+        if (node == std::size_t {2u} << depth) {
+            ++depth;
+        }
+        const std::size_t value_index =
+            (2u * (node - (std::size_t {1u} << depth)) + 1u) *
+                (std::size_t {1u} << (search_tree_height - 1u - depth)) -
+            1u;
+        if (value_index < values.size()) {
+            search_tree[node] = values[value_index];
+        }
+    }
+}
+
 const std::vector<double>&
 GridAxis::get_cubic_spacing_ratios(const std::size_t floor_or_ceiling) const
 {
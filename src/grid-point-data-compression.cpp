@@ -0,0 +1,239 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// btwxt
+#include "grid-point-data-compression.h"
+
+namespace Btwxt {
+
+namespace {
+
+constexpr double maximum_quantized_residual {4503599627370496.0}; // 2^52
+
+inline double predict(const double* values, std::size_t index, std::size_t stride)
+{
+    // Linear extrapolation of the previous two values
+    double prediction = 0.0;
+    if (index == 1u) {
+        prediction = values[0];
+    }
+    else if (index > 1u) {
+        prediction = 2.0 * values[(index - 1u) * stride] - values[(index - 2u) * stride];
+    }
+    return std::isfinite(prediction) ? prediction : 0.0;
+}
+
+inline std::uint64_t to_bits(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double from_bits(std::uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline void write_varint(std::uint64_t value, std::vector<std::uint8_t>& bytes)
+{
+    while (value >= 0x80u) {
+        bytes.push_back(static_cast<std::uint8_t>(value | 0x80u));
+        value >>= 7u;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline std::uint64_t read_varint(const std::uint8_t*& bytes)
+{
+    std::uint64_t value = 0u;
+    unsigned shift = 0u;
+    while (*bytes & 0x80u) {
+        value |= std::uint64_t {*bytes++ & 0x7Fu} << shift;
+        shift += 7u;
+    }
+    value |= std::uint64_t {*bytes++} << shift;
+    return value;
+}
+
+inline void write_raw(std::uint64_t bits, std::vector<std::uint8_t>& bytes)
+{
+    for (unsigned byte_index = 0u; byte_index < 8u; ++byte_index) {
+        bytes.push_back(static_cast<std::uint8_t>(bits >> (8u * byte_index)));
+    }
+}
+
+inline std::uint64_t read_raw(const std::uint8_t*& bytes)
+{
+    std::uint64_t bits = 0u;
+    for (unsigned byte_index = 0u; byte_index < 8u; ++byte_index) {
+        bits |= std::uint64_t {*bytes++} << (8u * byte_index);
+    }
+    return bits;
+}
+
+} // namespace
+
+CompressedGridPointData::CompressedGridPointData(
+    const std::vector<GridPointDataSet>& grid_point_data_sets,
+    double maximum_error,
+    std::size_t block_size)
+    : maximum_error(maximum_error)
+    , quantization_step(maximum_error > 0.0 ? std::ldexp(1.0, std::ilogb(2.0 * maximum_error))
+                                            : 0.0)
+    , block_size(block_size)
+    , number_of_values(grid_point_data_sets.empty() ? 0u : grid_point_data_sets[0].data.size())
+    , number_of_data_sets(grid_point_data_sets.size())
+    , number_of_blocks((number_of_values + block_size - 1u) / block_size)
+    , encoded_data(number_of_data_sets)
+    , block_offsets(number_of_data_sets)
+{
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        const auto& data = grid_point_data_sets[data_set_index].data;
+        auto& encoded_values = encoded_data[data_set_index];
+        auto& offsets = block_offsets[data_set_index];
+        offsets.reserve(number_of_blocks + 1u);
+        for (std::size_t block_index = 0; block_index < number_of_blocks; ++block_index) {
+            offsets.push_back(encoded_values.size());
+            encode_block(data.data() + block_index * block_size,
+                         get_block_length(block_index),
+                         encoded_values);
+        }
+        offsets.push_back(encoded_values.size());
+        encoded_values.shrink_to_fit();
+    }
+}
+
+void CompressedGridPointData::decode_block(std::size_t block_index, double* values) const
+{
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        decode_block_values(encoded_data[data_set_index].data() +
+                                block_offsets[data_set_index][block_index],
+                            get_block_length(block_index),
+                            values + data_set_index,
+                            number_of_data_sets);
+    }
+}
+
+std::vector<double> CompressedGridPointData::decode_data_set(std::size_t data_set_index) const
+{
+    std::vector<double> data(number_of_values);
+    for (std::size_t block_index = 0; block_index < number_of_blocks; ++block_index) {
+        decode_block_values(encoded_data[data_set_index].data() +
+                                block_offsets[data_set_index][block_index],
+                            get_block_length(block_index),
+                            data.data() + block_index * block_size,
+                            1u);
+    }
+    return data;
+}
+
+std::size_t CompressedGridPointData::get_compressed_size() const
+{
+    std::size_t compressed_size = 0u;
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        compressed_size += encoded_data[data_set_index].size() +
+                           block_offsets[data_set_index].size() * sizeof(std::size_t);
+    }
+    return compressed_size;
+}
+
+std::size_t CompressedGridPointData::get_uncompressed_size() const
+{
+    return number_of_data_sets * number_of_values * sizeof(double);
+}
+
+std::size_t CompressedGridPointData::get_block_length(std::size_t block_index) const
+{
+    return std::min(block_size, number_of_values - block_index * block_size);
+}
+
+void CompressedGridPointData::encode_block(const double* values,
+                                           std::size_t block_length,
+                                           std::vector<std::uint8_t>& encoded_values) const
+{
+    // Predictions are made from decoded values so that encoding errors do not accumulate
+    std::vector<double> decoded_values(block_length);
+    for (std::size_t index = 0; index < block_length; ++index) {
+        double prediction = predict(decoded_values.data(), index, 1u);
+        if (maximum_error == 0.0) {
+            std::uint64_t residual = to_bits(values[index]) ^ to_bits(prediction);
+            unsigned leading_zero_bytes = 0u;
+            while (leading_zero_bytes < 8u && !(residual >> (56u - 8u * leading_zero_bytes))) {
+                ++leading_zero_bytes;
+            }
+            unsigned trailing_zero_bytes = 0u;
+            while (trailing_zero_bytes + leading_zero_bytes < 8u &&
+                   !((residual >> (8u * trailing_zero_bytes)) & 0xFFu)) {
+                ++trailing_zero_bytes;
+            }
+            encoded_values.push_back(
+                static_cast<std::uint8_t>(leading_zero_bytes << 4u | trailing_zero_bytes));
+            for (unsigned byte_index = trailing_zero_bytes; byte_index < 8u - leading_zero_bytes;
+                 ++byte_index) {
+                encoded_values.push_back(static_cast<std::uint8_t>(residual >> (8u * byte_index)));
+            }
+            decoded_values[index] = values[index];
+            continue;
+        }
+        const double quantized_residual =
+            std::round((values[index] - prediction) / quantization_step);
+        const double decoded_value = prediction + quantized_residual * quantization_step;
+        if (std::isfinite(values[index]) &&
+            std::abs(quantized_residual) < maximum_quantized_residual &&
+            std::abs(values[index] - decoded_value) <= maximum_error) {
+            // Zigzag encoded so that small negative residuals are also short. Zero is reserved.
+            auto residual = static_cast<std::int64_t>(quantized_residual);
+            auto zigzag_residual = (static_cast<std::uint64_t>(residual) << 1u) ^
+                                   static_cast<std::uint64_t>(residual >> 63);
+            write_varint(zigzag_residual + 1u, encoded_values);
+            decoded_values[index] = decoded_value;
+        }
+        else {
+            // Stored exactly
+            encoded_values.push_back(0u);
+            write_raw(to_bits(values[index]), encoded_values);
+            decoded_values[index] = values[index];
+        }
+    }
+}
+
+void CompressedGridPointData::decode_block_values(const std::uint8_t* encoded_values,
+                                                  std::size_t block_length,
+                                                  double* values,
+                                                  std::size_t stride) const
+{
+    for (std::size_t index = 0; index < block_length; ++index) {
+        double prediction = predict(values, index, stride);
+        if (maximum_error == 0.0) {
+            std::uint8_t header = *encoded_values++;
+            unsigned leading_zero_bytes = header >> 4u;
+            unsigned trailing_zero_bytes = header & 0x0Fu;
+            std::uint64_t residual = 0u;
+            for (unsigned byte_index = trailing_zero_bytes; byte_index < 8u - leading_zero_bytes;
+                 ++byte_index) {
+                residual |= std::uint64_t {*encoded_values++} << (8u * byte_index);
+            }
+            values[index * stride] = from_bits(to_bits(prediction) ^ residual);
+            continue;
+        }
+        std::uint64_t token = read_varint(encoded_values);
+        if (token == 0u) {
+            values[index * stride] = from_bits(read_raw(encoded_values));
+            continue;
+        }
+        --token;
+        auto residual =
+            static_cast<std::int64_t>(token >> 1u) ^ -static_cast<std::int64_t>(token & 1u);
+        values[index * stride] = prediction + static_cast<double>(residual) * quantization_step;
+    }
+}
+
+} // namespace Btwxt
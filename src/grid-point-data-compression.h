@@ -0,0 +1,67 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <cstdint>
+#include <vector>
+
+// btwxt
+#include <btwxt/grid-point-data.h>
+
+namespace Btwxt {
+
+class CompressedGridPointData {
+    // Grid point data sets encoded in blocks of consecutive (stored) grid points. Each value is
+    // predicted from the previous two decoded values in its block. With a nonzero maximum error,
+    // the prediction residual is quantized so that every decoded value is within the maximum error
+    // of the original value. The quantization step is a power of two so that decoding is exact
+    // regardless of floating-point contraction. With a zero maximum error, the bits of the
+    // residual (value XOR prediction) are stored without their leading and trailing zero bytes, so
+    // decoded values are exact.
+  public:
+    CompressedGridPointData(const std::vector<GridPointDataSet>& grid_point_data_sets,
+                            double maximum_error,
+                            std::size_t block_size);
+
+    // Writes every data set's values for the block, interleaved by grid point:
+    // values[point_in_block * number_of_data_sets + data_set_index]
+    void decode_block(std::size_t block_index, double* values) const;
+
+    [[nodiscard]] std::vector<double> decode_data_set(std::size_t data_set_index) const;
+
+    [[nodiscard]] std::size_t get_block_size() const { return block_size; }
+
+    [[nodiscard]] std::size_t get_number_of_blocks() const { return number_of_blocks; }
+
+    [[nodiscard]] double get_maximum_error() const { return maximum_error; }
+
+    [[nodiscard]] std::size_t get_compressed_size() const; // Bytes
+
+    [[nodiscard]] std::size_t get_uncompressed_size() const; // Bytes
+
+  private:
+    double maximum_error;
+    double quantization_step; // Largest power of two not greater than twice the maximum error
+    std::size_t block_size;
+    std::size_t number_of_values; // Per data set
+    std::size_t number_of_data_sets;
+    std::size_t number_of_blocks;
+    std::vector<std::vector<std::uint8_t>> encoded_data; // For each data set
+    std::vector<std::vector<std::size_t>>
+        block_offsets; // For each data set, the start of each block in encoded_data (and the end)
+
+    [[nodiscard]] std::size_t get_block_length(std::size_t block_index) const;
+
+    void encode_block(const double* values,
+                      std::size_t block_length,
+                      std::vector<std::uint8_t>& encoded_values) const;
+
+    void decode_block_values(const std::uint8_t* encoded_values,
+                             std::size_t block_length,
+                             double* values,
+                             std::size_t stride) const;
+};
+
+} // namespace Btwxt
@@ -0,0 +1,336 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+#include <cstring>
+
+// btwxt
+#include "grid-point-data-file.h"
+
+namespace Btwxt {
+
+namespace {
+
+std::uint64_t read_uint64(std::ifstream& file)
+{
+    std::uint64_t value {0u};
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+void write_uint64(std::ofstream& file, std::uint64_t value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+// GridPointDataFileWriter
+
+GridPointDataFileWriter::GridPointDataFileWriter(
+    const std::string& path,
+    const std::vector<std::string>& data_set_names,
+    std::uint64_t number_of_grid_points,
+    std::uint64_t block_size,
+    const std::shared_ptr<Courier::Courier>& courier)
+    : Courier::Sender(path, courier)
+    , file(path, std::ios::binary | std::ios::trunc)
+    , number_of_data_sets(data_set_names.size())
+    , number_of_grid_points(number_of_grid_points)
+    , block_size(block_size)
+{
+    class_name = "GridPointDataFileWriter";
+    if (!file) {
+        send_error("Unable to open file for writing.");
+    }
+    if (block_size == 0u) {
+        send_error("Block size must be greater than zero.");
+    }
+    file.write(grid_point_data_file_magic, sizeof(grid_point_data_file_magic));
+    write_uint64(file, grid_point_data_file_version);
+    write_uint64(file, number_of_data_sets);
+    write_uint64(file, number_of_grid_points);
+    write_uint64(file, block_size);
+    static constexpr char padding[8] {};
+    for (const auto& data_set_name : data_set_names) {
+        write_uint64(file, data_set_name.size());
+        file.write(data_set_name.data(), static_cast<std::streamsize>(data_set_name.size()));
+        file.write(padding, static_cast<std::streamsize>((8u - data_set_name.size() % 8u) % 8u));
+    }
+    block_values.reserve(block_size * number_of_data_sets);
+}
+
+GridPointDataFileWriter::~GridPointDataFileWriter()
+{
+    if (file.is_open()) {
+        write_block();
+        file.close();
+    }
+}
+
+void GridPointDataFileWriter::append(const std::vector<double>& grid_point_values)
+{
+    if (grid_point_values.size() != number_of_data_sets) {
+        send_error(fmt::format("Number of grid point values ({}) does not match number of data "
+                               "sets ({}).",
+                               grid_point_values.size(),
+                               number_of_data_sets));
+    }
+    if (number_of_appended_grid_points == number_of_grid_points) {
+        send_error(fmt::format("All {} grid points have already been written.",
+                               number_of_grid_points));
+    }
+    block_values.insert(block_values.end(), grid_point_values.begin(), grid_point_values.end());
+    ++number_of_appended_grid_points;
+    if (block_values.size() == block_size * number_of_data_sets) {
+        write_block();
+    }
+}
+
+void GridPointDataFileWriter::close()
+{
+    write_block();
+    file.close();
+    if (number_of_appended_grid_points != number_of_grid_points) {
+        send_error(fmt::format("Only {} of {} grid points were written.",
+                               number_of_appended_grid_points,
+                               number_of_grid_points));
+    }
+    if (!file) {
+        send_error("Unable to write file.");
+    }
+}
+
+void GridPointDataFileWriter::write_block()
+{
+    file.write(reinterpret_cast<const char*>(block_values.data()),
+               static_cast<std::streamsize>(block_values.size() * sizeof(double)));
+    block_values.clear();
+}
+
+void write_grid_point_data_file(const std::string& path,
+                                const std::vector<GridPointDataSet>& grid_point_data_sets,
+                                std::uint64_t block_size,
+                                const std::shared_ptr<Courier::Courier>& courier)
+{
+    std::vector<std::string> data_set_names;
+    for (const auto& grid_point_data_set : grid_point_data_sets) {
+        data_set_names.push_back(grid_point_data_set.name);
+    }
+    std::uint64_t number_of_grid_points =
+        grid_point_data_sets.empty() ? 0u : grid_point_data_sets[0].data.size();
+    GridPointDataFileWriter writer(
+        path, data_set_names, number_of_grid_points, block_size, courier);
+    std::vector<double> grid_point_values(grid_point_data_sets.size());
+    for (std::uint64_t grid_point_index = 0; grid_point_index < number_of_grid_points;
+         ++grid_point_index) {
+        for (std::size_t data_set_index = 0; data_set_index < grid_point_data_sets.size();
+             ++data_set_index) {
+            grid_point_values[data_set_index] =
+                grid_point_data_sets[data_set_index].data[grid_point_index];
+        }
+        writer.append(grid_point_values);
+    }
+    writer.close();
+}
+
+// PagedGridPointData
+
+PagedGridPointData::PagedGridPointData(const std::string& path,
+                                       std::size_t maximum_resident_size,
+                                       const std::shared_ptr<Courier::Courier>& courier)
+    : Courier::Sender(path, courier), file(path, std::ios::binary)
+{
+    class_name = "GridPointDataFile";
+    if (!file) {
+        send_error("Unable to open file.");
+    }
+    char magic[sizeof(grid_point_data_file_magic)] {};
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, grid_point_data_file_magic, sizeof(magic)) != 0) {
+        send_error("Not a grid point data file.");
+    }
+    std::uint64_t version = read_uint64(file);
+    if (version != grid_point_data_file_version) {
+        send_error(fmt::format("Unsupported file version ({}).", version));
+    }
+    std::uint64_t number_of_data_sets = read_uint64(file);
+    number_of_grid_points = read_uint64(file);
+    block_size = read_uint64(file);
+
+    // Sizes read from the file are checked against the bytes remaining before they are used
+    const std::uint64_t header_offset = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0, std::ios::end);
+    const std::uint64_t file_size = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(static_cast<std::streamoff>(header_offset));
+    auto get_remaining_size = [&]() {
+        return file_size - std::min(static_cast<std::uint64_t>(file.tellg()), file_size);
+    };
+    if (!file || number_of_data_sets > get_remaining_size() / sizeof(std::uint64_t)) {
+        send_error("Unable to read file header.");
+    }
+    for (std::uint64_t data_set_index = 0; file && data_set_index < number_of_data_sets;
+         ++data_set_index) {
+        std::uint64_t name_length = read_uint64(file);
+        if (!file || name_length > get_remaining_size()) {
+            send_error("Unable to read file header.");
+        }
+        std::string data_set_name(name_length, '\0');
+        file.read(data_set_name.data(), static_cast<std::streamsize>(name_length));
+        file.ignore(static_cast<std::streamsize>((8u - name_length % 8u) % 8u));
+        data_set_names.push_back(std::move(data_set_name));
+    }
+    if (!file || block_size == 0u) {
+        send_error("Unable to read file header.");
+    }
+    data_offset = static_cast<std::uint64_t>(file.tellg());
+    const std::uint64_t grid_point_size = data_set_names.size() * sizeof(double);
+    if (grid_point_size > 0u && number_of_grid_points > get_remaining_size() / grid_point_size) {
+        send_error(fmt::format("File is too short for {} grid points.", number_of_grid_points));
+    }
+    std::size_t block_memory_size = std::min(block_size, number_of_grid_points) * grid_point_size;
+    if (block_memory_size > 0u) {
+        maximum_number_of_resident_blocks =
+            std::max(maximum_resident_size / block_memory_size, std::size_t {1});
+    }
+}
+
+PagedGridPointData::~PagedGridPointData()
+{
+    {
+        std::lock_guard<std::mutex> lock(prefetch_mutex);
+        prefetch_is_stopping = true;
+    }
+    prefetch_requested.notify_one();
+    if (prefetch_thread.joinable()) {
+        prefetch_thread.join();
+    }
+}
+
+PagedGridPointData::Block PagedGridPointData::get_block(std::uint64_t block_index)
+{
+    Block block = find_or_read_block(block_index);
+    if (!block) {
+        send_error(fmt::format("Unable to read block {}.", block_index));
+    }
+    return block;
+}
+
+PagedGridPointData::Block PagedGridPointData::find_or_read_block(std::uint64_t block_index)
+{
+    {
+        std::lock_guard<std::mutex> lock(resident_blocks_mutex);
+        auto resident_block = resident_blocks.find(block_index);
+        if (resident_block != resident_blocks.end()) {
+            resident_block_order.splice(
+                resident_block_order.begin(), resident_block_order, resident_block->second.second);
+            return resident_block->second.first;
+        }
+    }
+    Block block = read_block(block_index); // Other threads may use the resident set meanwhile
+    if (!block) {
+        return block;
+    }
+    std::lock_guard<std::mutex> lock(resident_blocks_mutex);
+    ++number_of_block_reads;
+    auto resident_block = resident_blocks.find(block_index);
+    if (resident_block != resident_blocks.end()) {
+        return resident_block->second.first; // Read by another thread meanwhile
+    }
+    resident_block_order.push_front(block_index);
+    resident_blocks.emplace(block_index, std::make_pair(block, resident_block_order.begin()));
+    while (resident_blocks.size() > maximum_number_of_resident_blocks) {
+        // Evicted blocks remain valid for any interpolator still holding them
+        resident_blocks.erase(resident_block_order.back());
+        resident_block_order.pop_back();
+    }
+    return block;
+}
+
+void PagedGridPointData::prefetch(const std::vector<std::uint64_t>& block_indices)
+{
+    {
+        std::lock_guard<std::mutex> lock(prefetch_mutex);
+        prefetch_block_indices.insert(
+            prefetch_block_indices.end(), block_indices.begin(), block_indices.end());
+        // More blocks than can be resident would evict each other before they are used
+        while (prefetch_block_indices.size() > maximum_number_of_resident_blocks / 2u) {
+            prefetch_block_indices.pop_front();
+        }
+        if (!prefetch_thread.joinable()) {
+            prefetch_thread = std::thread(&PagedGridPointData::prefetch_blocks, this);
+        }
+    }
+    prefetch_requested.notify_one();
+}
+
+void PagedGridPointData::prefetch_blocks()
+{
+    std::unique_lock<std::mutex> lock(prefetch_mutex);
+    while (true) {
+        prefetch_requested.wait(
+            lock, [this]() { return prefetch_is_stopping || !prefetch_block_indices.empty(); });
+        if (prefetch_is_stopping) {
+            return;
+        }
+        const std::uint64_t block_index = prefetch_block_indices.front();
+        prefetch_block_indices.pop_front();
+        lock.unlock();
+        try {
+            find_or_read_block(block_index); // Read errors are sent when the block is used
+        }
+        catch (...) {
+            // E.g., allocation failures, which recur when the block is used
+        }
+        lock.lock();
+    }
+}
+
+std::vector<double> PagedGridPointData::read_data_set(std::size_t data_set_index)
+{
+    std::vector<double> data(number_of_grid_points);
+    const std::size_t number_of_data_sets = data_set_names.size();
+    for (std::uint64_t grid_point_index = 0; grid_point_index < number_of_grid_points;
+         grid_point_index += block_size) {
+        Block block = read_block(grid_point_index / block_size);
+        if (!block) {
+            send_error(fmt::format("Unable to read block {}.", grid_point_index / block_size));
+        }
+        for (std::size_t point_in_block = 0; point_in_block * number_of_data_sets < block->size();
+             ++point_in_block) {
+            data[grid_point_index + point_in_block] =
+                (*block)[point_in_block * number_of_data_sets + data_set_index];
+        }
+    }
+    return data;
+}
+
+GridPointDataPagingStatistics PagedGridPointData::get_statistics()
+{
+    std::lock_guard<std::mutex> lock(resident_blocks_mutex);
+    return {number_of_block_reads, resident_blocks.size(), maximum_number_of_resident_blocks};
+}
+
+PagedGridPointData::Block PagedGridPointData::read_block(std::uint64_t block_index)
+{
+    const std::uint64_t first_grid_point = block_index * block_size;
+    const std::uint64_t block_length =
+        std::min(block_size,
+                 number_of_grid_points - std::min(first_grid_point, number_of_grid_points));
+    const std::uint64_t number_of_values = block_length * data_set_names.size();
+    auto block = std::make_shared<std::vector<double>>(number_of_values);
+    std::lock_guard<std::mutex> lock(file_mutex);
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(data_offset +
+                                           first_grid_point * data_set_names.size() *
+                                               sizeof(double)));
+    file.read(reinterpret_cast<char*>(block->data()),
+              static_cast<std::streamsize>(number_of_values * sizeof(double)));
+    if (!file) {
+        return nullptr;
+    }
+    return block;
+}
+
+} // namespace Btwxt
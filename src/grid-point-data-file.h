@@ -0,0 +1,103 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// btwxt
+#include <btwxt/grid-point-data-file-writer.h>
+
+namespace Btwxt {
+
+// Grid point data file format:
+//   "BTWXTGPD", version, number of data sets, number of grid points, block size (all uint64)
+//   For each data set: name length (uint64) and name characters, padded to a multiple of 8 bytes
+//   Blocks of block size grid points (the last may be shorter), values interleaved by grid point
+constexpr char grid_point_data_file_magic[8] {'B', 'T', 'W', 'X', 'T', 'G', 'P', 'D'};
+constexpr std::uint64_t grid_point_data_file_version {1u};
+
+class PagedGridPointData : public Courier::Sender {
+    // Grid point data read from a file one block at a time. Recently used blocks are kept in
+    // memory (the resident set) up to a maximum number of blocks. Blocks may be requested from
+    // multiple threads.
+  public:
+    PagedGridPointData(const std::string& path,
+                       std::size_t maximum_resident_size,
+                       const std::shared_ptr<Courier::Courier>& courier);
+
+    ~PagedGridPointData();
+
+    PagedGridPointData(const PagedGridPointData&) = delete;
+
+    PagedGridPointData& operator=(const PagedGridPointData&) = delete;
+
+    using Block = std::shared_ptr<const std::vector<double>>;
+
+    Block get_block(std::uint64_t block_index);
+
+    // Reads the blocks into the resident set in the background, by a single prefetch thread
+    // (started by the first request). Requests are queued in order. When more blocks are pending
+    // than half of the resident set, the oldest are dropped. Read errors are not sent until the
+    // block is requested with get_block.
+    void prefetch(const std::vector<std::uint64_t>& block_indices);
+
+    [[nodiscard]] std::vector<double> read_data_set(std::size_t data_set_index);
+
+    [[nodiscard]] const std::vector<std::string>& get_data_set_names() const
+    {
+        return data_set_names;
+    }
+
+    [[nodiscard]] std::uint64_t get_number_of_grid_points() const { return number_of_grid_points; }
+
+    [[nodiscard]] std::uint64_t get_block_size() const { return block_size; }
+
+    [[nodiscard]] std::size_t get_maximum_number_of_resident_blocks() const
+    {
+        return maximum_number_of_resident_blocks;
+    }
+
+    [[nodiscard]] GridPointDataPagingStatistics get_statistics();
+
+  private:
+    std::ifstream file;
+    std::mutex file_mutex;
+    std::vector<std::string> data_set_names;
+    std::uint64_t number_of_grid_points {0u};
+    std::uint64_t block_size {0u};
+    std::uint64_t data_offset {0u}; // Bytes from the start of the file to the first block
+    std::size_t maximum_number_of_resident_blocks {1u};
+
+    std::mutex resident_blocks_mutex;
+    std::list<std::uint64_t> resident_block_order; // Most recently used first
+    std::unordered_map<std::uint64_t, std::pair<Block, std::list<std::uint64_t>::iterator>>
+        resident_blocks;
+    std::size_t number_of_block_reads {0u};
+
+    std::mutex prefetch_mutex;
+    std::condition_variable prefetch_requested;
+    std::deque<std::uint64_t> prefetch_block_indices; // Not yet read
+    bool prefetch_is_stopping {false};
+    std::thread prefetch_thread;
+
+    // Returns nullptr (without sending an error) if the block cannot be read
+    Block find_or_read_block(std::uint64_t block_index);
+
+    Block read_block(std::uint64_t block_index);
+
+    void prefetch_blocks();
+};
+
+} // namespace Btwxt
@@ -0,0 +1,53 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// btwxt
+#include "hypercube-cache.h"
+
+namespace Btwxt {
+
+HypercubeCache::HypercubeCache(const HypercubeCache& source)
+    : maximum_memory_size(source.maximum_memory_size)
+{
+}
+
+HypercubeCache& HypercubeCache::operator=(const HypercubeCache& source)
+{
+    if (this != &source) {
+        clear();
+        maximum_memory_size = source.maximum_memory_size;
+    }
+    return *this;
+}
+
+const HypercubeCache::Entry* HypercubeCache::find(const Key& key) const
+{
+    auto entry_iterator = entries.find(key);
+    return entry_iterator == entries.end() ? nullptr : &entry_iterator->second;
+}
+
+void HypercubeCache::insert(const Key& key, const Entry& entry, std::size_t entry_memory_size)
+{
+    if (entry_memory_size > maximum_memory_size - memory_size) {
+        return;
+    }
+    if (entries.emplace(key, entry).second) {
+        memory_size += entry_memory_size;
+    }
+}
+
+void HypercubeCache::set_maximum_memory_size(std::size_t maximum_memory_size_in)
+{
+    maximum_memory_size = maximum_memory_size_in;
+    if (memory_size > maximum_memory_size) {
+        clear();
+    }
+}
+
+void HypercubeCache::clear()
+{
+    entries.clear();
+    memory_size = 0u;
+}
+
+} // namespace Btwxt
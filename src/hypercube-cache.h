@@ -0,0 +1,51 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace Btwxt {
+
+class HypercubeCache {
+    // Gathered hypercube grid point data, keyed by floor grid point index and hypercube size hash.
+    // Entries are added until the memory budget would be exceeded (nothing is evicted). Copies keep
+    // the budget but start empty, so that copies made for evaluation do not duplicate the entries.
+  public:
+    using Key = std::pair<std::size_t, std::size_t>;
+    using Entry = std::vector<std::vector<double>>; // For each vertex, a value for each data set
+
+    HypercubeCache() = default;
+
+    HypercubeCache(const HypercubeCache& source);
+
+    HypercubeCache& operator=(const HypercubeCache& source);
+
+    // Returns the entry, or nullptr
+    [[nodiscard]] const Entry* find(const Key& key) const;
+
+    // Skipped if entry_memory_size (estimated by the caller) would exceed the budget
+    void insert(const Key& key, const Entry& entry, std::size_t entry_memory_size);
+
+    // Removes all entries if they exceed the new budget
+    void set_maximum_memory_size(std::size_t maximum_memory_size_in);
+
+    void clear();
+
+    [[nodiscard]] std::size_t get_memory_size() const { return memory_size; }
+
+    // Estimated, excluding the entry's values
+    static constexpr std::size_t entry_overhead {4u * sizeof(void*) +
+                                                 sizeof(std::map<Key, Entry>::value_type)};
+
+  private:
+    std::map<Key, Entry> entries;
+    std::size_t memory_size {0u}; // Estimated, in bytes
+    std::size_t maximum_memory_size {SIZE_MAX};
+};
+
+} // namespace Btwxt
@@ -2,33 +2,148 @@
  * See the LICENSE file for additional terms and conditions. */
 
 // Standard
+#include <array>
+#include <mutex>
+#include <numeric>
+#include <set>
 #include <sstream>
-#include <unordered_map>
 #include <cassert>
 
 #include <btwxt/btwxt.h>
 
 #include "regular-grid-interpolator-implementation.h"
+#include "trace-scope.h"
 
 namespace Btwxt {
 
+namespace {
+
+template <typename T> std::size_t get_vector_memory_size(const std::vector<T>& vector)
+{
+    return vector.capacity() * sizeof(T);
+}
+
+template <typename T>
+std::size_t get_vector_memory_size(const std::vector<std::vector<T>>& vectors)
+{
+    std::size_t memory_size = vectors.capacity() * sizeof(std::vector<T>);
+    for (const auto& vector : vectors) {
+        memory_size += get_vector_memory_size(vector);
+    }
+    return memory_size;
+}
+
+// Coefficients (constant first) of the cubic polynomial through values at 0, 1/3, 2/3, and 1
+std::array<double, 4> fit_unit_interval_cubic(const std::array<double, 4>& values)
+{
+    // Newton forward differences in t = 3 x
+    const double difference_1 = values[1] - values[0];
+    const double difference_2 = values[2] - 2.0 * values[1] + values[0];
+    const double difference_3 = values[3] - 3.0 * values[2] + 3.0 * values[1] - values[0];
+    return {values[0],
+            3.0 * (difference_1 - difference_2 / 2.0 + difference_3 / 3.0),
+            9.0 * (difference_2 - difference_3) / 2.0,
+            27.0 * difference_3 / 6.0};
+}
+
+double evaluate_polynomial(const std::array<double, 4>& coefficients, double x)
+{
+    return ((coefficients[3] * x + coefficients[2]) * x + coefficients[1]) * x + coefficients[0];
+}
+
+// Real roots of a polynomial of degree three or less within [0, 1], in ascending order. A zero
+// polynomial is reported by the interval end points.
+std::vector<double> get_unit_interval_roots(const std::array<double, 4>& coefficients)
+{
+    const double scale = std::max({std::abs(coefficients[0]),
+                                   std::abs(coefficients[1]),
+                                   std::abs(coefficients[2]),
+                                   std::abs(coefficients[3])});
+    if (scale == 0.0) {
+        return {0.0, 1.0};
+    }
+    constexpr double negligible {1e-12}; // Relative to the largest coefficient
+    const auto [c0, c1, c2, c3] = coefficients;
+    std::vector<double> roots;
+    if (std::abs(c3) > negligible * scale) {
+        // Depressed cubic t^3 + p t + q = 0, where x = t - b / 3
+        const double b = c2 / c3;
+        const double c = c1 / c3;
+        const double d = c0 / c3;
+        const double p = c - b * b / 3.0;
+        const double q = 2.0 * b * b * b / 27.0 - b * c / 3.0 + d;
+        const double discriminant = q * q / 4.0 + p * p * p / 27.0;
+        if (discriminant > 0.0) {
+            const double root = std::sqrt(discriminant);
+            roots.push_back(std::cbrt(-q / 2.0 + root) + std::cbrt(-q / 2.0 - root) - b / 3.0);
+        }
+        else if (p == 0.0) {
+            roots.push_back(std::cbrt(-q) - b / 3.0);
+        }
+        else {
+            const double amplitude = 2.0 * std::sqrt(-p / 3.0);
+            const double angle =
+                std::acos(std::clamp(3.0 * q / (p * amplitude), -1.0, 1.0)) / 3.0;
+            constexpr double pi {3.14159265358979323846};
+            for (int k = 0; k < 3; ++k) {
+                roots.push_back(amplitude * std::cos(angle - 2.0 * pi * k / 3.0) - b / 3.0);
+            }
+        }
+    }
+    else if (std::abs(c2) > negligible * scale) {
+        const double discriminant = c1 * c1 - 4.0 * c2 * c0;
+        if (discriminant >= 0.0) {
+            // Avoids cancellation between -c1 and the square root
+            const double root = -0.5 * (c1 + std::copysign(std::sqrt(discriminant), c1));
+            roots.push_back(root / c2);
+            if (root != 0.0) {
+                roots.push_back(c0 / root);
+            }
+        }
+    }
+    else if (std::abs(c1) > negligible * scale) {
+        roots.push_back(-c0 / c1);
+    }
+
+    // Refined against the full polynomial (including any negligible terms)
+    constexpr double margin {1e-9};
+    std::vector<double> unit_interval_roots;
+    for (double root : roots) {
+        for (int iteration = 0; iteration < 2; ++iteration) {
+            const double slope = (3.0 * c3 * root + 2.0 * c2) * root + c1;
+            if (slope == 0.0) {
+                break;
+            }
+            root -= evaluate_polynomial(coefficients, root) / slope;
+        }
+        if (root >= -margin && root <= 1.0 + margin) {
+            unit_interval_roots.push_back(std::clamp(root, 0.0, 1.0));
+        }
+    }
+    std::sort(unit_interval_roots.begin(), unit_interval_roots.end());
+    return unit_interval_roots;
+}
+
+} // namespace
+
 RegularGridInterpolatorImplementation::RegularGridInterpolatorImplementation(
-    const std::vector<GridAxis>& grid,
+    std::vector<GridAxis> grid,
     std::string name,
     const std::shared_ptr<Courier::Courier>& courier)
-    : RegularGridInterpolatorImplementation(grid, {}, std::move(name), courier)
+    : RegularGridInterpolatorImplementation(std::move(grid), {}, std::move(name), courier)
 {
 }
 
 RegularGridInterpolatorImplementation::RegularGridInterpolatorImplementation(
-    const std::vector<GridAxis>& grid_axes,
-    const std::vector<GridPointDataSet>& grid_point_data_sets,
+    std::vector<GridAxis> grid_axes_in,
+    std::vector<GridPointDataSet> grid_point_data_sets_in,
     std::string name,
     const std::shared_ptr<Courier::Courier>& courier)
     : Courier::Sender(std::move(name), courier)
-    , grid_axes(grid_axes)
-    , grid_point_data_sets(grid_point_data_sets)
-    , number_of_grid_point_data_sets(grid_point_data_sets.size())
+    , grid_axes(std::move(grid_axes_in))
+    , grid_point_data_sets(
+          std::make_shared<std::vector<GridPointDataSet>>(std::move(grid_point_data_sets_in)))
+    , number_of_grid_point_data_sets(grid_point_data_sets->size())
     , number_of_grid_axes(grid_axes.size())
     , grid_axis_lengths(number_of_grid_axes)
     , grid_axis_step_size(number_of_grid_axes)
@@ -56,43 +171,821 @@ RegularGridInterpolatorImplementation::RegularGridInterpolatorImplementation(
     this->set_axes_parent_pointers();
 }
 
-std::size_t RegularGridInterpolatorImplementation::add_grid_point_data_set(
-    const GridPointDataSet& grid_point_data_set)
+std::size_t
+RegularGridInterpolatorImplementation::add_grid_point_data_set(GridPointDataSet grid_point_data_set)
 {
     check_grid_point_data_set_size(grid_point_data_set);
-    grid_point_data_sets.emplace_back(grid_point_data_set);
+    auto& writable_grid_point_data_sets = get_writable_grid_point_data_sets();
+    if (grid_point_data_layout == GridPointDataLayout::row_major) {
+        writable_grid_point_data_sets.push_back(std::move(grid_point_data_set));
+    }
+    else {
+        writable_grid_point_data_sets.emplace_back(
+            arrange_grid_point_data(grid_point_data_set.data), grid_point_data_set.name);
+    }
     number_of_grid_point_data_sets++;
     temporary_grid_point_data.resize(number_of_grid_point_data_sets);
     results.resize(number_of_grid_point_data_sets);
     hypercube_grid_point_data.resize(hypercube.size(),
                                      std::vector<double>(number_of_grid_point_data_sets));
-    hypercube_cache.clear();
+    restore_grid_point_data_compression();
+    clear_caches();
     if (target_is_set) {
         set_results();
     }
     return number_of_grid_point_data_sets - 1; // Returns index of new data set
 }
 
-void RegularGridInterpolatorImplementation::set_target(const std::vector<double>& target_in)
+void RegularGridInterpolatorImplementation::set_grid_point_data_layout(GridPointDataLayout layout,
+                                                                       std::size_t block_length)
 {
-    if (target_in.size() != number_of_grid_axes) {
-        send_error(
-            fmt::format("Target (size={}) and grid (size={}) do not have the same dimensions.",
-                        target_in.size(),
-                        number_of_grid_axes));
+    check_grid_point_data_is_in_memory("set grid point data layout");
+    if (block_length == 0u || (block_length & (block_length - 1u)) != 0u) {
+        send_error(fmt::format(
+            "Grid point data block length ({}) must be a power of two.", block_length));
+    }
+    std::vector<std::vector<double>> row_major_data;
+    row_major_data.reserve(number_of_grid_point_data_sets);
+    for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+         ++data_set_index) {
+        row_major_data.push_back(get_row_major_grid_point_data(data_set_index));
     }
+    grid_point_data_layout = layout;
+    set_grid_point_data_layout_step_sizes(block_length);
+    auto& writable_grid_point_data_sets = get_writable_grid_point_data_sets();
+    for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+         ++data_set_index) {
+        writable_grid_point_data_sets[data_set_index].data =
+            arrange_grid_point_data(row_major_data[data_set_index]);
+    }
+    restore_grid_point_data_compression();
+    clear_caches();
+    floor_grid_point_index = get_grid_point_index(floor_grid_point_coordinates);
+    if (target_is_set) {
+        set_results();
+    }
+}
+
+void RegularGridInterpolatorImplementation::set_grid_point_data_compression(double maximum_error,
+                                                                            std::size_t block_size)
+{
+    check_grid_point_data_is_in_memory("compress grid point data");
+    if (maximum_error < 0.0) {
+        send_error(fmt::format(
+            "Grid point data compression maximum error ({}) must not be negative.", maximum_error));
+    }
+    if (block_size == 0u) {
+        send_error("Grid point data compression block size must be greater than zero.");
+    }
+    if (compressed_grid_point_data) {
+        decompress_grid_point_data();
+    }
+    grid_point_data_maximum_error = maximum_error;
+    grid_point_data_compression_block_size = block_size;
+    compress_grid_point_data();
+    clear_caches();
+    if (target_is_set) {
+        set_results();
+    }
+}
+
+void RegularGridInterpolatorImplementation::clear_grid_point_data_compression()
+{
+    if (compressed_grid_point_data) {
+        decompress_grid_point_data();
+    }
+    grid_point_data_compression_block_size = 0u;
+    clear_caches();
+    if (target_is_set) {
+        set_results();
+    }
+}
+
+void RegularGridInterpolatorImplementation::set_grid_point_data_file(
+    const std::string& path, std::size_t maximum_resident_size)
+{
+    auto paged_grid_point_data_in =
+        std::make_shared<PagedGridPointData>(path, maximum_resident_size, courier);
+    if (paged_grid_point_data_in->get_number_of_grid_points() != number_of_grid_points) {
+        send_error(fmt::format("Grid point data file '{}': Number of grid points ({}) does not "
+                               "match number of grid points ({}).",
+                               path,
+                               paged_grid_point_data_in->get_number_of_grid_points(),
+                               number_of_grid_points));
+    }
+    shared_table.reset();
+    paged_grid_point_data = std::move(paged_grid_point_data_in);
+    paged_block_indices.assign(number_of_paged_block_slots, UINT64_MAX);
+    paged_blocks.assign(number_of_paged_block_slots, nullptr);
+    set_external_grid_point_data_sets(paged_grid_point_data->get_data_set_names());
+}
+
+void RegularGridInterpolatorImplementation::set_external_grid_point_data_sets(
+    const std::vector<std::string>& data_set_names)
+{
+    // Grid point data in memory is replaced. Files and shared tables are in row-major order.
+    compressed_grid_point_data.reset();
+    grid_point_data_compression_block_size = 0u;
+    decoded_block_indices.clear();
+    decoded_blocks.clear();
+    if (grid_point_data_layout != GridPointDataLayout::row_major) {
+        grid_point_data_layout = GridPointDataLayout::row_major;
+        set_grid_point_data_layout_step_sizes(1u);
+        floor_grid_point_index = get_grid_point_index(floor_grid_point_coordinates);
+    }
+    auto data_sets = std::make_shared<std::vector<GridPointDataSet>>();
+    for (const auto& data_set_name : data_set_names) {
+        data_sets->emplace_back(std::vector<double>(), data_set_name);
+    }
+    grid_point_data_sets = std::move(data_sets);
+    number_of_grid_point_data_sets = grid_point_data_sets->size();
+    temporary_grid_point_data.resize(number_of_grid_point_data_sets);
+    results.resize(number_of_grid_point_data_sets);
+    hypercube_grid_point_data.resize(hypercube.size(),
+                                     std::vector<double>(number_of_grid_point_data_sets));
+    clear_caches();
     if (target_is_set) {
+        set_results();
+    }
+}
+
+void RegularGridInterpolatorImplementation::publish_shared_table(const std::string& table_name,
+                                                                 SharedTableStorage storage) const
+{
+    std::vector<std::string> data_set_names;
+    for (const auto& grid_point_data_set : *grid_point_data_sets) {
+        data_set_names.push_back(grid_point_data_set.name);
+    }
+    write_shared_table(
+        table_name,
+        storage,
+        grid_axes,
+        data_set_names,
+        number_of_grid_points,
+        [this](std::size_t data_set_index) {
+            return get_row_major_grid_point_data(data_set_index);
+        },
+        courier);
+}
+
+void RegularGridInterpolatorImplementation::set_shared_table(
+    std::shared_ptr<const SharedTable> shared_table_in)
+{
+    if (shared_table_in->get_number_of_grid_points() != number_of_grid_points) {
+        send_error(fmt::format("Shared table '{}': Number of grid points ({}) does not match "
+                               "number of grid points ({}).",
+                               shared_table_in->name,
+                               shared_table_in->get_number_of_grid_points(),
+                               number_of_grid_points));
+    }
+    paged_grid_point_data.reset();
+    paged_block_indices.clear();
+    paged_blocks.clear();
+    shared_table = std::move(shared_table_in);
+    set_external_grid_point_data_sets(shared_table->get_data_set_names());
+}
+
+GridPointDataPagingStatistics
+RegularGridInterpolatorImplementation::get_grid_point_data_paging_statistics() const
+{
+    if (!paged_grid_point_data) {
+        return {};
+    }
+    return paged_grid_point_data->get_statistics();
+}
+
+std::unique_ptr<RegularGridInterpolatorImplementation>
+RegularGridInterpolatorImplementation::get_reduced_interpolator(
+    const std::map<std::size_t, double>& fixed_axis_values) const
+{
+    for (const auto& fixed_axis_value : fixed_axis_values) {
+        check_axis_index(fixed_axis_value.first, "fix axis value");
+    }
+    if (fixed_axis_values.size() == number_of_grid_axes) {
+        send_error("Cannot reduce interpolator. At least one axis must not be fixed.");
+    }
+    if (get_number_of_simplex_axes() > 1u) {
+        for (const auto& fixed_axis_value : fixed_axis_values) {
+            if (get_axis_interpolation_method(fixed_axis_value.first) == Method::simplex) {
+                send_error(fmt::format("Cannot reduce interpolator. Axis {} is interpolated with "
+                                       "simplex along with other axes.",
+                                       fixed_axis_value.first));
+            }
+        }
+    }
+
+    // Weights along each fixed axis are calculated as if the fixed value were part of a target (by
+    // a copy, which starts with empty caches)
+    RegularGridInterpolatorImplementation evaluator(*this);
+    evaluator.target_is_set = true;
+    std::vector<GridAxis> free_grid_axes;
+    std::map<std::size_t, AxisWeights> fixed_axis_weights;
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        auto fixed_axis_value = fixed_axis_values.find(axis_index);
+        if (fixed_axis_value == fixed_axis_values.end()) {
+            free_grid_axes.push_back(grid_axes[axis_index]);
+            continue;
+        }
+        fixed_axis_weights[axis_index] =
+            evaluator.get_axis_weights(axis_index, fixed_axis_value->second);
+    }
+    return std::make_unique<RegularGridInterpolatorImplementation>(
+        std::move(free_grid_axes),
+        evaluator.contract_grid_point_data(fixed_axis_weights),
+        name,
+        courier);
+}
+
+RegularGridInterpolatorImplementation::AxisWeights
+RegularGridInterpolatorImplementation::get_axis_weights(std::size_t axis_index, double axis_value)
+{
+    // Only grid point coordinates with nonzero weights are kept
+    target[axis_index] = axis_value;
+    set_axis_floor_grid_point_index(axis_index);
+    calculate_axis_floor_to_ceiling_fraction(axis_index);
+    consolidate_axis_method(axis_index);
+    calculate_axis_interpolation_coefficients(axis_index);
+    AxisWeights axis_weights;
+    const int floor = static_cast<int>(floor_grid_point_coordinates[axis_index]);
+    const int length = static_cast<int>(grid_axis_lengths[axis_index]);
+    for (int offset = -1; offset <= 2; ++offset) {
+        double weighting_factor = weighting_factors[axis_index][offset + 1];
+        if (weighting_factor != 0.0) {
+            axis_weights.emplace_back(std::clamp(floor + offset, 0, length - 1), weighting_factor);
+        }
+    }
+    return axis_weights;
+}
+
+RegularGridInterpolatorImplementation::AxisWeights
+RegularGridInterpolatorImplementation::get_axis_integral_weights(std::size_t axis_index,
+                                                                 std::pair<double, double> range)
+{
+    // Between grid axis values (and beyond the ends of the axis), the weights of each grid point
+    // are polynomials of at most third degree, which two-point Gauss-Legendre quadrature
+    // integrates exactly
+    const auto [lower_bound, upper_bound] = std::minmax(range.first, range.second);
+    const double sign = range.first <= range.second ? 1.0 : -1.0;
+    std::vector<double> breakpoints {lower_bound};
+    for (double axis_value : grid_axes[axis_index].get_values()) {
+        if (axis_value > lower_bound && axis_value < upper_bound) {
+            breakpoints.push_back(axis_value);
+        }
+    }
+    breakpoints.push_back(upper_bound);
+    const double node_offset = 1.0 / std::sqrt(3.0);
+    std::vector<double> grid_point_weights(grid_axis_lengths[axis_index], 0.0);
+    for (std::size_t segment_index = 0; segment_index + 1u < breakpoints.size(); ++segment_index) {
+        const double half_width =
+            0.5 * (breakpoints[segment_index + 1u] - breakpoints[segment_index]);
+        const double midpoint = breakpoints[segment_index] + half_width;
+        for (double node :
+             {midpoint - half_width * node_offset, midpoint + half_width * node_offset}) {
+            for (const auto& [coordinate, weighting_factor] : get_axis_weights(axis_index, node)) {
+                grid_point_weights[coordinate] += sign * half_width * weighting_factor;
+            }
+        }
+    }
+    AxisWeights axis_weights;
+    for (std::size_t coordinate = 0; coordinate < grid_point_weights.size(); ++coordinate) {
+        if (grid_point_weights[coordinate] != 0.0) {
+            axis_weights.emplace_back(coordinate, grid_point_weights[coordinate]);
+        }
+    }
+    return axis_weights;
+}
+
+std::vector<GridPointDataSet> RegularGridInterpolatorImplementation::contract_grid_point_data(
+    const std::map<std::size_t, AxisWeights>& contracted_axis_weights)
+{
+    std::vector<std::size_t> free_axis_indices;
+    std::vector<std::size_t> contracted_axis_indices;
+    std::vector<const AxisWeights*> axis_weights;
+    std::size_t number_of_free_grid_points = 1u;
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        auto contracted_axis = contracted_axis_weights.find(axis_index);
+        if (contracted_axis == contracted_axis_weights.end()) {
+            free_axis_indices.push_back(axis_index);
+            number_of_free_grid_points *= grid_axis_lengths[axis_index];
+            continue;
+        }
+        contracted_axis_indices.push_back(axis_index);
+        axis_weights.push_back(&contracted_axis->second);
+    }
+    std::vector<GridPointDataSet> contracted_grid_point_data_sets;
+    contracted_grid_point_data_sets.reserve(number_of_grid_point_data_sets);
+    for (const auto& grid_point_data_set : *grid_point_data_sets) {
+        contracted_grid_point_data_sets.emplace_back(
+            std::vector<double>(number_of_free_grid_points, 0.0), grid_point_data_set.name);
+    }
+    for (const auto* weights : axis_weights) {
+        if (weights->empty()) {
+            return contracted_grid_point_data_sets; // Every weight is zero
+        }
+    }
+
+    // For each grid point of the free axes (in row-major order), sum the weighted grid point data
+    // of every combination of contracted axis coordinates
+    std::vector<std::size_t> coordinates(number_of_grid_axes, 0u);
+    std::vector<std::size_t> weight_indices(contracted_axis_indices.size());
+    for (std::size_t contracted_index = 0; contracted_index < number_of_free_grid_points;
+         ++contracted_index) {
+        std::fill(weight_indices.begin(), weight_indices.end(), 0u);
+        bool combinations_remaining = true;
+        while (combinations_remaining) {
+            double weighting_factor = 1.0;
+            for (std::size_t index = 0; index < contracted_axis_indices.size(); ++index) {
+                const auto& coordinate_weight = (*axis_weights[index])[weight_indices[index]];
+                coordinates[contracted_axis_indices[index]] = coordinate_weight.first;
+                weighting_factor *= coordinate_weight.second;
+            }
+            const auto& grid_point_data = get_grid_point_data(coordinates);
+            for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+                 ++data_set_index) {
+                contracted_grid_point_data_sets[data_set_index].data[contracted_index] +=
+                    weighting_factor * grid_point_data[data_set_index];
+            }
+            combinations_remaining = false;
+            for (std::size_t index = contracted_axis_indices.size(); index-- > 0;) {
+                if (++weight_indices[index] < axis_weights[index]->size()) {
+                    combinations_remaining = true;
+                    break;
+                }
+                weight_indices[index] = 0u;
+            }
+        }
+        for (std::size_t free_index = free_axis_indices.size(); free_index-- > 0;) {
+            std::size_t axis_index = free_axis_indices[free_index];
+            if (++coordinates[axis_index] < grid_axis_lengths[axis_index]) {
+                break;
+            }
+            coordinates[axis_index] = 0u;
+        }
+    }
+    return contracted_grid_point_data_sets;
+}
+
+std::vector<double> RegularGridInterpolatorImplementation::integrate(
+    const std::vector<double>& target_in,
+    const std::map<std::size_t, std::pair<double, double>>& axis_ranges,
+    bool average) const
+{
+    check_target_size(target_in.size());
+    for (const auto& [axis_index, range] : axis_ranges) {
+        check_axis_index(axis_index, "integrate");
+        const auto limits = get_extrapolation_limits(axis_index);
+        if (std::min(range.first, range.second) < limits.first ||
+            std::max(range.first, range.second) > limits.second) {
+            send_error(fmt::format("Cannot integrate. The range ({:.6g}, {:.6g}) of axis {} "
+                                   "extends beyond its extrapolation limits ({:.6g}, {:.6g}).",
+                                   range.first,
+                                   range.second,
+                                   axis_index,
+                                   limits.first,
+                                   limits.second));
+        }
+    }
+    if (get_number_of_simplex_axes() > 1u) {
+        send_error("Cannot integrate. More than one axis is interpolated with simplex.");
+    }
+    if (number_of_grid_point_data_sets == 0u) {
+        send_error("There are no grid point data sets. No results returned.");
+    }
+
+    // Every axis is contracted: integrated axes with the integrals of their weights (divided by
+    // the width of the range for averages), and other axes with their weights at the target. The
+    // weights are calculated by a copy, which starts with empty caches, so the cost of a call does
+    // not grow with the cells already evaluated.
+    RegularGridInterpolatorImplementation evaluator(*this);
+    evaluator.target_is_set = true;
+    std::map<std::size_t, AxisWeights> axis_weights;
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        auto axis_range = axis_ranges.find(axis_index);
+        if (axis_range == axis_ranges.end()) {
+            axis_weights[axis_index] =
+                evaluator.get_axis_weights(axis_index, target_in[axis_index]);
+            continue;
+        }
+        const auto [first, last] = axis_range->second;
+        if (average && first == last) {
+            axis_weights[axis_index] = evaluator.get_axis_weights(axis_index, first);
+            continue;
+        }
+        axis_weights[axis_index] = evaluator.get_axis_integral_weights(axis_index, {first, last});
+        if (average) {
+            for (auto& coordinate_weight : axis_weights[axis_index]) {
+                coordinate_weight.second /= last - first;
+            }
+        }
+    }
+    std::vector<double> results;
+    for (const auto& grid_point_data_set : evaluator.contract_grid_point_data(axis_weights)) {
+        results.push_back(grid_point_data_set.data[0]);
+    }
+    return results;
+}
+
+InverseSolution
+RegularGridInterpolatorImplementation::solve_for_axis_value(const std::vector<double>& target_in,
+                                                            std::size_t axis_index,
+                                                            std::size_t data_set_index,
+                                                            double result) const
+{
+    check_target_size(target_in.size());
+    check_axis_index(axis_index, "solve for axis value");
+    check_data_set_index(data_set_index, "solve for axis value");
+    if (get_number_of_simplex_axes() > 1u) {
+        send_error("Cannot solve for axis value. More than one axis is interpolated with simplex.");
+    }
+    std::map<std::size_t, double> fixed_axis_values;
+    for (std::size_t fixed_axis_index = 0; fixed_axis_index < number_of_grid_axes;
+         ++fixed_axis_index) {
+        if (fixed_axis_index != axis_index) {
+            fixed_axis_values[fixed_axis_index] = target_in[fixed_axis_index];
+        }
+    }
+    auto curve = get_reduced_interpolator(fixed_axis_values);
+    auto evaluate = [&](double axis_value) {
+        return curve->get_results(std::vector<double> {axis_value})[data_set_index];
+    };
+
+    InverseSolution solution;
+    int direction = 0; // Sign of the last nonzero change in result along the axis
+    auto add_change = [&](double change) {
+        const int change_direction = (change > 0.0) - (change < 0.0);
+        if (change_direction != 0) {
+            solution.is_monotonic &= direction == 0 || change_direction == direction;
+            direction = change_direction;
+        }
+    };
+    auto add_solution = [&](double axis_value) {
+        // Roots at a shared cell boundary are found from both cells
+        if (solution.axis_values.empty() ||
+            axis_value - solution.axis_values.back() >
+                1e-12 * std::max(1.0, std::abs(axis_value))) {
+            solution.axis_values.push_back(axis_value);
+        }
+    };
+
+    const auto& grid_axis = grid_axes[axis_index];
+    const auto& axis_values = grid_axis.get_values();
+    const auto limits = grid_axis.get_extrapolation_limits();
+    const std::size_t length = axis_values.size();
+    const bool linear_extrapolation = length > 1u && grid_axis.get_extrapolation_method() ==
+                                                         ExtrapolationMethod::linear;
+    auto solve_extrapolation = [&](double edge_value, double probe_value, double limit) {
+        // The curve is linear from the edge to the limit (probe_value lies between them)
+        const double edge_result = evaluate(edge_value);
+        const double slope = (evaluate(probe_value) - edge_result) / (probe_value - edge_value);
+        add_change(probe_value > edge_value ? slope : -slope);
+        if (slope != 0.0) {
+            const double axis_value = edge_value + (result - edge_result) / slope;
+            if ((axis_value - edge_value) * (limit - edge_value) > 0.0 &&
+                std::abs(axis_value - edge_value) <= std::abs(limit - edge_value)) {
+                add_solution(axis_value);
+            }
+        }
+    };
+
+    if (length == 1u) {
+        if (evaluate(axis_values[0]) == result) {
+            add_solution(axis_values[0]);
+        }
+    }
+    if (linear_extrapolation && limits.first < axis_values.front()) {
+        solve_extrapolation(axis_values.front(),
+                            std::max(limits.first, 2.0 * axis_values[0] - axis_values[1]),
+                            limits.first);
+    }
+    const bool cubic = grid_axis.get_interpolation_method() == InterpolationMethod::cubic;
+    for (std::size_t floor = 0; floor + 1u < length; ++floor) {
+        const double floor_value = axis_values[floor];
+        const double spacing = axis_values[floor + 1u] - floor_value;
+        std::array<double, 4> coefficients;
+        if (cubic) {
+            std::array<double, 4> cell_results;
+            for (std::size_t point = 0; point < 4u; ++point) {
+                cell_results[point] = evaluate(point == 3u ? axis_values[floor + 1u]
+                                                           : floor_value + spacing * point / 3.0);
+            }
+            coefficients = fit_unit_interval_cubic(cell_results);
+        }
+        else {
+            const double floor_result = evaluate(floor_value);
+            const double ceiling_result = evaluate(axis_values[floor + 1u]);
+            coefficients = {floor_result, ceiling_result - floor_result, 0.0, 0.0};
+        }
+
+        // Changes between the cell ends and any extrema within the cell (the roots of the
+        // derivative, which is linear when the cell is quadratic)
+        std::vector<double> fractions {0.0};
+        for (double fraction : get_unit_interval_roots(
+                 {coefficients[1], 2.0 * coefficients[2], 3.0 * coefficients[3], 0.0})) {
+            if (fraction > fractions.back() && fraction < 1.0) {
+                fractions.push_back(fraction);
+            }
+        }
+        fractions.push_back(1.0);
+        for (std::size_t index = 1; index < fractions.size(); ++index) {
+            add_change(evaluate_polynomial(coefficients, fractions[index]) -
+                       evaluate_polynomial(coefficients, fractions[index - 1]));
+        }
+
+        coefficients[0] -= result;
+        for (double fraction : get_unit_interval_roots(coefficients)) {
+            add_solution(floor_value + fraction * spacing);
+        }
+    }
+    if (linear_extrapolation && limits.second > axis_values.back()) {
+        solve_extrapolation(
+            axis_values.back(),
+            std::min(limits.second, 2.0 * axis_values[length - 1u] - axis_values[length - 2u]),
+            limits.second);
+    }
+
+    solution.status = solution.axis_values.empty()         ? InverseSolutionStatus::none
+                      : solution.axis_values.size() == 1u ? InverseSolutionStatus::unique
+                                                          : InverseSolutionStatus::multiple;
+    return solution;
+}
+
+std::unique_ptr<RegularGridInterpolatorImplementation>
+RegularGridInterpolatorImplementation::get_coarsened_interpolator(
+    double tolerance, std::vector<double>& maximum_errors) const
+{
+    if (tolerance < 0.0) {
+        send_error(fmt::format("Cannot coarsen grid. Tolerance ({}) must not be negative.",
+                               tolerance));
+    }
+    std::vector<std::vector<double>> row_major_data;
+    row_major_data.reserve(number_of_grid_point_data_sets);
+    for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+         ++data_set_index) {
+        row_major_data.push_back(get_row_major_grid_point_data(data_set_index));
+    }
+    std::vector<std::vector<std::size_t>> all_coordinates(number_of_grid_axes);
+    std::vector<std::pair<std::size_t, std::size_t>> all_coordinate_ranges(number_of_grid_axes);
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        all_coordinates[axis_index].resize(grid_axis_lengths[axis_index]);
+        std::iota(all_coordinates[axis_index].begin(), all_coordinates[axis_index].end(), 0u);
+        all_coordinate_ranges[axis_index] = {0u, grid_axis_lengths[axis_index] - 1u};
+    }
+
+    // Axis points are removed greedily, one axis at a time, while interpolating along that axis
+    // from the remaining points reproduces the grid point data within the axis's share of the
+    // tolerance. Errors along different axes (approximately) add, so the result is checked at
+    // every grid point, and the shares are reduced if the tolerance is exceeded.
+    static constexpr std::size_t maximum_number_of_attempts {8u};
+    double axis_tolerance = tolerance / static_cast<double>(number_of_grid_axes);
+    for (std::size_t attempt = 0; attempt < maximum_number_of_attempts; ++attempt) {
+        std::vector<std::vector<std::size_t>> kept_coordinates = all_coordinates;
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+            auto& axis_coordinates = kept_coordinates[axis_index];
+            std::vector<std::vector<std::size_t>> trial_coordinates = all_coordinates;
+            std::vector<std::pair<std::size_t, std::size_t>> coordinate_ranges =
+                all_coordinate_ranges;
+            std::size_t position = 1u;
+            while (position + 1u < axis_coordinates.size()) {
+                auto& trial_axis_coordinates = trial_coordinates[axis_index];
+                trial_axis_coordinates = axis_coordinates;
+                trial_axis_coordinates.erase(trial_axis_coordinates.begin() +
+                                             static_cast<std::ptrdiff_t>(position));
+                // Cubic interpolation uses up to two remaining points on each side
+                coordinate_ranges[axis_index] = {
+                    trial_axis_coordinates[position >= 2u ? position - 2u : 0u],
+                    trial_axis_coordinates[std::min(position + 1u,
+                                                    trial_axis_coordinates.size() - 1u)]};
+                auto trial_interpolator =
+                    get_subgrid_interpolator(trial_coordinates, row_major_data);
+                auto errors = get_subgrid_interpolator_errors(
+                    trial_interpolator, row_major_data, coordinate_ranges);
+                if (std::all_of(errors.begin(), errors.end(), [axis_tolerance](double error) {
+                        return error <= axis_tolerance;
+                    })) {
+                    axis_coordinates = trial_axis_coordinates;
+                }
+                else {
+                    ++position;
+                }
+            }
+        }
+        auto coarsened_interpolator = get_subgrid_interpolator(kept_coordinates, row_major_data);
+        maximum_errors = get_subgrid_interpolator_errors(
+            coarsened_interpolator, row_major_data, all_coordinate_ranges);
+        if (std::all_of(maximum_errors.begin(), maximum_errors.end(), [tolerance](double error) {
+                return error <= tolerance;
+            })) {
+            return std::make_unique<RegularGridInterpolatorImplementation>(coarsened_interpolator);
+        }
+        axis_tolerance *= 0.5;
+    }
+    maximum_errors.assign(number_of_grid_point_data_sets, 0.0);
+    return std::make_unique<RegularGridInterpolatorImplementation>(
+        get_subgrid_interpolator(all_coordinates, row_major_data));
+}
+
+RegularGridInterpolatorImplementation
+RegularGridInterpolatorImplementation::get_subgrid_interpolator(
+    const std::vector<std::vector<std::size_t>>& axis_coordinates,
+    const std::vector<std::vector<double>>& row_major_data) const
+{
+    std::vector<GridAxis> subgrid_axes;
+    std::size_t number_of_subgrid_points = 1u;
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        const auto& grid_axis = grid_axes[axis_index];
+        std::vector<double> values;
+        values.reserve(axis_coordinates[axis_index].size());
+        for (auto coordinate : axis_coordinates[axis_index]) {
+            values.push_back(grid_axis.values[coordinate]);
+        }
+        subgrid_axes.emplace_back(std::move(values),
+                                  grid_axis.get_interpolation_method(),
+                                  grid_axis.get_extrapolation_method(),
+                                  grid_axis.get_extrapolation_limits(),
+                                  grid_axis.name,
+                                  courier);
+        number_of_subgrid_points *= axis_coordinates[axis_index].size();
+    }
+
+    std::vector<GridPointDataSet> subgrid_data_sets;
+    subgrid_data_sets.reserve(number_of_grid_point_data_sets);
+    for (const auto& grid_point_data_set : *grid_point_data_sets) {
+        subgrid_data_sets.emplace_back(std::vector<double>(), grid_point_data_set.name);
+        subgrid_data_sets.back().data.reserve(number_of_subgrid_points);
+    }
+    std::vector<std::size_t> subgrid_coordinates(number_of_grid_axes, 0u);
+    for (std::size_t subgrid_index = 0; subgrid_index < number_of_subgrid_points;
+         ++subgrid_index) {
+        std::size_t grid_point_index = 0u;
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+            grid_point_index = grid_point_index * grid_axis_lengths[axis_index] +
+                               axis_coordinates[axis_index][subgrid_coordinates[axis_index]];
+        }
+        for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+             ++data_set_index) {
+            subgrid_data_sets[data_set_index].data.push_back(
+                row_major_data[data_set_index][grid_point_index]);
+        }
+        for (std::size_t axis_index = number_of_grid_axes; axis_index-- > 0;) {
+            if (++subgrid_coordinates[axis_index] < axis_coordinates[axis_index].size()) {
+                break;
+            }
+            subgrid_coordinates[axis_index] = 0u;
+        }
+    }
+    return RegularGridInterpolatorImplementation(
+        std::move(subgrid_axes), std::move(subgrid_data_sets), name, courier);
+}
+
+std::vector<double> RegularGridInterpolatorImplementation::get_subgrid_interpolator_errors(
+    RegularGridInterpolatorImplementation& subgrid_interpolator,
+    const std::vector<std::vector<double>>& row_major_data,
+    const std::vector<std::pair<std::size_t, std::size_t>>& coordinate_ranges) const
+{
+    std::vector<double> errors(number_of_grid_point_data_sets, 0.0);
+    std::vector<std::size_t> coordinates(number_of_grid_axes);
+    std::vector<double> grid_point(number_of_grid_axes);
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        coordinates[axis_index] = coordinate_ranges[axis_index].first;
+    }
+    bool grid_points_remaining = true;
+    while (grid_points_remaining) {
+        std::size_t grid_point_index = 0u;
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+            grid_point[axis_index] = grid_axes[axis_index].values[coordinates[axis_index]];
+            grid_point_index = grid_point_index * grid_axis_lengths[axis_index] +
+                               coordinates[axis_index];
+        }
+        subgrid_interpolator.set_target(grid_point);
+        const auto& subgrid_results = subgrid_interpolator.get_results();
+        for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+             ++data_set_index) {
+            errors[data_set_index] =
+                std::max(errors[data_set_index],
+                         std::abs(subgrid_results[data_set_index] -
+                                  row_major_data[data_set_index][grid_point_index]));
+        }
+        grid_points_remaining = false;
+        for (std::size_t axis_index = number_of_grid_axes; axis_index-- > 0;) {
+            if (++coordinates[axis_index] <= coordinate_ranges[axis_index].second) {
+                grid_points_remaining = true;
+                break;
+            }
+            coordinates[axis_index] = coordinate_ranges[axis_index].first;
+        }
+    }
+    return errors;
+}
+
+void RegularGridInterpolatorImplementation::set_target(const std::vector<double>& target_in)
+{
+    set_target(target_in, true);
+}
+
+void RegularGridInterpolatorImplementation::set_target(const std::vector<double>& target_in,
+                                                       bool use_inexact_result_cache)
+{
+    check_target_size(target_in.size());
+    if (target_is_set && !axis_settings_changed) {
         if ((target_in == target) && (methods == get_interpolation_methods())) {
             return;
         }
     }
     target = target_in;
     target_is_set = true;
+    if (axis_settings_changed) {
+        result_cache.clear();
+        axis_settings_changed = false;
+    }
+    const bool use_result_cache =
+        result_cache.is_enabled() && (use_inexact_result_cache || result_cache.is_exact());
+    target_state_is_stale = false;
     set_floor_grid_point_coordinates();
+    if (use_result_cache && !is_beyond_extrapolation_limits()) {
+        // The bounds are those of this target (not of the target that filled the entry), and
+        // targets beyond the extrapolation limits are evaluated to send their errors
+        if (const auto* entry = result_cache.find(target)) {
+            results = entry->results;
+            target_state_is_stale = true;
+            return;
+        }
+    }
     calculate_floor_to_ceiling_fractions();
     consolidate_methods();
     calculate_interpolation_coefficients();
+    set_hypercube();
     set_results();
+    if (use_result_cache) {
+        result_cache.insert(target, results);
+    }
+}
+
+bool RegularGridInterpolatorImplementation::is_beyond_extrapolation_limits() const
+{
+    return std::any_of(target_bounds_status.begin(),
+                       target_bounds_status.end(),
+                       [](TargetBoundsStatus status) {
+                           return status == TargetBoundsStatus::below_lower_extrapolation_limit ||
+                                  status == TargetBoundsStatus::above_upper_extrapolation_limit;
+                       });
+}
+
+void RegularGridInterpolatorImplementation::set_target_axis(std::size_t axis_index, double value)
+{
+    check_axis_index(axis_index, "set target axis value");
+    if (!target_is_set || axis_settings_changed || get_number_of_simplex_axes() > 1u) {
+        // Every axis needs to be (re)calculated (simplex weights do not separate by axis)
+        if (!target_is_set) {
+            send_error("Cannot set a single target axis value. No target has been set.");
+        }
+        std::vector<double> target_in = target;
+        target_in[axis_index] = value;
+        set_target(target_in);
+        return;
+    }
+    if (value == target[axis_index]) {
+        return;
+    }
+    update_target_state();
+    target[axis_index] = value;
+    {
+        BTWXT_TRACE_SCOPE(TraceStage::floor_search);
+        set_axis_floor_grid_point_index(axis_index);
+        floor_grid_point_index = get_grid_point_index(floor_grid_point_coordinates);
+    }
+    {
+        BTWXT_TRACE_SCOPE(TraceStage::fractions);
+        calculate_axis_floor_to_ceiling_fraction(axis_index);
+    }
+    {
+        BTWXT_TRACE_SCOPE(TraceStage::consolidate_methods);
+        consolidate_axis_method(axis_index);
+    }
+    {
+        BTWXT_TRACE_SCOPE(TraceStage::coefficients);
+        calculate_axis_interpolation_coefficients(axis_index);
+    }
+    set_hypercube();
+
+    // Only the weights along this axis have changed. When the same hypercube is still gathered, the
+    // contributions of each vertex offset along this axis (summed over all other axes) are reused.
+    set_hypercube_grid_point_data();
+    BTWXT_TRACE_SCOPE(TraceStage::reduction);
+    if (partial_results_axis != axis_index) {
+        set_partial_results(axis_index);
+    }
+    std::fill(results.begin(), results.end(), 0.0);
+    for (std::size_t offset_index = 0; offset_index < 4; ++offset_index) {
+        double weighting_factor = weighting_factors[axis_index][offset_index];
+        if (weighting_factor == 0.0) {
+            continue;
+        }
+        for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+             ++data_set_index) {
+            results[data_set_index] +=
+                partial_results[offset_index][data_set_index] * weighting_factor;
+        }
+    }
 }
 
 const std::vector<double>& RegularGridInterpolatorImplementation::get_target() const
@@ -128,6 +1021,201 @@ RegularGridInterpolatorImplementation::get_results(const std::vector<double>& ta
     return get_results();
 }
 
+std::vector<std::vector<double>> RegularGridInterpolatorImplementation::get_results(
+    const std::vector<std::vector<double>>& targets, const TaskExecutor& executor)
+{
+    std::vector<double> flattened_targets;
+    flattened_targets.reserve(targets.size() * number_of_grid_axes);
+    for (const auto& target_in : targets) {
+        check_target_size(target_in.size());
+        flattened_targets.insert(flattened_targets.end(), target_in.begin(), target_in.end());
+    }
+    std::vector<double> flattened_results(targets.size() * number_of_grid_point_data_sets);
+    get_results(flattened_targets.data(), targets.size(), flattened_results.data(), executor);
+
+    std::vector<std::vector<double>> batch_results(targets.size());
+    for (std::size_t target_index = 0; target_index < targets.size(); ++target_index) {
+        auto begin = flattened_results.begin() +
+                     static_cast<std::ptrdiff_t>(target_index * number_of_grid_point_data_sets);
+        batch_results[target_index].assign(
+            begin, begin + static_cast<std::ptrdiff_t>(number_of_grid_point_data_sets));
+    }
+    return batch_results;
+}
+
+void RegularGridInterpolatorImplementation::get_results(const double* targets,
+                                                        std::size_t number_of_targets,
+                                                        double* results_out,
+                                                        const TaskExecutor& executor)
+{
+    if (number_of_grid_point_data_sets == 0u) {
+        send_error("There are no grid point data sets. No results returned.");
+    }
+    static constexpr std::size_t maximum_number_of_tasks {1024u};
+    std::size_t number_of_tasks =
+        executor ? std::min(number_of_targets / minimum_targets_per_task, maximum_number_of_tasks)
+                 : 1u;
+    if (number_of_tasks <= 1u) {
+        evaluate_targets(targets, number_of_targets, results_out);
+        return;
+    }
+    std::size_t targets_per_task = (number_of_targets + number_of_tasks - 1) / number_of_tasks;
+
+    // Tasks evaluate with copies of this interpolator (evaluators), which share its grid point
+    // data. An evaluator is used by one task at a time and is reused by later tasks, so no more
+    // evaluators are created than there are concurrent tasks. Evaluators start with empty caches,
+    // and idle evaluators hold no paged blocks (so only running tasks add to the resident size).
+    std::mutex evaluators_mutex;
+    std::vector<std::unique_ptr<RegularGridInterpolatorImplementation>> idle_evaluators;
+    executor(number_of_tasks, [&](std::size_t task_index) {
+        std::size_t begin = task_index * targets_per_task;
+        std::size_t end = std::min(begin + targets_per_task, number_of_targets);
+        if (begin >= end) {
+            return;
+        }
+        std::unique_ptr<RegularGridInterpolatorImplementation> evaluator;
+        {
+            std::lock_guard<std::mutex> lock(evaluators_mutex);
+            if (!idle_evaluators.empty()) {
+                evaluator = std::move(idle_evaluators.back());
+                idle_evaluators.pop_back();
+            }
+        }
+        if (!evaluator) {
+            evaluator = std::make_unique<RegularGridInterpolatorImplementation>(*this);
+        }
+        evaluator->evaluate_targets(targets + begin * number_of_grid_axes,
+                                    end - begin,
+                                    results_out + begin * number_of_grid_point_data_sets);
+        if (paged_grid_point_data) {
+            evaluator->release_paged_blocks();
+        }
+        std::lock_guard<std::mutex> lock(evaluators_mutex);
+        idle_evaluators.push_back(std::move(evaluator));
+    });
+}
+
+void RegularGridInterpolatorImplementation::enable_result_cache(double tolerance,
+                                                                std::size_t maximum_memory_size)
+{
+    if (tolerance < 0.0) {
+        send_error(fmt::format("Result cache tolerance ({}) must not be negative.", tolerance));
+    }
+    result_cache.enable(tolerance, maximum_memory_size);
+}
+
+void RegularGridInterpolatorImplementation::set_hypercube_cache_memory_budget(
+    std::size_t maximum_memory_size)
+{
+    hypercube_cache.set_maximum_memory_size(maximum_memory_size);
+}
+
+void RegularGridInterpolatorImplementation::enable_shared_hypercube_cache(
+    std::size_t maximum_memory_size)
+{
+    maximum_shared_hypercube_cache_memory_size = maximum_memory_size;
+    reset_shared_hypercube_cache();
+    hypercube_cache.clear();
+}
+
+void RegularGridInterpolatorImplementation::disable_shared_hypercube_cache()
+{
+    shared_hypercube_cache.reset();
+    maximum_shared_hypercube_cache_memory_size = 0u;
+}
+
+MemoryUsage RegularGridInterpolatorImplementation::get_memory_usage() const
+{
+    MemoryUsage memory_usage;
+    for (const auto& grid_axis : grid_axes) {
+        memory_usage.grid_axes += get_vector_memory_size(grid_axis.get_values()) +
+                                  get_vector_memory_size(grid_axis.get_cubic_spacing_ratios(0)) +
+                                  get_vector_memory_size(grid_axis.get_cubic_spacing_ratios(1)) +
+                                  get_vector_memory_size(grid_axis.get_search_tree());
+    }
+    if (compressed_grid_point_data) {
+        memory_usage.grid_point_data = compressed_grid_point_data->get_compressed_size();
+    }
+    else if (shared_table) {
+        memory_usage.grid_point_data = shared_table->get_mapped_size();
+    }
+    else if (paged_grid_point_data) {
+        memory_usage.grid_point_data =
+            paged_grid_point_data->get_statistics().number_of_resident_blocks *
+            paged_grid_point_data->get_block_size() * number_of_grid_point_data_sets *
+            sizeof(double);
+    }
+    else {
+        for (const auto& grid_point_data_set : *grid_point_data_sets) {
+            memory_usage.grid_point_data += get_vector_memory_size(grid_point_data_set.data);
+        }
+    }
+    memory_usage.hypercube_cache =
+        hypercube_cache.get_memory_size() +
+        (shared_hypercube_cache ? shared_hypercube_cache->get_memory_size() : 0u);
+    memory_usage.result_cache = result_cache.get_statistics().memory_size;
+    memory_usage.scratch =
+        get_vector_memory_size(temporary_coordinates) +
+        get_vector_memory_size(temporary_grid_point_data) + get_vector_memory_size(target) +
+        get_vector_memory_size(floor_grid_point_coordinates) +
+        get_vector_memory_size(floor_to_ceiling_fractions) +
+        get_vector_memory_size(target_bounds_status) + get_vector_memory_size(methods) +
+        get_vector_memory_size(hypercube) + get_vector_memory_size(hypercube_axis_vertices) +
+        get_vector_memory_size(weighting_factors) + get_vector_memory_size(results) +
+        get_vector_memory_size(interpolation_coefficients) +
+        get_vector_memory_size(cubic_slope_coefficients) +
+        get_vector_memory_size(hypercube_grid_point_data) +
+        get_vector_memory_size(hypercube_weights) + get_vector_memory_size(partial_results) +
+        get_vector_memory_size(decoded_block_indices) + get_vector_memory_size(decoded_blocks) +
+        get_vector_memory_size(paged_block_indices) + get_vector_memory_size(paged_blocks);
+    return memory_usage;
+}
+
+std::vector<EvaluationCost> RegularGridInterpolatorImplementation::get_evaluation_costs() const
+{
+    // Number of axes using each method (constant, linear, cubic, simplex) for each reachable
+    // combination
+    std::set<std::array<std::size_t, 4>> method_counts {{0u, 0u, 0u, 0u}};
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        std::set<Method> axis_methods;
+        const auto& values = grid_axes[axis_index].get_values();
+        const auto limits = grid_axes[axis_index].get_extrapolation_limits();
+        if (values.size() > 1u) {
+            axis_methods.insert(get_axis_interpolation_method(axis_index));
+        }
+        if (values.size() == 1u || limits.first < values.front() ||
+            limits.second > values.back()) {
+            axis_methods.insert(get_axis_extrapolation_method(axis_index));
+        }
+        std::set<std::array<std::size_t, 4>> axis_method_counts;
+        for (auto counts : method_counts) {
+            for (auto method : axis_methods) {
+                auto axis_counts = counts;
+                ++axis_counts[static_cast<std::size_t>(method) - 1u];
+                axis_method_counts.insert(axis_counts);
+            }
+        }
+        method_counts = std::move(axis_method_counts);
+    }
+
+    std::vector<EvaluationCost> evaluation_costs;
+    for (const auto& counts : method_counts) {
+        EvaluationCost evaluation_cost {counts[0], counts[1], counts[2], counts[3]};
+        evaluation_cost.number_of_vertices =
+            (std::size_t {1u} << (counts[1] + 2u * counts[2])) *
+            (counts[3] > 1u ? counts[3] + 1u : std::size_t {1u} << counts[3]);
+        evaluation_cost.bytes_gathered =
+            evaluation_cost.number_of_vertices * number_of_grid_point_data_sets * sizeof(double);
+        evaluation_costs.push_back(evaluation_cost);
+    }
+    std::stable_sort(evaluation_costs.begin(),
+                     evaluation_costs.end(),
+                     [](const EvaluationCost& a, const EvaluationCost& b) {
+                         return a.number_of_vertices > b.number_of_vertices;
+                     });
+    return evaluation_costs;
+}
+
 void RegularGridInterpolatorImplementation::normalize_grid_point_data_sets_at_target(
     const double scalar)
 {
@@ -138,7 +1226,8 @@ void RegularGridInterpolatorImplementation::normalize_grid_point_data_sets_at_ta
          ++data_set_index) {
         normalize_grid_point_data_set(data_set_index, results[data_set_index] * scalar);
     }
-    hypercube_cache.clear();
+    restore_grid_point_data_compression();
+    clear_caches();
     set_results();
 }
 
@@ -149,13 +1238,14 @@ double RegularGridInterpolatorImplementation::normalize_grid_point_data_set_at_t
     if (!target_is_set) {
         send_error(fmt::format(
             "GridPointDataSet '{}': Cannot normalize grid point data set. No target has been set.",
-            grid_point_data_sets[data_set_index].name));
+            (*grid_point_data_sets)[data_set_index].name));
     }
     // create a scalar which represents the product of the inverted normalization factor and the
     // value in the data set at the independent variable reference value
     double total_scalar = results[data_set_index] * scalar;
     normalize_grid_point_data_set(data_set_index, total_scalar);
-    hypercube_cache.clear();
+    restore_grid_point_data_compression();
+    clear_caches();
     set_results();
 
     return total_scalar;
@@ -165,12 +1255,13 @@ void RegularGridInterpolatorImplementation::normalize_grid_point_data_set(
     std::size_t data_set_index, double scalar)
 {
     check_data_set_index(data_set_index, "normalize grid point data set");
-    auto& data_set = grid_point_data_sets[data_set_index].data;
     if (scalar == 0.0) {
         send_error(
             fmt::format("GridPointDataSet '{}': Attempt to normalize grid point data set by zero.",
-                        grid_point_data_sets[data_set_index].name));
+                        (*grid_point_data_sets)[data_set_index].name));
     }
+    auto& data_set = get_writable_grid_point_data_sets()[data_set_index].data;
+    result_cache.clear();
     scalar = 1.0 / scalar;
     std::transform(data_set.begin(),
                    data_set.end(),
@@ -193,20 +1284,23 @@ std::string RegularGridInterpolatorImplementation::write_data()
 
     for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
          ++data_set_index) {
-        output << grid_point_data_sets[data_set_index].name << ",";
+        output << (*grid_point_data_sets)[data_set_index].name << ",";
     }
     output << std::endl;
 
+    std::vector<std::size_t> coordinates(number_of_grid_axes, 0u);
     for (std::size_t grid_point_index = 0; grid_point_index < number_of_grid_points;
          ++grid_point_index) {
         for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
             output << grid_points[grid_point_index][axis_index] << ",";
         }
+        const auto& grid_point_data = get_grid_point_data(coordinates);
         for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
              ++data_set_index) {
-            output << grid_point_data_sets[data_set_index].data[grid_point_index] << ",";
+            output << grid_point_data[data_set_index] << ",";
         }
         output << std::endl;
+        increment_grid_point_coordinates(coordinates);
     }
     return output.str();
 }
@@ -225,8 +1319,31 @@ void RegularGridInterpolatorImplementation::set_courier(
 const std::vector<double>&
 RegularGridInterpolatorImplementation::get_grid_point_data(std::size_t grid_point_index)
 {
+    if (paged_grid_point_data) {
+        const double* grid_point_data = get_paged_grid_point_data(grid_point_index);
+        std::copy(grid_point_data,
+                  grid_point_data + number_of_grid_point_data_sets,
+                  temporary_grid_point_data.begin());
+        return temporary_grid_point_data;
+    }
+    if (compressed_grid_point_data) {
+        const double* grid_point_data = get_decoded_grid_point_data(grid_point_index);
+        std::copy(grid_point_data,
+                  grid_point_data + number_of_grid_point_data_sets,
+                  temporary_grid_point_data.begin());
+        return temporary_grid_point_data;
+    }
+    if (shared_table) {
+        const double* grid_point_data = shared_table->get_grid_point_values() +
+                                        grid_point_index * number_of_grid_point_data_sets;
+        std::copy(grid_point_data,
+                  grid_point_data + number_of_grid_point_data_sets,
+                  temporary_grid_point_data.begin());
+        return temporary_grid_point_data;
+    }
+    const auto& data_sets = *grid_point_data_sets;
     for (std::size_t i = 0; i < number_of_grid_point_data_sets; ++i) {
-        temporary_grid_point_data[i] = grid_point_data_sets[i].data[grid_point_index];
+        temporary_grid_point_data[i] = data_sets[i].data[grid_point_index];
     }
     return temporary_grid_point_data;
 }
@@ -247,12 +1364,8 @@ std::vector<double> RegularGridInterpolatorImplementation::get_grid_point_data_r
 std::vector<Method> RegularGridInterpolatorImplementation::get_interpolation_methods() const
 {
     std::vector<Method> interpolation_methods(number_of_grid_axes);
-    static const std::unordered_map<InterpolationMethod, Method> interpolation_method_map {
-        {InterpolationMethod::linear, Method::linear}, {InterpolationMethod::cubic, Method::cubic}};
-
     for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
-        interpolation_methods[axis_index] =
-            interpolation_method_map.at(grid_axes[axis_index].get_interpolation_method());
+        interpolation_methods[axis_index] = get_axis_interpolation_method(axis_index);
     }
     return interpolation_methods;
 }
@@ -260,26 +1373,94 @@ std::vector<Method> RegularGridInterpolatorImplementation::get_interpolation_met
 std::vector<Method> RegularGridInterpolatorImplementation::get_extrapolation_methods() const
 {
     std::vector<Method> extrapolation_methods(number_of_grid_axes);
-    static const std::unordered_map<ExtrapolationMethod, Method> extrapolation_method_map {
-        {ExtrapolationMethod::constant, Method::constant},
-        {ExtrapolationMethod::linear, Method::linear}};
     for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
-        extrapolation_methods[axis_index] =
-            extrapolation_method_map.at(grid_axes[axis_index].get_extrapolation_method());
+        extrapolation_methods[axis_index] = get_axis_extrapolation_method(axis_index);
     }
     return extrapolation_methods;
 }
 
+Method RegularGridInterpolatorImplementation::get_axis_interpolation_method(
+    std::size_t axis_index) const
+{
+    switch (grid_axes[axis_index].get_interpolation_method()) {
+    case InterpolationMethod::cubic:
+        return Method::cubic;
+    case InterpolationMethod::simplex:
+        return Method::simplex;
+    case InterpolationMethod::linear:
+    default:
+        return Method::linear;
+    }
+}
+
+Method RegularGridInterpolatorImplementation::get_axis_extrapolation_method(
+    std::size_t axis_index) const
+{
+    switch (grid_axes[axis_index].get_extrapolation_method()) {
+    case ExtrapolationMethod::linear:
+        return Method::linear;
+    case ExtrapolationMethod::constant:
+    default:
+        return Method::constant;
+    }
+}
+
 std::size_t RegularGridInterpolatorImplementation::get_grid_point_index(
     const std::vector<std::size_t>& coords) const
 {
     std::size_t grid_point_index = 0;
+    if (grid_point_data_layout == GridPointDataLayout::row_major) {
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+            grid_point_index += coords[axis_index] * grid_axis_step_size[axis_index];
+        }
+        return grid_point_index;
+    }
+    // Blocked: step sizes of whole blocks already include the block size
     for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
-        grid_point_index += coords[axis_index] * grid_axis_step_size[axis_index];
+        const std::size_t shift = grid_axis_block_shifts[axis_index];
+        const std::size_t mask = (std::size_t {1} << shift) - 1u;
+        grid_point_index += (coords[axis_index] >> shift) * grid_axis_step_size[axis_index] +
+                            (coords[axis_index] & mask) * grid_axis_in_block_step_size[axis_index];
     }
     return grid_point_index;
 }
 
+std::vector<double> RegularGridInterpolatorImplementation::get_row_major_grid_point_data(
+    std::size_t data_set_index) const
+{
+    check_data_set_index(data_set_index, "get row-major grid point data");
+    if (paged_grid_point_data) {
+        return paged_grid_point_data->read_data_set(data_set_index); // Files are row-major
+    }
+    if (shared_table) {
+        std::vector<double> data(number_of_grid_points);
+        const double* grid_point_values = shared_table->get_grid_point_values();
+        for (std::size_t grid_point_index = 0; grid_point_index < number_of_grid_points;
+             ++grid_point_index) {
+            data[grid_point_index] =
+                grid_point_values[grid_point_index * number_of_grid_point_data_sets +
+                                  data_set_index];
+        }
+        return data;
+    }
+    std::vector<double> decoded_data;
+    if (compressed_grid_point_data) {
+        decoded_data = compressed_grid_point_data->decode_data_set(data_set_index);
+    }
+    const auto& data =
+        compressed_grid_point_data ? decoded_data : (*grid_point_data_sets)[data_set_index].data;
+    if (grid_point_data_layout == GridPointDataLayout::row_major) {
+        return data;
+    }
+    std::vector<double> row_major_data(number_of_grid_points);
+    std::vector<std::size_t> coordinates(number_of_grid_axes, 0u);
+    for (auto& value : row_major_data) {
+        value = data[get_grid_point_index(coordinates)];
+        increment_grid_point_coordinates(coordinates);
+    }
+    return row_major_data;
+}
+
 double RegularGridInterpolatorImplementation::get_grid_point_weighting_factor(
     const std::vector<short>& hypercube_indices)
 {
@@ -295,6 +1476,7 @@ std::vector<std::size_t> RegularGridInterpolatorImplementation::get_neighboring_
     if (!target_is_set) {
         send_error("Cannot retrieve neighboring indices. No target has been set.");
     }
+    update_target_state();
     std::vector<std::vector<std::size_t>> axes_neighbor_indices(
         number_of_grid_axes,
         std::vector<std::size_t>()); // For each axis, what are the neighboring indices?
@@ -312,7 +1494,13 @@ std::vector<std::size_t> RegularGridInterpolatorImplementation::get_neighboring_
     std::vector<std::size_t> neighbor_indices;
     neighbor_indices.reserve(axes_neighbor_coordinates.size());
     for (const auto& coordinates : axes_neighbor_coordinates) {
-        neighbor_indices.push_back(get_grid_point_index(coordinates));
+        // Row-major indices (as supplied by the caller), independent of the storage layout
+        std::size_t grid_point_index = 0;
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+            grid_point_index =
+                grid_point_index * grid_axis_lengths[axis_index] + coordinates[axis_index];
+        }
+        neighbor_indices.push_back(grid_point_index);
     }
     return neighbor_indices;
 }
@@ -333,15 +1521,15 @@ void RegularGridInterpolatorImplementation::setup()
         std::size_t length =
             grid_axes[axis_index].get_length(); // length > 0 ensured by GridAxis constructor
         grid_axis_lengths[axis_index] = length;
-        grid_axis_step_size[axis_index] = number_of_grid_points;
         number_of_grid_points *= length;
     }
+    set_grid_point_data_layout_step_sizes(1u);
 
     // set parent interpolator pointer
     set_axes_parent_pointers();
 
     // Check grid point data set sizes
-    for (const auto& grid_point_data_set : grid_point_data_sets) {
+    for (const auto& grid_point_data_set : *grid_point_data_sets) {
         check_grid_point_data_set_size(grid_point_data_set);
     }
 }
@@ -353,6 +1541,212 @@ void RegularGridInterpolatorImplementation::set_axes_parent_pointers()
     }
 }
 
+std::vector<GridPointDataSet>&
+RegularGridInterpolatorImplementation::get_writable_grid_point_data_sets()
+{
+    check_grid_point_data_is_in_memory("modify grid point data");
+    if (compressed_grid_point_data) {
+        // Compressed again (by restore_grid_point_data_compression) once modified
+        decompress_grid_point_data();
+    }
+    // Grid point data is shared between copies of an interpolator until one of them modifies it
+    if (grid_point_data_sets.use_count() > 1) {
+        grid_point_data_sets =
+            std::make_shared<std::vector<GridPointDataSet>>(*grid_point_data_sets);
+    }
+    return *grid_point_data_sets;
+}
+
+void RegularGridInterpolatorImplementation::compress_grid_point_data()
+{
+    compressed_grid_point_data =
+        std::make_shared<const CompressedGridPointData>(*grid_point_data_sets,
+                                                        grid_point_data_maximum_error,
+                                                        grid_point_data_compression_block_size);
+    auto data_set_names = std::make_shared<std::vector<GridPointDataSet>>();
+    data_set_names->reserve(number_of_grid_point_data_sets);
+    for (const auto& grid_point_data_set : *grid_point_data_sets) {
+        data_set_names->emplace_back(std::vector<double>(), grid_point_data_set.name);
+    }
+    grid_point_data_sets = std::move(data_set_names);
+    decoded_block_indices.assign(number_of_decoded_block_slots, SIZE_MAX);
+    decoded_blocks.resize(number_of_decoded_block_slots * grid_point_data_compression_block_size *
+                          number_of_grid_point_data_sets);
+}
+
+void RegularGridInterpolatorImplementation::decompress_grid_point_data()
+{
+    auto grid_point_data_sets_in =
+        std::make_shared<std::vector<GridPointDataSet>>(*grid_point_data_sets);
+    for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+         ++data_set_index) {
+        (*grid_point_data_sets_in)[data_set_index].data =
+            compressed_grid_point_data->decode_data_set(data_set_index);
+    }
+    grid_point_data_sets = std::move(grid_point_data_sets_in);
+    compressed_grid_point_data.reset();
+    decoded_block_indices.clear();
+    decoded_blocks.clear();
+}
+
+void RegularGridInterpolatorImplementation::restore_grid_point_data_compression()
+{
+    if (grid_point_data_compression_block_size > 0u && !compressed_grid_point_data) {
+        compress_grid_point_data();
+    }
+}
+
+const double*
+RegularGridInterpolatorImplementation::get_decoded_grid_point_data(std::size_t grid_point_index)
+{
+    // Blocks are decoded whole into a small, direct-mapped set of slots
+    const std::size_t block_size = grid_point_data_compression_block_size;
+    const std::size_t block_index = grid_point_index / block_size;
+    const std::size_t slot = block_index % number_of_decoded_block_slots;
+    if (decoded_block_indices[slot] != block_index) {
+        compressed_grid_point_data->decode_block(block_index,
+                                                 decoded_blocks.data() +
+                                                     slot * block_size *
+                                                         number_of_grid_point_data_sets);
+        decoded_block_indices[slot] = block_index;
+    }
+    return decoded_blocks.data() +
+           (slot * block_size + grid_point_index % block_size) * number_of_grid_point_data_sets;
+}
+
+const double*
+RegularGridInterpolatorImplementation::get_paged_grid_point_data(std::size_t grid_point_index)
+{
+    // Blocks in use are held in a small, direct-mapped set of slots
+    const std::uint64_t block_size = paged_grid_point_data->get_block_size();
+    const std::uint64_t block_index = grid_point_index / block_size;
+    const std::size_t slot = block_index % number_of_paged_block_slots;
+    if (paged_block_indices[slot] != block_index) {
+        paged_blocks[slot] = paged_grid_point_data->get_block(block_index);
+        paged_block_indices[slot] = block_index;
+    }
+    return paged_blocks[slot]->data() +
+           (grid_point_index % block_size) * number_of_grid_point_data_sets;
+}
+
+void RegularGridInterpolatorImplementation::release_paged_blocks()
+{
+    // Blocks evicted from the shared resident set stay in memory while a slot still holds them
+    std::fill(paged_block_indices.begin(), paged_block_indices.end(), UINT64_MAX);
+    std::fill(paged_blocks.begin(), paged_blocks.end(), nullptr);
+}
+
+std::vector<std::uint64_t> RegularGridInterpolatorImplementation::get_target_block_indices(
+    const double* targets, std::size_t number_of_targets) const
+{
+    // Blocks holding the floor and ceiling grid points around each target (only the floor grid
+    // points for grids of many axes)
+    static constexpr std::size_t maximum_number_of_axes_with_ceilings {10u};
+    const std::size_t number_of_corners =
+        number_of_grid_axes <= maximum_number_of_axes_with_ceilings
+            ? std::size_t {1} << number_of_grid_axes
+            : 1u;
+    const std::uint64_t block_size = paged_grid_point_data->get_block_size();
+    std::vector<std::uint64_t> block_indices;
+    std::vector<std::size_t> floor_coordinates(number_of_grid_axes);
+    std::vector<std::size_t> coordinates(number_of_grid_axes);
+    for (std::size_t target_index = 0; target_index < number_of_targets; ++target_index) {
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+            floor_coordinates[axis_index] = grid_axes[axis_index].get_floor_index(
+                targets[target_index * number_of_grid_axes + axis_index]);
+        }
+        for (std::size_t corner = 0; corner < number_of_corners; ++corner) {
+            for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+                coordinates[axis_index] =
+                    std::min(floor_coordinates[axis_index] + ((corner >> axis_index) & 1u),
+                             grid_axis_lengths[axis_index] - 1u);
+            }
+            block_indices.push_back(get_grid_point_index(coordinates) / block_size);
+        }
+    }
+    std::sort(block_indices.begin(), block_indices.end());
+    block_indices.erase(std::unique(block_indices.begin(), block_indices.end()),
+                        block_indices.end());
+    return block_indices;
+}
+
+double RegularGridInterpolatorImplementation::get_grid_point_data_compression_ratio() const
+{
+    if (!compressed_grid_point_data || compressed_grid_point_data->get_compressed_size() == 0u) {
+        return 1.0;
+    }
+    return static_cast<double>(compressed_grid_point_data->get_uncompressed_size()) /
+           static_cast<double>(compressed_grid_point_data->get_compressed_size());
+}
+
+void RegularGridInterpolatorImplementation::set_grid_point_data_layout_step_sizes(
+    std::size_t block_length)
+{
+    grid_axis_step_size.resize(number_of_grid_axes);
+    grid_axis_block_shifts.assign(number_of_grid_axes, 0u);
+    grid_axis_in_block_step_size.assign(number_of_grid_axes, 0u);
+    if (grid_point_data_layout == GridPointDataLayout::row_major) {
+        std::size_t step_size = 1;
+        for (std::size_t axis_index = number_of_grid_axes; axis_index-- > 0;) {
+            grid_axis_step_size[axis_index] = step_size;
+            step_size *= grid_axis_lengths[axis_index];
+        }
+        number_of_stored_grid_points = number_of_grid_points;
+        return;
+    }
+
+    // Blocks are no longer than the (power-of-two rounded) axis so short axes are not over-padded
+    std::size_t block_size = 1;
+    std::vector<std::size_t> number_of_blocks(number_of_grid_axes);
+    for (std::size_t axis_index = number_of_grid_axes; axis_index-- > 0;) {
+        std::size_t axis_block_length = 1;
+        std::size_t shift = 0;
+        while (axis_block_length < block_length &&
+               axis_block_length < grid_axis_lengths[axis_index]) {
+            axis_block_length <<= 1u;
+            ++shift;
+        }
+        grid_axis_block_shifts[axis_index] = shift;
+        grid_axis_in_block_step_size[axis_index] = block_size;
+        block_size *= axis_block_length;
+        number_of_blocks[axis_index] =
+            (grid_axis_lengths[axis_index] + axis_block_length - 1) / axis_block_length;
+    }
+    std::size_t step_size = block_size;
+    for (std::size_t axis_index = number_of_grid_axes; axis_index-- > 0;) {
+        grid_axis_step_size[axis_index] = step_size;
+        step_size *= number_of_blocks[axis_index];
+    }
+    number_of_stored_grid_points = step_size;
+}
+
+std::vector<double> RegularGridInterpolatorImplementation::arrange_grid_point_data(
+    const std::vector<double>& row_major_data) const
+{
+    if (grid_point_data_layout == GridPointDataLayout::row_major) {
+        return row_major_data;
+    }
+    std::vector<double> stored_data(number_of_stored_grid_points, 0.);
+    std::vector<std::size_t> coordinates(number_of_grid_axes, 0u);
+    for (const auto value : row_major_data) {
+        stored_data[get_grid_point_index(coordinates)] = value;
+        increment_grid_point_coordinates(coordinates);
+    }
+    return stored_data;
+}
+
+void RegularGridInterpolatorImplementation::increment_grid_point_coordinates(
+    std::vector<std::size_t>& coordinates) const
+{
+    // Advance to the next grid point in row-major order (last axis varies fastest)
+    for (std::size_t axis_index = number_of_grid_axes; axis_index-- > 0;) {
+        if (++coordinates[axis_index] < grid_axis_lengths[axis_index]) {
+            return;
+        }
+        coordinates[axis_index] = 0u;
+    }
+}
+
 void RegularGridInterpolatorImplementation::check_grid_point_data_set_size(
     const GridPointDataSet& grid_point_data_set)
 {
@@ -367,7 +1761,28 @@ void RegularGridInterpolatorImplementation::check_grid_point_data_set_size(
 
 void RegularGridInterpolatorImplementation::set_results()
 {
+    update_target_state();
+    partial_results_axis = number_of_grid_axes; // None
+    if (hypercube_is_simplicial) {
+        set_simplex_results();
+        return;
+    }
+    if (hypercube.size() == 1u) {
+        // Every axis has a single vertex with a nonzero weight (e.g., the target is on a grid
+        // point), so the result is read directly
+        BTWXT_TRACE_SCOPE(TraceStage::gather);
+        const auto& vertex = hypercube[0];
+        const auto& grid_point_data = get_grid_point_data(
+            get_grid_point_index_relative(floor_grid_point_coordinates, vertex));
+        double weighting_factor = get_grid_point_weighting_factor(vertex);
+        for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+             ++data_set_index) {
+            results[data_set_index] = grid_point_data[data_set_index] * weighting_factor;
+        }
+        return;
+    }
     set_hypercube_grid_point_data();
+    BTWXT_TRACE_SCOPE(TraceStage::reduction);
     std::fill(results.begin(), results.end(), 0.0);
     for (std::size_t hypercube_index = 0; hypercube_index < hypercube.size(); ++hypercube_index) {
         hypercube_weights[hypercube_index] =
@@ -380,18 +1795,197 @@ void RegularGridInterpolatorImplementation::set_results()
     }
 }
 
+void RegularGridInterpolatorImplementation::set_simplex_results()
+{
+    // Each vertex of the other axes is combined with the simplex path, stepping the grid point
+    // index from the floor to the ceiling of one simplex axis at a time
+    BTWXT_TRACE_SCOPE(TraceStage::reduction);
+    std::fill(results.begin(), results.end(), 0.0);
+    const std::size_t number_of_simplex_axes = simplex_axes.size();
+    for (const auto& vertex : hypercube) {
+        double other_weighting_factor = 1.0;
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
+            if (methods[axis_index] != Method::simplex) {
+                other_weighting_factor *= weighting_factors[axis_index][vertex[axis_index] + 1];
+            }
+        }
+        std::size_t grid_point_index =
+            get_grid_point_index_relative(floor_grid_point_coordinates, vertex);
+        for (std::size_t step = 0; step <= number_of_simplex_axes; ++step) {
+            if (step > 0u) {
+                grid_point_index += simplex_grid_point_index_steps[step - 1];
+            }
+            if (simplex_weights[step] == 0.0) {
+                continue;
+            }
+            const double weighting_factor = other_weighting_factor * simplex_weights[step];
+            const auto& grid_point_data = get_grid_point_data(grid_point_index);
+            for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+                 ++data_set_index) {
+                results[data_set_index] += grid_point_data[data_set_index] * weighting_factor;
+            }
+        }
+    }
+}
+
+void RegularGridInterpolatorImplementation::set_partial_results(std::size_t axis_index)
+{
+    partial_results.resize(4, std::vector<double>(number_of_grid_point_data_sets));
+    for (auto& offset_results : partial_results) {
+        offset_results.assign(number_of_grid_point_data_sets, 0.0);
+    }
+    for (std::size_t hypercube_index = 0; hypercube_index < hypercube.size(); ++hypercube_index) {
+        const auto& vertex = hypercube[hypercube_index];
+        double weighting_factor = 1.0;
+        for (std::size_t other_axis_index = 0; other_axis_index < number_of_grid_axes;
+             other_axis_index++) {
+            if (other_axis_index != axis_index) {
+                weighting_factor *=
+                    weighting_factors[other_axis_index][vertex[other_axis_index] + 1];
+            }
+        }
+        auto& offset_results = partial_results[vertex[axis_index] + 1];
+        for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+             ++data_set_index) {
+            offset_results[data_set_index] +=
+                hypercube_grid_point_data[hypercube_index][data_set_index] * weighting_factor;
+        }
+    }
+    partial_results_axis = axis_index;
+}
+
+std::vector<std::vector<double>> RegularGridInterpolatorImplementation::get_column_results(
+    const std::vector<std::vector<double>>& target_columns)
+{
+    check_target_size(target_columns.size());
+    const std::size_t number_of_targets = target_columns.empty() ? 0u : target_columns[0].size();
+    std::vector<const double*> target_column_pointers;
+    for (const auto& target_column : target_columns) {
+        if (target_column.size() != number_of_targets) {
+            send_error(fmt::format("Target columns have different lengths ({} and {}).",
+                                   number_of_targets,
+                                   target_column.size()));
+        }
+        target_column_pointers.push_back(target_column.data());
+    }
+    std::vector<std::vector<double>> result_columns(number_of_grid_point_data_sets,
+                                                    std::vector<double>(number_of_targets));
+    std::vector<double*> result_column_pointers;
+    for (auto& result_column : result_columns) {
+        result_column_pointers.push_back(result_column.data());
+    }
+    get_column_results(
+        target_column_pointers.data(), number_of_targets, result_column_pointers.data());
+    return result_columns;
+}
+
+void RegularGridInterpolatorImplementation::get_column_results(const double* const* target_columns,
+                                                               std::size_t number_of_targets,
+                                                               double* const* result_columns)
+{
+    if (number_of_grid_point_data_sets == 0u) {
+        send_error("There are no grid point data sets. No results returned.");
+    }
+    std::vector<double> target_in(number_of_grid_axes);
+    auto set_target_from_columns = [&](std::size_t target_index) {
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+            target_in[axis_index] = target_columns[axis_index][target_index];
+        }
+        set_target(target_in);
+    };
+
+    // Grids that are linearly interpolated along every axis, with row-major grid point data in
+    // memory, are evaluated several targets at a time (one per SIMD lane)
+    bool is_lane_evaluation = !compressed_grid_point_data && !paged_grid_point_data &&
+                              !shared_table &&
+                              grid_point_data_layout == GridPointDataLayout::row_major;
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        is_lane_evaluation &=
+            get_axis_interpolation_method(axis_index) == Method::linear;
+    }
+    if (!is_lane_evaluation) {
+        for (std::size_t target_index = 0; target_index < number_of_targets; ++target_index) {
+            set_target_from_columns(target_index);
+            for (std::size_t data_set_index = 0; data_set_index < number_of_grid_point_data_sets;
+                 ++data_set_index) {
+                result_columns[data_set_index][target_index] = results[data_set_index];
+            }
+        }
+        return;
+    }
+
+    LinearLaneGrid lane_grid;
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
+        // Targets outside of the extrapolation limits send errors as they do individually
+        auto limits = get_extrapolation_limits(axis_index);
+        for (std::size_t target_index = 0; target_index < number_of_targets; ++target_index) {
+            double value = target_columns[axis_index][target_index];
+            if (value < limits.first || value > limits.second) {
+                set_target_from_columns(target_index);
+            }
+        }
+        lane_grid.axis_values.push_back(grid_axes[axis_index].get_values().data());
+        lane_grid.axis_lengths.push_back(grid_axis_lengths[axis_index]);
+        lane_grid.axis_step_sizes.push_back(grid_axis_step_size[axis_index]);
+        lane_grid.axis_search_trees.push_back(grid_axes[axis_index].get_search_tree().data());
+        lane_grid.axis_search_tree_heights.push_back(
+            grid_axes[axis_index].get_search_tree_height());
+        lane_grid.axis_constant_extrapolation.push_back(
+            get_axis_extrapolation_method(axis_index) == Method::constant);
+    }
+    for (const auto& grid_point_data_set : *grid_point_data_sets) {
+        lane_grid.grid_point_data.push_back(grid_point_data_set.data.data());
+    }
+    for (std::size_t first_target = 0; first_target < number_of_targets;
+         first_target += number_of_target_lanes) {
+        evaluate_linear_target_lanes(
+            lane_grid,
+            target_columns,
+            first_target,
+            std::min(number_of_target_lanes, number_of_targets - first_target),
+            result_columns);
+    }
+}
+
+void RegularGridInterpolatorImplementation::evaluate_targets(const double* targets,
+                                                             std::size_t number_of_targets,
+                                                             double* results_out)
+{
+    // With paged grid point data, the blocks for the next group of targets are read in the
+    // background while the current group is evaluated
+    static constexpr std::size_t targets_per_prefetch {64u};
+    std::vector<double> target_in(number_of_grid_axes);
+    for (std::size_t target_index = 0; target_index < number_of_targets; ++target_index) {
+        std::size_t next_group_index = target_index + targets_per_prefetch;
+        if (paged_grid_point_data && target_index % targets_per_prefetch == 0u &&
+            next_group_index < number_of_targets) {
+            paged_grid_point_data->prefetch(get_target_block_indices(
+                targets + next_group_index * number_of_grid_axes,
+                std::min(targets_per_prefetch, number_of_targets - next_group_index)));
+        }
+        std::copy(targets + target_index * number_of_grid_axes,
+                  targets + (target_index + 1) * number_of_grid_axes,
+                  target_in.begin());
+        // Results of an inexact result cache would depend on how targets are split among tasks
+        set_target(target_in, false);
+        std::copy(results.begin(),
+                  results.end(),
+                  results_out + target_index * number_of_grid_point_data_sets);
+    }
+}
+
 // Internal calculation methods
 
 std::size_t RegularGridInterpolatorImplementation::get_grid_point_index_relative(
     const std::vector<std::size_t>& coords, const std::vector<short>& translation)
 {
-    int new_coord;
+    std::int64_t new_coord;
     for (std::size_t axis_index = 0; axis_index < coords.size(); axis_index++) {
-        new_coord = static_cast<int>(coords[axis_index]) + translation[axis_index];
+        new_coord = static_cast<std::int64_t>(coords[axis_index]) + translation[axis_index];
         if (new_coord < 0) {
             temporary_coordinates[axis_index] = 0u;
         }
-        else if (new_coord >= static_cast<int>(grid_axis_lengths[axis_index])) {
+        else if (new_coord >= static_cast<std::int64_t>(grid_axis_lengths[axis_index])) {
             temporary_coordinates[axis_index] = grid_axis_lengths[axis_index] - 1u;
         }
         else {
@@ -403,6 +1997,7 @@ std::size_t RegularGridInterpolatorImplementation::get_grid_point_index_relative
 
 void RegularGridInterpolatorImplementation::set_floor_grid_point_coordinates()
 {
+    BTWXT_TRACE_SCOPE(TraceStage::floor_search);
     for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index += 1) {
         set_axis_floor_grid_point_index(axis_index);
     }
@@ -441,23 +2036,30 @@ void RegularGridInterpolatorImplementation::set_axis_floor_grid_point_index(std:
     }
     else {
         target_bounds_status[axis_index] = TargetBoundsStatus::interpolate;
-        auto upper = std::upper_bound(axis_values.begin(), axis_values.end(), target[axis_index]);
-        floor_grid_point_coordinates[axis_index] = upper - axis_values.begin() - 1;
+        floor_grid_point_coordinates[axis_index] =
+            grid_axes[axis_index].get_floor_index(target[axis_index]);
     }
 }
 
 void RegularGridInterpolatorImplementation::calculate_floor_to_ceiling_fractions()
 {
+    BTWXT_TRACE_SCOPE(TraceStage::fractions);
     for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; ++axis_index) {
-        if (grid_axis_lengths[axis_index] > 1) {
-            auto& axis_values = grid_axes[axis_index].get_values();
-            auto floor_index = floor_grid_point_coordinates[axis_index];
-            floor_to_ceiling_fractions[axis_index] = compute_fraction(
-                target[axis_index], axis_values[floor_index], axis_values[floor_index + 1]);
-        }
-        else {
-            floor_to_ceiling_fractions[axis_index] = 1.0;
-        }
+        calculate_axis_floor_to_ceiling_fraction(axis_index);
+    }
+}
+
+void RegularGridInterpolatorImplementation::calculate_axis_floor_to_ceiling_fraction(
+    std::size_t axis_index)
+{
+    if (grid_axis_lengths[axis_index] > 1) {
+        auto& axis_values = grid_axes[axis_index].get_values();
+        auto floor_index = floor_grid_point_coordinates[axis_index];
+        floor_to_ceiling_fractions[axis_index] = compute_fraction(
+            target[axis_index], axis_values[floor_index], axis_values[floor_index + 1]);
+    }
+    else {
+        floor_to_ceiling_fractions[axis_index] = 1.0;
     }
 }
 
@@ -465,72 +2067,107 @@ void RegularGridInterpolatorImplementation::consolidate_methods()
 // If out of bounds, extrapolate according to prescription
 // If outside of extrapolation limits, send a warning and perform constant extrapolation.
 {
-    previous_methods = methods;
-    methods = get_interpolation_methods();
-    if (target_is_set) {
-        auto extrapolation_methods = get_extrapolation_methods();
-        constexpr std::string_view error_format {
-            "GridAxis '{}': The target ({:.6g}) is {} the extrapolation "
-            "limit ({:.6g})."};
-        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
-            switch (target_bounds_status[axis_index]) {
-            case TargetBoundsStatus::extrapolate_low:
-            case TargetBoundsStatus::extrapolate_high:
-                methods[axis_index] = extrapolation_methods[axis_index];
-                break;
-            case TargetBoundsStatus::below_lower_extrapolation_limit:
-                send_error(fmt::format(error_format,
-                                       grid_axes[axis_index].name,
-                                       target[axis_index],
-                                       "below",
-                                       get_extrapolation_limits(axis_index).first));
-                break;
-            case TargetBoundsStatus::above_upper_extrapolation_limit:
-                send_error(fmt::format(error_format,
-                                       grid_axes[axis_index].name,
-                                       target[axis_index],
-                                       "above",
-                                       get_extrapolation_limits(axis_index).second));
-                break;
-            case TargetBoundsStatus::interpolate:
-                break;
-            }
-        }
-    }
-    reset_hypercube |=
-        !std::equal(previous_methods.begin(), previous_methods.end(), methods.begin());
-    if (reset_hypercube) {
-        set_hypercube(methods);
+    BTWXT_TRACE_SCOPE(TraceStage::consolidate_methods);
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
+        consolidate_axis_method(axis_index);
     }
 }
 
-void RegularGridInterpolatorImplementation::set_hypercube(std::vector<Method> methods_in)
+void RegularGridInterpolatorImplementation::consolidate_axis_method(std::size_t axis_index)
 {
-    assert(methods_in.size() == number_of_grid_axes);
-    std::size_t previous_size = hypercube.size();
-    std::vector<std::vector<int>> options(number_of_grid_axes, {0, 1});
-    reset_hypercube = false;
+    methods[axis_index] = get_axis_interpolation_method(axis_index);
+    if (!target_is_set) {
+        return;
+    }
+    constexpr std::string_view error_format {"GridAxis '{}': The target ({:.6g}) is {} the "
+                                             "extrapolation limit ({:.6g})."};
+    switch (target_bounds_status[axis_index]) {
+    case TargetBoundsStatus::extrapolate_low:
+    case TargetBoundsStatus::extrapolate_high:
+        methods[axis_index] = get_axis_extrapolation_method(axis_index);
+        break;
+    case TargetBoundsStatus::below_lower_extrapolation_limit:
+        send_error(fmt::format(error_format,
+                               grid_axes[axis_index].name,
+                               target[axis_index],
+                               "below",
+                               get_extrapolation_limits(axis_index).first));
+        break;
+    case TargetBoundsStatus::above_upper_extrapolation_limit:
+        send_error(fmt::format(error_format,
+                               grid_axes[axis_index].name,
+                               target[axis_index],
+                               "above",
+                               get_extrapolation_limits(axis_index).second));
+        break;
+    case TargetBoundsStatus::interpolate:
+        break;
+    }
+}
 
-    hypercube_size_hash = 0;
-    std::size_t digit = 1;
+void RegularGridInterpolatorImplementation::set_hypercube()
+{
+    BTWXT_TRACE_SCOPE(TraceStage::hypercube);
+    // Each axis contributes only the vertices (offsets -1, 0, 1, 2) with nonzero weighting factors.
+    // Without a target, every vertex used by the axis method is included. With two or more simplex
+    // axes, the hypercube holds only their floor (the simplex path supplies the other vertices).
+    simplex_axes.clear();
+    if (target_is_set) {
+        for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
+            if (methods[axis_index] == Method::simplex) {
+                simplex_axes.push_back(axis_index);
+            }
+        }
+    }
+    const bool is_simplicial = simplex_axes.size() > 1u;
+    bool axis_vertices_changed = hypercube_axis_vertices.size() != number_of_grid_axes ||
+                                 is_simplicial != hypercube_is_simplicial;
+    hypercube_is_simplicial = is_simplicial;
+    hypercube_axis_vertices.resize(number_of_grid_axes);
     for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
-        if (target_is_set && floor_to_ceiling_fractions[axis_index] == 0.0) {
-            options[axis_index] = {0};
-            reset_hypercube = true;
+        unsigned axis_vertices = 0u;
+        if (is_simplicial && methods[axis_index] == Method::simplex) {
+            axis_vertices = 0b0010u;
+        }
+        else if (!target_is_set) {
+            axis_vertices = methods[axis_index] == Method::cubic ? 0b1111u : 0b0110u;
         }
-        else if (methods_in[axis_index] == Method::cubic) {
-            options[axis_index] = {-1, 0, 1, 2};
+        else {
+            for (std::size_t offset_index = 0; offset_index < 4; ++offset_index) {
+                if (weighting_factors[axis_index][offset_index] != 0.0) {
+                    axis_vertices |= 1u << offset_index;
+                }
+            }
         }
-        hypercube_size_hash += options[axis_index].size() * digit;
-        digit *= 10;
+        axis_vertices_changed |= axis_vertices != hypercube_axis_vertices[axis_index];
+        hypercube_axis_vertices[axis_index] = axis_vertices;
+    }
+    if (is_simplicial) {
+        set_simplex_path();
+    }
+    if (!axis_vertices_changed) {
+        return;
+    }
+
+    // The hash identifies the hypercube shape uniquely for up to maximum_number_of_hashed_axes
+    hypercube_size_hash = 0u;
+    for (std::size_t axis_index = 0;
+         axis_index < std::min(number_of_grid_axes, maximum_number_of_hashed_axes);
+         axis_index++) {
+        hypercube_size_hash |= std::size_t {hypercube_axis_vertices[axis_index]}
+                               << (4u * axis_index);
     }
+
+    std::size_t previous_size = hypercube.size();
     hypercube = {{}};
-    for (const auto& list : options) {
+    for (auto axis_vertices : hypercube_axis_vertices) {
         std::vector<std::vector<short>> r;
         for (const auto& x : hypercube) {
-            for (const auto item : list) {
-                r.push_back(x);
-                r.back().push_back(static_cast<short>(item));
+            for (short offset = -1; offset <= 2; ++offset) {
+                if (axis_vertices & (1u << (offset + 1))) {
+                    r.push_back(x);
+                    r.back().push_back(offset);
+                }
             }
         }
         hypercube = std::move(r);
@@ -542,59 +2179,194 @@ void RegularGridInterpolatorImplementation::set_hypercube(std::vector<Method> me
     }
 }
 
+void RegularGridInterpolatorImplementation::set_simplex_path()
+{
+    // The simplex containing the target (Kuhn triangulation) is the path from the floor, stepping
+    // to the ceiling along each simplex axis in order of descending fraction. The weight of each
+    // vertex along the path is the drop in fraction at its step.
+    std::stable_sort(simplex_axes.begin(), simplex_axes.end(), [&](std::size_t a, std::size_t b) {
+        return floor_to_ceiling_fractions[a] > floor_to_ceiling_fractions[b];
+    });
+    const std::size_t number_of_simplex_axes = simplex_axes.size();
+    simplex_weights.resize(number_of_simplex_axes + 1u);
+    simplex_grid_point_index_steps.resize(number_of_simplex_axes);
+    double previous_fraction = 1.0;
+    for (std::size_t step = 0; step < number_of_simplex_axes; ++step) {
+        const std::size_t axis_index = simplex_axes[step];
+        simplex_weights[step] = previous_fraction - floor_to_ceiling_fractions[axis_index];
+        previous_fraction = floor_to_ceiling_fractions[axis_index];
+        simplex_grid_point_index_steps[step] = get_axis_grid_point_index_step(axis_index);
+    }
+    simplex_weights[number_of_simplex_axes] = previous_fraction;
+    gathered_hypercube_key = {SIZE_MAX, 0u}; // The hypercube grid point data is not gathered
+}
+
+std::size_t
+RegularGridInterpolatorImplementation::get_axis_grid_point_index_step(std::size_t axis_index) const
+{
+    const std::size_t floor = floor_grid_point_coordinates[axis_index];
+    const std::size_t ceiling = std::min(floor + 1u, grid_axis_lengths[axis_index] - 1u);
+    if (grid_point_data_layout == GridPointDataLayout::row_major) {
+        return (ceiling - floor) * grid_axis_step_size[axis_index];
+    }
+    const std::size_t shift = grid_axis_block_shifts[axis_index];
+    const std::size_t mask = (std::size_t {1} << shift) - 1u;
+    auto get_axis_index = [&](std::size_t coordinate) {
+        return (coordinate >> shift) * grid_axis_step_size[axis_index] +
+               (coordinate & mask) * grid_axis_in_block_step_size[axis_index];
+    };
+    return get_axis_index(ceiling) - get_axis_index(floor);
+}
+
+std::size_t RegularGridInterpolatorImplementation::get_number_of_simplex_axes() const
+{
+    std::size_t number_of_simplex_axes = 0u;
+    for (const auto& grid_axis : grid_axes) {
+        if (grid_axis.get_interpolation_method() == InterpolationMethod::simplex) {
+            ++number_of_simplex_axes;
+        }
+    }
+    return number_of_simplex_axes;
+}
+
 void RegularGridInterpolatorImplementation::calculate_interpolation_coefficients()
+{
+    BTWXT_TRACE_SCOPE(TraceStage::coefficients);
+    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
+        calculate_axis_interpolation_coefficients(axis_index);
+    }
+}
+
+void RegularGridInterpolatorImplementation::calculate_axis_interpolation_coefficients(
+    std::size_t axis_index)
 {
     static constexpr std::size_t floor = 0;
     static constexpr std::size_t ceiling = 1;
-    for (std::size_t axis_index = 0; axis_index < number_of_grid_axes; axis_index++) {
-        double mu = floor_to_ceiling_fractions[axis_index];
-        if (methods[axis_index] == Method::cubic) {
-            interpolation_coefficients[axis_index][floor] = 2 * mu * mu * mu - 3 * mu * mu + 1;
-            interpolation_coefficients[axis_index][ceiling] = -2 * mu * mu * mu + 3 * mu * mu;
-            cubic_slope_coefficients[axis_index][floor] =
-                (mu * mu * mu - 2 * mu * mu + mu) *
-                get_axis_cubic_spacing_ratios(axis_index,
-                                              floor)[floor_grid_point_coordinates[axis_index]];
-            cubic_slope_coefficients[axis_index][ceiling] =
-                (mu * mu * mu - mu * mu) *
-                get_axis_cubic_spacing_ratios(axis_index,
-                                              ceiling)[floor_grid_point_coordinates[axis_index]];
-        }
-        else {
-            if (methods[axis_index] == Method::constant) {
-                mu = mu < 0 ? 0 : 1;
-            }
-            interpolation_coefficients[axis_index][floor] = 1 - mu;
-            interpolation_coefficients[axis_index][ceiling] = mu;
-            cubic_slope_coefficients[axis_index][floor] = 0.0;
-            cubic_slope_coefficients[axis_index][ceiling] = 0.0;
+    double mu = floor_to_ceiling_fractions[axis_index];
+    if (methods[axis_index] == Method::cubic) {
+        interpolation_coefficients[axis_index][floor] = 2 * mu * mu * mu - 3 * mu * mu + 1;
+        interpolation_coefficients[axis_index][ceiling] = -2 * mu * mu * mu + 3 * mu * mu;
+        cubic_slope_coefficients[axis_index][floor] =
+            (mu * mu * mu - 2 * mu * mu + mu) *
+            get_axis_cubic_spacing_ratios(axis_index,
+                                          floor)[floor_grid_point_coordinates[axis_index]];
+        cubic_slope_coefficients[axis_index][ceiling] =
+            (mu * mu * mu - mu * mu) *
+            get_axis_cubic_spacing_ratios(axis_index,
+                                          ceiling)[floor_grid_point_coordinates[axis_index]];
+    }
+    else {
+        if (methods[axis_index] == Method::constant) {
+            mu = mu < 0 ? 0 : 1;
         }
-        weighting_factors[axis_index][0] =
-            -cubic_slope_coefficients[axis_index][floor]; // point below floor (-1)
-        weighting_factors[axis_index][1] =
-            interpolation_coefficients[axis_index][floor] -
-            cubic_slope_coefficients[axis_index][ceiling]; // floor (0)
-        weighting_factors[axis_index][2] =
-            interpolation_coefficients[axis_index][ceiling] +
-            cubic_slope_coefficients[axis_index][floor]; // ceiling (1)
-        weighting_factors[axis_index][3] =
-            cubic_slope_coefficients[axis_index][ceiling]; // point above ceiling (2)
+        interpolation_coefficients[axis_index][floor] = 1 - mu;
+        interpolation_coefficients[axis_index][ceiling] = mu;
+        cubic_slope_coefficients[axis_index][floor] = 0.0;
+        cubic_slope_coefficients[axis_index][ceiling] = 0.0;
     }
+    weighting_factors[axis_index][0] =
+        -cubic_slope_coefficients[axis_index][floor]; // point below floor (-1)
+    weighting_factors[axis_index][1] =
+        interpolation_coefficients[axis_index][floor] -
+        cubic_slope_coefficients[axis_index][ceiling]; // floor (0)
+    weighting_factors[axis_index][2] =
+        interpolation_coefficients[axis_index][ceiling] +
+        cubic_slope_coefficients[axis_index][floor]; // ceiling (1)
+    weighting_factors[axis_index][3] =
+        cubic_slope_coefficients[axis_index][ceiling]; // point above ceiling (2)
 }
 
 void RegularGridInterpolatorImplementation::set_hypercube_grid_point_data()
 {
-    if (hypercube_cache.count({floor_grid_point_index, hypercube_size_hash})) {
-        hypercube_grid_point_data =
-            hypercube_cache.at({floor_grid_point_index, hypercube_size_hash});
+    BTWXT_TRACE_SCOPE(TraceStage::gather);
+    std::pair<std::size_t, std::size_t> hypercube_key {floor_grid_point_index, hypercube_size_hash};
+    const bool hypercube_key_is_unique =
+        number_of_grid_axes <= maximum_number_of_hashed_axes && !hypercube_is_simplicial;
+    if (hypercube_key_is_unique && hypercube_key == gathered_hypercube_key) {
+        return; // Already gathered
+    }
+    gathered_hypercube_key = hypercube_key;
+    if (!hypercube_key_is_unique) {
+        gathered_hypercube_key = {SIZE_MAX, 0u}; // Other hypercubes may share the key
+    }
+    partial_results_axis = number_of_grid_axes; // None
+    const bool use_shared_cache = hypercube_key_is_unique && shared_hypercube_cache;
+    if (use_shared_cache &&
+        shared_hypercube_cache->find(floor_grid_point_index,
+                                     hypercube_size_hash,
+                                     number_of_grid_point_data_sets,
+                                     hypercube_grid_point_data)) {
         return;
     }
+    if (hypercube_key_is_unique && !use_shared_cache) {
+        if (const auto* entry = hypercube_cache.find(hypercube_key)) {
+            hypercube_grid_point_data = *entry;
+            return;
+        }
+    }
     std::size_t hypercube_index = 0;
     for (const auto& v : hypercube) {
         hypercube_grid_point_data[hypercube_index] =
             get_grid_point_data_relative(floor_grid_point_coordinates, v);
         ++hypercube_index;
     }
-    hypercube_cache[{floor_grid_point_index, hypercube_size_hash}] = hypercube_grid_point_data;
+    if (use_shared_cache) {
+        shared_hypercube_cache->insert(
+            floor_grid_point_index, hypercube_size_hash, hypercube_grid_point_data);
+    }
+    else if (hypercube_key_is_unique) {
+        hypercube_cache.insert(hypercube_key,
+                               hypercube_grid_point_data,
+                               get_hypercube_cache_entry_memory_size());
+    }
+}
+
+std::size_t RegularGridInterpolatorImplementation::get_hypercube_cache_entry_memory_size() const
+{
+    // Estimated: map node (key, links, and vector) and hypercube grid point data
+    return HypercubeCache::entry_overhead +
+           hypercube_grid_point_data.size() *
+               (sizeof(std::vector<double>) + number_of_grid_point_data_sets * sizeof(double));
+}
+
+std::size_t RegularGridInterpolatorImplementation::get_maximum_hypercube_entry_size() const
+{
+    std::size_t number_of_vertices = 1u;
+    for (const auto& grid_axis : grid_axes) {
+        const bool is_cubic = grid_axis.get_interpolation_method() == InterpolationMethod::cubic;
+        number_of_vertices *= is_cubic ? 4u : 2u;
+    }
+    return number_of_vertices * number_of_grid_point_data_sets;
+}
+
+void RegularGridInterpolatorImplementation::reset_shared_hypercube_cache()
+{
+    shared_hypercube_cache = std::make_shared<SharedHypercubeCache>(
+        maximum_shared_hypercube_cache_memory_size, get_maximum_hypercube_entry_size());
+}
+
+void RegularGridInterpolatorImplementation::update_target_state()
+{
+    // Recalculate what a result cache hit skipped
+    if (!target_state_is_stale) {
+        return;
+    }
+    target_state_is_stale = false;
+    set_floor_grid_point_coordinates();
+    calculate_floor_to_ceiling_fractions();
+    consolidate_methods();
+    calculate_interpolation_coefficients();
+    set_hypercube();
+    partial_results_axis = number_of_grid_axes; // None
+}
+
+void RegularGridInterpolatorImplementation::clear_caches()
+{
+    hypercube_cache.clear();
+    if (shared_hypercube_cache) {
+        reset_shared_hypercube_cache(); // Copies with the previous grid point data keep theirs
+    }
+    gathered_hypercube_key = {SIZE_MAX, 0u}; // Grid point data must be gathered again
+    result_cache.clear();
 }
 } // namespace Btwxt
\ No newline at end of file
@@ -4,6 +4,7 @@
 #pragma once
 
 // Standard
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -15,10 +16,17 @@
 
 // btwxt
 #include <btwxt/btwxt.h>
+#include "grid-point-data-compression.h"
+#include "grid-point-data-file.h"
+#include "target-lanes.h"
+#include "hypercube-cache.h"
+#include "result-cache.h"
+#include "shared-hypercube-cache.h"
+#include "shared-table.h"
 
 namespace Btwxt {
 
-enum class Method { undefined, constant, linear, cubic };
+enum class Method { undefined, constant, linear, cubic, simplex };
 
 class RegularGridInterpolatorImplementation : public Courier::Sender {
     friend class GridAxis;
@@ -26,12 +34,12 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
   public:
     RegularGridInterpolatorImplementation() = default;
 
-    RegularGridInterpolatorImplementation(const std::vector<GridAxis>& grid_axes,
+    RegularGridInterpolatorImplementation(std::vector<GridAxis> grid_axes,
                                           std::string name,
                                           const std::shared_ptr<Courier::Courier>& courier);
 
-    RegularGridInterpolatorImplementation(const std::vector<GridAxis>& grid_axes,
-                                          const std::vector<GridPointDataSet>& grid_point_data_sets,
+    RegularGridInterpolatorImplementation(std::vector<GridAxis> grid_axes,
+                                          std::vector<GridPointDataSet> grid_point_data_sets,
                                           std::string name,
                                           const std::shared_ptr<Courier::Courier>& courier);
 
@@ -41,18 +49,24 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
     operator=(const RegularGridInterpolatorImplementation& source) = default;
 
     // Data manipulation and settings
-    std::size_t add_grid_point_data_set(const GridPointDataSet& grid_point_data_set);
+    std::size_t add_grid_point_data_set(GridPointDataSet grid_point_data_set);
 
     void set_axis_interpolation_method(std::size_t axis_index, InterpolationMethod method)
     {
         check_axis_index(axis_index, "set axis interpolation method");
         grid_axes[axis_index].set_interpolation_method(method);
+        axis_settings_changed = true;
+        if (shared_hypercube_cache &&
+            get_maximum_hypercube_entry_size() > shared_hypercube_cache->get_maximum_entry_size()) {
+            reset_shared_hypercube_cache(); // Entries no longer fit
+        }
     }
 
     void set_axis_extrapolation_method(const std::size_t axis_index, ExtrapolationMethod method)
     {
         check_axis_index(axis_index, "set axis extrapolation method");
         grid_axes[axis_index].set_extrapolation_method(method);
+        axis_settings_changed = true;
     }
 
     void set_axis_extrapolation_limits(const std::size_t axis_index,
@@ -60,11 +74,46 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
     {
         check_axis_index(axis_index, "set axis extrapolation limits");
         grid_axes[axis_index].set_extrapolation_limits(limits);
+        axis_settings_changed = true;
     }
 
+    void set_grid_point_data_layout(GridPointDataLayout layout, std::size_t block_length = 4);
+
+    void set_grid_point_data_compression(double maximum_error, std::size_t block_size);
+
+    void clear_grid_point_data_compression();
+
+    void set_grid_point_data_file(const std::string& path, std::size_t maximum_resident_size);
+
+    [[nodiscard]] GridPointDataPagingStatistics get_grid_point_data_paging_statistics() const;
+
+    void publish_shared_table(const std::string& table_name, SharedTableStorage storage) const;
+
+    // Replaces stored grid point data with the shared table's (read-only) grid point data. The
+    // table's grid axes must match.
+    void set_shared_table(std::shared_ptr<const SharedTable> shared_table_in);
+
+    [[nodiscard]] std::unique_ptr<RegularGridInterpolatorImplementation>
+    get_reduced_interpolator(const std::map<std::size_t, double>& fixed_axis_values) const;
+
+    [[nodiscard]] std::unique_ptr<RegularGridInterpolatorImplementation>
+    get_coarsened_interpolator(double tolerance, std::vector<double>& maximum_errors) const;
+
+    [[nodiscard]] InverseSolution solve_for_axis_value(const std::vector<double>& target,
+                                                       std::size_t axis_index,
+                                                       std::size_t data_set_index,
+                                                       double result) const;
+
+    [[nodiscard]] std::vector<double>
+    integrate(const std::vector<double>& target,
+              const std::map<std::size_t, std::pair<double, double>>& axis_ranges,
+              bool average) const;
+
     // Public methods (mirrored)
     void set_target(const std::vector<double>& target);
 
+    void set_target_axis(std::size_t axis_index, double value);
+
     [[nodiscard]] const std::vector<double>& get_target() const;
 
     void clear_target();
@@ -73,6 +122,45 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
 
     std::vector<double> get_results(const std::vector<double>& target);
 
+    std::vector<std::vector<double>> get_results(const std::vector<std::vector<double>>& targets,
+                                                 const TaskExecutor& executor = nullptr);
+
+    void get_results(const double* targets,
+                     std::size_t number_of_targets,
+                     double* results_out,
+                     const TaskExecutor& executor = nullptr);
+
+    std::vector<std::vector<double>>
+    get_column_results(const std::vector<std::vector<double>>& target_columns);
+
+    void get_column_results(const double* const* target_columns,
+                            std::size_t number_of_targets,
+                            double* const* result_columns);
+
+    void set_minimum_targets_per_task(std::size_t minimum_targets_per_task_in)
+    {
+        minimum_targets_per_task = std::max(minimum_targets_per_task_in, std::size_t {1});
+    }
+
+    void enable_result_cache(double tolerance, std::size_t maximum_memory_size);
+
+    void disable_result_cache() { result_cache.disable(); }
+
+    [[nodiscard]] ResultCacheStatistics get_result_cache_statistics() const
+    {
+        return result_cache.get_statistics();
+    }
+
+    void set_hypercube_cache_memory_budget(std::size_t maximum_memory_size);
+
+    void enable_shared_hypercube_cache(std::size_t maximum_memory_size);
+
+    void disable_shared_hypercube_cache();
+
+    [[nodiscard]] MemoryUsage get_memory_usage() const;
+
+    [[nodiscard]] std::vector<EvaluationCost> get_evaluation_costs() const;
+
     void normalize_grid_point_data_sets_at_target(double scalar = 1.0);
 
     double normalize_grid_point_data_set_at_target(std::size_t data_set_index, double scalar = 1.0);
@@ -113,7 +201,22 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
     get_grid_point_data_set(std::size_t data_set_index) const
     {
         check_data_set_index(data_set_index, "get grid point data set");
-        return grid_point_data_sets[data_set_index];
+        if (compressed_grid_point_data) {
+            send_error(fmt::format("GridPointDataSet '{}': Cannot get compressed grid point data "
+                                   "set. Clear the grid point data compression first.",
+                                   (*grid_point_data_sets)[data_set_index].name));
+        }
+        if (paged_grid_point_data) {
+            send_error(fmt::format("GridPointDataSet '{}': Cannot get grid point data set. Grid "
+                                   "point data is paged from a file.",
+                                   (*grid_point_data_sets)[data_set_index].name));
+        }
+        if (shared_table) {
+            send_error(fmt::format("GridPointDataSet '{}': Cannot get grid point data set. Grid "
+                                   "point data is attached from a shared table.",
+                                   (*grid_point_data_sets)[data_set_index].name));
+        }
+        return (*grid_point_data_sets)[data_set_index];
     };
 
     [[nodiscard]] inline std::size_t get_number_of_grid_point_data_sets() const
@@ -121,6 +224,21 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
         return number_of_grid_point_data_sets;
     };
 
+    [[nodiscard]] inline GridPointDataLayout get_grid_point_data_layout() const
+    {
+        return grid_point_data_layout;
+    };
+
+    [[nodiscard]] inline std::size_t get_number_of_stored_grid_points() const
+    {
+        return number_of_stored_grid_points;
+    };
+
+    [[nodiscard]] double get_grid_point_data_compression_ratio() const;
+
+    [[nodiscard]] std::vector<double>
+    get_row_major_grid_point_data(std::size_t data_set_index) const;
+
     [[nodiscard]] inline const std::vector<std::size_t>& get_grid_axis_lengths() const
     {
         return grid_axis_lengths;
@@ -162,6 +280,10 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
     [[nodiscard]] inline const std::vector<std::vector<short>>& get_hypercube()
     {
         consolidate_methods();
+        if (target_is_set) {
+            calculate_interpolation_coefficients();
+        }
+        set_hypercube();
         return hypercube;
     };
 
@@ -190,7 +312,8 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
   private:
     // Structured data
     std::vector<GridAxis> grid_axes;
-    std::vector<GridPointDataSet> grid_point_data_sets;
+    std::shared_ptr<std::vector<GridPointDataSet>> grid_point_data_sets {
+        std::make_shared<std::vector<GridPointDataSet>>()}; // Shared with copies (copy-on-write)
     std::size_t number_of_grid_points {0u};
     std::size_t number_of_grid_point_data_sets {0u};
     std::size_t number_of_grid_axes {0u};
@@ -198,6 +321,30 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
         grid_axis_lengths; // Number of points in each grid axis (size = number_of_grid_axes)
     std::vector<std::size_t> grid_axis_step_size;   // Used to translate grid point coordinates to
                                                     // indices (size = number_of_grid_axes)
+    GridPointDataLayout grid_point_data_layout {GridPointDataLayout::row_major};
+    std::vector<std::size_t> grid_axis_block_shifts; // log2 of the number of points per block
+                                                     // along each axis (blocked layout only)
+    std::vector<std::size_t> grid_axis_in_block_step_size; // Used to translate coordinates within
+                                                           // a block to indices (blocked layout)
+    std::size_t number_of_stored_grid_points {0u}; // Length of each stored grid point data set
+                                                   // (includes any padding of partial blocks)
+    std::shared_ptr<const CompressedGridPointData>
+        compressed_grid_point_data; // Shared with copies. When set, grid_point_data_sets hold no
+                                    // data (only names).
+    double grid_point_data_maximum_error {0.0};
+    std::size_t grid_point_data_compression_block_size {0u}; // Zero when not compressed
+    static constexpr std::size_t number_of_decoded_block_slots {64u};
+    std::vector<std::size_t> decoded_block_indices; // Compressed block held in each slot
+    std::vector<double> decoded_blocks; // Decoded values for each slot (interleaved by grid point)
+    std::shared_ptr<PagedGridPointData>
+        paged_grid_point_data; // Shared with copies. When set, grid_point_data_sets hold no data
+                               // (only names).
+    static constexpr std::size_t number_of_paged_block_slots {16u};
+    std::vector<std::uint64_t> paged_block_indices; // Block held in each slot
+    std::vector<PagedGridPointData::Block> paged_blocks; // Blocks in use by this interpolator
+    std::shared_ptr<const SharedTable>
+        shared_table; // Shared with copies. When set, grid_point_data_sets hold no data (only
+                      // names).
     std::vector<std::size_t> temporary_coordinates; // Memory placeholder to avoid re-allocating
                                                     // memory (size = number_of_grid_axes)
     std::vector<double> temporary_grid_point_data;  // Pre-sized container to store set of data at
@@ -205,6 +352,9 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
 
     // calculated data
     bool target_is_set {false};
+    bool axis_settings_changed {false}; // Axis methods or limits changed since the target was set
+    bool target_state_is_stale {false}; // Results were taken from the result cache without
+                                        // calculating the floor, fractions, weights or hypercube
     std::vector<double> target;
     std::vector<std::size_t>
         floor_grid_point_coordinates; // coordinates of the grid point <= target
@@ -215,10 +365,10 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
     std::vector<TargetBoundsStatus>
         target_bounds_status; // for each axis, for deciding interpolation vs. extrapolation;
     std::vector<Method> methods;
-    std::vector<Method> previous_methods;
     std::vector<std::vector<short>> hypercube; // A minimal set of indices near the target needed to
                                                // perform interpolation calculations.
-    bool reset_hypercube {false};
+    std::vector<unsigned> hypercube_axis_vertices; // For each axis, bits set for the vertex
+                                                   // offsets (-1, 0, 1, 2) in the hypercube
     std::vector<std::vector<double>>
         weighting_factors;       // weights of hypercube neighbor grid point data used
                                  // to calculate the value at the target
@@ -228,11 +378,39 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
     std::vector<std::vector<double>> cubic_slope_coefficients;
 
     std::vector<std::vector<double>> hypercube_grid_point_data;
+    std::pair<std::size_t, std::size_t> gathered_hypercube_key {
+        SIZE_MAX, 0u}; // (floor grid point index, hypercube size hash) of hypercube_grid_point_data
     std::vector<double> hypercube_weights;
+    std::vector<std::vector<double>>
+        partial_results; // For each vertex offset (-1, 0, 1, 2) along partial_results_axis, the
+                         // hypercube data weighted along all other axes
+    std::size_t partial_results_axis {0u}; // number_of_grid_axes when partial_results is not set
+
+    HypercubeCache hypercube_cache;
+
+    // Used instead of hypercube_cache when enabled. Copies (e.g., batch evaluators) share it until
+    // their grid point data changes.
+    std::shared_ptr<SharedHypercubeCache> shared_hypercube_cache;
+    std::size_t maximum_shared_hypercube_cache_memory_size {0u};
+
+    std::vector<std::size_t> simplex_axes; // Axes interpolated with simplex at the target, ordered
+                                           // by descending floor-to-ceiling fraction (when there
+                                           // are at least two)
+    std::vector<double> simplex_weights; // Weight of each vertex along the simplex path (by the
+                                         // number of simplex axes past their floor)
+    std::vector<std::size_t>
+        simplex_grid_point_index_steps; // Grid point index increment of each step along the path
+    bool hypercube_is_simplicial {false}; // The hypercube holds the vertices of the other axes,
+                                          // each combined with the simplex path (not gathered or
+                                          // cached)
+
+    std::size_t hypercube_size_hash {0u}; // hypercube_axis_vertices packed into 4 bits per axis
+    static constexpr std::size_t maximum_number_of_hashed_axes {
+        sizeof(std::size_t) * 2u}; // Hypercubes of more axes are not cached
 
-    std::map<std::pair<std::size_t, std::size_t>, std::vector<std::vector<double>>> hypercube_cache;
+    std::size_t minimum_targets_per_task {512u}; // Smaller batches are evaluated serially
 
-    std::size_t hypercube_size_hash {0u};
+    ResultCache result_cache;
 
     // Internal methods
     std::size_t get_grid_point_index_relative(const std::vector<std::size_t>& coordinates,
@@ -242,24 +420,140 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
 
     void set_axes_parent_pointers();
 
+    std::vector<GridPointDataSet>& get_writable_grid_point_data_sets();
+
+    void compress_grid_point_data();
+
+    void decompress_grid_point_data();
+
+    void restore_grid_point_data_compression();
+
+    const double* get_decoded_grid_point_data(std::size_t grid_point_index);
+
+    const double* get_paged_grid_point_data(std::size_t grid_point_index);
+
+    void release_paged_blocks();
+
+    [[nodiscard]] std::vector<std::uint64_t>
+    get_target_block_indices(const double* targets, std::size_t number_of_targets) const;
+
+    // Interpolator of a subset of grid point coordinates along each axis (same axis settings)
+    [[nodiscard]] RegularGridInterpolatorImplementation
+    get_subgrid_interpolator(const std::vector<std::vector<std::size_t>>& axis_coordinates,
+                             const std::vector<std::vector<double>>& row_major_data) const;
+
+    // Maximum absolute difference, for each data set, between the subgrid interpolator and the
+    // grid point data at the grid points within the (inclusive) coordinate ranges
+    [[nodiscard]] std::vector<double> get_subgrid_interpolator_errors(
+        RegularGridInterpolatorImplementation& subgrid_interpolator,
+        const std::vector<std::vector<double>>& row_major_data,
+        const std::vector<std::pair<std::size_t, std::size_t>>& coordinate_ranges) const;
+
+    void check_grid_point_data_is_in_memory(const std::string& action_description) const
+    {
+        if (paged_grid_point_data) {
+            send_error(fmt::format("Unable to {}. Grid point data is paged from a file.",
+                                   action_description));
+        }
+        if (shared_table) {
+            send_error(fmt::format("Unable to {}. Grid point data is attached from a shared table.",
+                                   action_description));
+        }
+    }
+
+    void set_grid_point_data_layout_step_sizes(std::size_t block_length);
+
+    // Replaces grid point data in memory (with only the names of the external data sets)
+    void set_external_grid_point_data_sets(const std::vector<std::string>& data_set_names);
+
+    [[nodiscard]] std::vector<double>
+    arrange_grid_point_data(const std::vector<double>& row_major_data) const;
+
+    void increment_grid_point_coordinates(std::vector<std::size_t>& coordinates) const;
+
     void check_grid_point_data_set_size(const GridPointDataSet& grid_point_data_set);
 
     void calculate_floor_to_ceiling_fractions();
 
+    void calculate_axis_floor_to_ceiling_fraction(std::size_t axis_index);
+
     void consolidate_methods();
 
+    void consolidate_axis_method(std::size_t axis_index);
+
+    [[nodiscard]] Method get_axis_interpolation_method(std::size_t axis_index) const;
+
+    [[nodiscard]] Method get_axis_extrapolation_method(std::size_t axis_index) const;
+
     void calculate_interpolation_coefficients();
 
-    void set_hypercube(std::vector<Method> methods);
+    void calculate_axis_interpolation_coefficients(std::size_t axis_index);
+
+    // (grid point coordinate, weighting factor) pairs along an axis
+    using AxisWeights = std::vector<std::pair<std::size_t, double>>;
+
+    // Weights at an axis value, as if it were part of the target (which must be set)
+    AxisWeights get_axis_weights(std::size_t axis_index, double axis_value);
+
+    // Weights of the integral along an axis over a range
+    AxisWeights get_axis_integral_weights(std::size_t axis_index, std::pair<double, double> range);
+
+    // Sums the grid point data weighted along the contracted axes, for each grid point of the
+    // other axes (in row-major order)
+    std::vector<GridPointDataSet>
+    contract_grid_point_data(const std::map<std::size_t, AxisWeights>& contracted_axis_weights);
+
+    void set_hypercube();
+
+    // Orders simplex_axes and sets the weights and grid point index steps along the simplex path
+    void set_simplex_path();
+
+    // From the floor to the ceiling (zero for single-point axes)
+    [[nodiscard]] std::size_t get_axis_grid_point_index_step(std::size_t axis_index) const;
+
+    [[nodiscard]] std::size_t get_number_of_simplex_axes() const;
 
     void set_hypercube_grid_point_data();
 
+    [[nodiscard]] std::size_t get_hypercube_cache_entry_memory_size() const;
+
+    // Values in the largest hypercube with the current interpolation methods
+    [[nodiscard]] std::size_t get_maximum_hypercube_entry_size() const;
+
+    void reset_shared_hypercube_cache();
+
+    // Without use_inexact_result_cache, the result cache is only used if it is exact
+    void set_target(const std::vector<double>& target, bool use_inexact_result_cache);
+
+    [[nodiscard]] bool is_beyond_extrapolation_limits() const;
+
+    void update_target_state();
+
+    void clear_caches();
+
     void set_results();
 
+    void set_simplex_results();
+
+    void set_partial_results(std::size_t axis_index);
+
+    void
+    evaluate_targets(const double* targets, std::size_t number_of_targets, double* results_out);
+
     void set_floor_grid_point_coordinates();
 
     void set_axis_floor_grid_point_index(std::size_t axis_index);
 
+    void check_target_size(std::size_t target_size) const
+    {
+        if (target_size != number_of_grid_axes) {
+            send_error(
+                fmt::format("Target (size={}) and grid (size={}) do not have the same dimensions.",
+                            target_size,
+                            number_of_grid_axes));
+        }
+    }
+
     void check_axis_index(std::size_t axis_index, const std::string& action_description) const
     {
         if (axis_index > number_of_grid_axes - 1) {
@@ -284,11 +578,12 @@ class RegularGridInterpolatorImplementation : public Courier::Sender {
     }
 };
 
-std::vector<GridAxis> construct_grid_axes(const std::vector<std::vector<double>>& grid,
+// Vectors are moved into the axes and data sets
+std::vector<GridAxis> construct_grid_axes(std::vector<std::vector<double>> grid,
                                           const std::shared_ptr<Courier::Courier>& courier_in);
 
 std::vector<GridPointDataSet>
-construct_grid_point_data_sets(const std::vector<std::vector<double>>& grid_point_data_sets);
+construct_grid_point_data_sets(std::vector<std::vector<double>> grid_point_data_sets);
 
 inline double compute_fraction(const double x, const double start, const double end)
 {
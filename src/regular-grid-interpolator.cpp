@@ -13,13 +13,13 @@
 
 namespace Btwxt {
 
-std::vector<GridAxis> construct_grid_axes(const std::vector<std::vector<double>>& grid_axis_vectors,
+std::vector<GridAxis> construct_grid_axes(std::vector<std::vector<double>> grid_axis_vectors,
                                           const std::shared_ptr<Courier::Courier>& courier_in)
 {
     std::vector<GridAxis> grid_axes;
     grid_axes.reserve(grid_axis_vectors.size());
-    for (const auto& axis : grid_axis_vectors) {
-        grid_axes.emplace_back(axis,
+    for (auto& axis : grid_axis_vectors) {
+        grid_axes.emplace_back(std::move(axis),
                                InterpolationMethod::linear,
                                ExtrapolationMethod::constant,
                                std::pair<double, double> {-DBL_MAX, DBL_MAX},
@@ -30,13 +30,14 @@ std::vector<GridAxis> construct_grid_axes(const std::vector<std::vector<double>>
 }
 
 std::vector<GridPointDataSet>
-construct_grid_point_data_sets(const std::vector<std::vector<double>>& grid_point_data_vectors)
+construct_grid_point_data_sets(std::vector<std::vector<double>> grid_point_data_vectors)
 {
     std::vector<GridPointDataSet> grid_point_data_sets;
     grid_point_data_sets.reserve(grid_point_data_vectors.size());
-    for (const auto& grid_point_data_set : grid_point_data_vectors) {
+    for (auto& grid_point_data_set : grid_point_data_vectors) {
         grid_point_data_sets.emplace_back(
-            grid_point_data_set, fmt::format("Data Set {}", grid_point_data_sets.size() + 1));
+            std::move(grid_point_data_set),
+            fmt::format("Data Set {}", grid_point_data_sets.size() + 1));
     }
     return grid_point_data_sets;
 }
@@ -46,10 +47,10 @@ construct_grid_point_data_sets(const std::vector<std::vector<double>>& grid_poin
 RegularGridInterpolator::RegularGridInterpolator() = default;
 
 RegularGridInterpolator::RegularGridInterpolator(
-    const std::vector<std::vector<double>>& grid_axis_vectors,
+    std::vector<std::vector<double>> grid_axis_vectors,
     std::string name,
     const std::shared_ptr<Courier::Courier>& courier)
-    : RegularGridInterpolator(construct_grid_axes(grid_axis_vectors, courier),
+    : RegularGridInterpolator(construct_grid_axes(std::move(grid_axis_vectors), courier),
                               std::vector<GridPointDataSet>(),
                               std::move(name),
                               courier)
@@ -57,72 +58,80 @@ RegularGridInterpolator::RegularGridInterpolator(
 }
 
 RegularGridInterpolator::RegularGridInterpolator(
-    const std::vector<std::vector<double>>& grid_axis_vectors,
-    const std::vector<std::vector<double>>& grid_point_data_vectors,
+    std::vector<std::vector<double>> grid_axis_vectors,
+    std::vector<std::vector<double>> grid_point_data_vectors,
     std::string name,
     const std::shared_ptr<Courier::Courier>& courier)
-    : RegularGridInterpolator(construct_grid_axes(grid_axis_vectors, courier),
-                              construct_grid_point_data_sets(grid_point_data_vectors),
+    : RegularGridInterpolator(construct_grid_axes(std::move(grid_axis_vectors), courier),
+                              construct_grid_point_data_sets(std::move(grid_point_data_vectors)),
                               std::move(name),
                               courier)
 {
 }
 
-RegularGridInterpolator::RegularGridInterpolator(const std::vector<GridAxis>& grid,
+RegularGridInterpolator::RegularGridInterpolator(std::vector<GridAxis> grid,
                                                  std::string name,
                                                  const std::shared_ptr<Courier::Courier>& courier)
-    : implementation(
-          std::make_unique<RegularGridInterpolatorImplementation>(grid, std::move(name), courier))
+    : implementation(std::make_unique<RegularGridInterpolatorImplementation>(
+          std::move(grid), std::move(name), courier))
 {
 }
 
 RegularGridInterpolator::RegularGridInterpolator(
-    const std::vector<GridAxis>& grid_axes,
-    const std::vector<std::vector<double>>& grid_point_data_vectors,
+    std::vector<GridAxis> grid_axes,
+    std::vector<std::vector<double>> grid_point_data_vectors,
     std::string name,
     const std::shared_ptr<Courier::Courier>& courier)
     : implementation(std::make_unique<RegularGridInterpolatorImplementation>(
-          grid_axes,
-          construct_grid_point_data_sets(grid_point_data_vectors),
+          std::move(grid_axes),
+          construct_grid_point_data_sets(std::move(grid_point_data_vectors)),
           std::move(name),
           courier))
 {
 }
 
 RegularGridInterpolator::RegularGridInterpolator(
-    const std::vector<std::vector<double>>& grid_axis_vectors,
-    const std::vector<GridPointDataSet>& grid_point_data_sets,
+    std::vector<std::vector<double>> grid_axis_vectors,
+    std::vector<GridPointDataSet> grid_point_data_sets,
     std::string name,
     const std::shared_ptr<Courier::Courier>& courier)
     : implementation(std::make_unique<RegularGridInterpolatorImplementation>(
-          construct_grid_axes(grid_axis_vectors, courier),
-          grid_point_data_sets,
+          construct_grid_axes(std::move(grid_axis_vectors), courier),
+          std::move(grid_point_data_sets),
           std::move(name),
           courier))
 {
 }
 
 RegularGridInterpolator::RegularGridInterpolator(
-    const std::vector<GridAxis>& grid_axes,
-    const std::vector<GridPointDataSet>& grid_point_data_sets,
+    std::vector<GridAxis> grid_axes,
+    std::vector<GridPointDataSet> grid_point_data_sets,
     std::string name,
     const std::shared_ptr<Courier::Courier>& courier)
     : implementation(std::make_unique<RegularGridInterpolatorImplementation>(
-          grid_axes, grid_point_data_sets, std::move(name), courier))
+          std::move(grid_axes), std::move(grid_point_data_sets), std::move(name), courier))
+{
+}
+
+RegularGridInterpolator::RegularGridInterpolator(
+    std::unique_ptr<RegularGridInterpolatorImplementation> implementation_in)
+    : implementation(std::move(implementation_in))
 {
 }
 
 RegularGridInterpolator::~RegularGridInterpolator() = default;
 
 RegularGridInterpolator::RegularGridInterpolator(const RegularGridInterpolator& source)
+    : implementation(
+          source.implementation
+              ? std::make_unique<RegularGridInterpolatorImplementation>(*source.implementation)
+              : nullptr)
 {
-    *this = source;
-    this->implementation =
-        source.implementation
-            ? std::make_unique<RegularGridInterpolatorImplementation>(*source.implementation)
-            : nullptr;
 }
 
+RegularGridInterpolator::RegularGridInterpolator(RegularGridInterpolator&& source) noexcept =
+    default;
+
 RegularGridInterpolator::RegularGridInterpolator(const RegularGridInterpolator& source,
                                                  const std::shared_ptr<Courier::Courier>& courier)
     : RegularGridInterpolator(source)
@@ -139,10 +148,13 @@ RegularGridInterpolator& RegularGridInterpolator::operator=(const RegularGridInt
     return *this;
 }
 
+RegularGridInterpolator&
+RegularGridInterpolator::operator=(RegularGridInterpolator&& source) noexcept = default;
+
 // Public manipulation methods
 
 std::size_t
-RegularGridInterpolator::add_grid_point_data_set(const std::vector<double>& grid_point_data_vector,
+RegularGridInterpolator::add_grid_point_data_set(std::vector<double> grid_point_data_vector,
                                                  const std::string& name)
 {
     std::string resolved_name {name};
@@ -150,13 +162,13 @@ RegularGridInterpolator::add_grid_point_data_set(const std::vector<double>& grid
         resolved_name =
             fmt::format("Data Set {}", implementation->get_number_of_grid_point_data_sets());
     }
-    return add_grid_point_data_set(GridPointDataSet(grid_point_data_vector, resolved_name));
+    return add_grid_point_data_set(
+        GridPointDataSet(std::move(grid_point_data_vector), std::move(resolved_name)));
 }
 
-std::size_t
-RegularGridInterpolator::add_grid_point_data_set(const GridPointDataSet& grid_point_data_set)
+std::size_t RegularGridInterpolator::add_grid_point_data_set(GridPointDataSet grid_point_data_set)
 {
-    return implementation->add_grid_point_data_set(grid_point_data_set);
+    return implementation->add_grid_point_data_set(std::move(grid_point_data_set));
 }
 
 void RegularGridInterpolator::set_axis_extrapolation_method(const std::size_t axis_index,
@@ -177,6 +189,101 @@ void RegularGridInterpolator::set_axis_extrapolation_limits(
     implementation->set_axis_extrapolation_limits(axis_index, extrapolation_limits);
 }
 
+void RegularGridInterpolator::set_grid_point_data_layout(GridPointDataLayout layout,
+                                                         std::size_t block_length)
+{
+    implementation->set_grid_point_data_layout(layout, block_length);
+}
+
+void RegularGridInterpolator::set_grid_point_data_compression(double maximum_error,
+                                                              std::size_t block_size)
+{
+    implementation->set_grid_point_data_compression(maximum_error, block_size);
+}
+
+void RegularGridInterpolator::clear_grid_point_data_compression()
+{
+    implementation->clear_grid_point_data_compression();
+}
+
+double RegularGridInterpolator::get_grid_point_data_compression_ratio()
+{
+    return implementation->get_grid_point_data_compression_ratio();
+}
+
+void RegularGridInterpolator::set_grid_point_data_file(const std::string& path,
+                                                       std::size_t maximum_resident_size)
+{
+    implementation->set_grid_point_data_file(path, maximum_resident_size);
+}
+
+GridPointDataPagingStatistics RegularGridInterpolator::get_grid_point_data_paging_statistics()
+{
+    return implementation->get_grid_point_data_paging_statistics();
+}
+
+void RegularGridInterpolator::publish_shared_table(const std::string& table_name,
+                                                   SharedTableStorage storage) const
+{
+    implementation->publish_shared_table(table_name, storage);
+}
+
+RegularGridInterpolator
+RegularGridInterpolator::attach_shared_table(const std::string& table_name,
+                                             SharedTableStorage storage,
+                                             std::string name,
+                                             const std::shared_ptr<Courier::Courier>& courier)
+{
+    auto shared_table = std::make_shared<const SharedTable>(table_name, storage, courier);
+    auto attached_implementation = std::make_unique<RegularGridInterpolatorImplementation>(
+        shared_table->get_grid_axes(), std::move(name), courier);
+    attached_implementation->set_shared_table(std::move(shared_table));
+    return RegularGridInterpolator(std::move(attached_implementation));
+}
+
+bool RegularGridInterpolator::remove_shared_table(const std::string& table_name,
+                                                  SharedTableStorage storage)
+{
+    return Btwxt::remove_shared_table(table_name, storage);
+}
+
+RegularGridInterpolator RegularGridInterpolator::get_reduced_interpolator(
+    const std::map<std::size_t, double>& fixed_axis_values) const
+{
+    return RegularGridInterpolator(implementation->get_reduced_interpolator(fixed_axis_values));
+}
+
+InverseSolution RegularGridInterpolator::solve_for_axis_value(const std::vector<double>& target,
+                                                              std::size_t axis_index,
+                                                              std::size_t data_set_index,
+                                                              double result) const
+{
+    return implementation->solve_for_axis_value(target, axis_index, data_set_index, result);
+}
+
+std::vector<double> RegularGridInterpolator::get_integral(
+    const std::vector<double>& target,
+    const std::map<std::size_t, std::pair<double, double>>& axis_ranges) const
+{
+    return implementation->integrate(target, axis_ranges, false);
+}
+
+std::vector<double> RegularGridInterpolator::get_mean(
+    const std::vector<double>& target,
+    const std::map<std::size_t, std::pair<double, double>>& axis_ranges) const
+{
+    return implementation->integrate(target, axis_ranges, true);
+}
+
+CoarsenedInterpolator RegularGridInterpolator::get_coarsened_interpolator(double tolerance) const
+{
+    std::vector<double> maximum_errors;
+    auto coarsened_implementation =
+        implementation->get_coarsened_interpolator(tolerance, maximum_errors);
+    return {RegularGridInterpolator(std::move(coarsened_implementation)),
+            std::move(maximum_errors)};
+}
+
 std::size_t RegularGridInterpolator::get_number_of_dimensions()
 {
     return implementation->get_number_of_grid_axes();
@@ -202,6 +309,11 @@ const GridPointDataSet& RegularGridInterpolator::get_grid_point_data_set(std::si
     return implementation->get_grid_point_data_set(data_set_index);
 }
 
+GridPointDataLayout RegularGridInterpolator::get_grid_point_data_layout()
+{
+    return implementation->get_grid_point_data_layout();
+}
+
 // Public normalization methods
 double RegularGridInterpolator::normalize_grid_point_data_set_at_target(
     std::size_t data_set_index, const std::vector<double>& target, const double scalar)
@@ -237,6 +349,11 @@ void RegularGridInterpolator::set_target(const std::vector<double>& target)
     implementation->set_target(target);
 }
 
+void RegularGridInterpolator::set_target_axis(std::size_t axis_index, double value)
+{
+    implementation->set_target_axis(axis_index, value);
+}
+
 double RegularGridInterpolator::get_value_at_target(const std::vector<double>& target,
                                                     std::size_t data_set_index)
 {
@@ -259,6 +376,76 @@ std::vector<double> RegularGridInterpolator::get_values_at_target()
     return implementation->get_results();
 }
 
+std::vector<std::vector<double>>
+RegularGridInterpolator::get_values_at_targets(const std::vector<std::vector<double>>& targets,
+                                               const TaskExecutor& executor)
+{
+    return implementation->get_results(targets, executor);
+}
+
+void RegularGridInterpolator::get_values_at_targets(const double* targets,
+                                                    std::size_t number_of_targets,
+                                                    double* results,
+                                                    const TaskExecutor& executor)
+{
+    implementation->get_results(targets, number_of_targets, results, executor);
+}
+
+void RegularGridInterpolator::get_values_at_target_columns(const double* const* target_columns,
+                                                           std::size_t number_of_targets,
+                                                           double* const* result_columns)
+{
+    implementation->get_column_results(target_columns, number_of_targets, result_columns);
+}
+
+std::vector<std::vector<double>> RegularGridInterpolator::get_values_at_target_columns(
+    const std::vector<std::vector<double>>& target_columns)
+{
+    return implementation->get_column_results(target_columns);
+}
+
+void RegularGridInterpolator::set_minimum_targets_per_task(std::size_t minimum_targets_per_task)
+{
+    implementation->set_minimum_targets_per_task(minimum_targets_per_task);
+}
+
+void RegularGridInterpolator::enable_result_cache(double tolerance, std::size_t maximum_memory_size)
+{
+    implementation->enable_result_cache(tolerance, maximum_memory_size);
+}
+
+void RegularGridInterpolator::disable_result_cache() { implementation->disable_result_cache(); }
+
+void RegularGridInterpolator::set_hypercube_cache_memory_budget(std::size_t maximum_memory_size)
+{
+    implementation->set_hypercube_cache_memory_budget(maximum_memory_size);
+}
+
+void RegularGridInterpolator::enable_shared_hypercube_cache(std::size_t maximum_memory_size)
+{
+    implementation->enable_shared_hypercube_cache(maximum_memory_size);
+}
+
+void RegularGridInterpolator::disable_shared_hypercube_cache()
+{
+    implementation->disable_shared_hypercube_cache();
+}
+
+MemoryUsage RegularGridInterpolator::get_memory_usage() const
+{
+    return implementation->get_memory_usage();
+}
+
+std::vector<EvaluationCost> RegularGridInterpolator::get_evaluation_costs() const
+{
+    return implementation->get_evaluation_costs();
+}
+
+ResultCacheStatistics RegularGridInterpolator::get_result_cache_statistics() const
+{
+    return implementation->get_result_cache_statistics();
+}
+
 std::vector<std::size_t> RegularGridInterpolator::get_neighboring_indices_at_target() const
 {
     return implementation->get_neighboring_indices_at_target();
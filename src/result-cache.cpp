@@ -0,0 +1,134 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <cmath>
+#include <functional>
+
+// btwxt
+#include "result-cache.h"
+
+namespace Btwxt {
+
+ResultCache::ResultCache(const ResultCache& source)
+    : enabled(source.enabled)
+    , tolerance(source.tolerance)
+    , maximum_memory_size(source.maximum_memory_size)
+{
+}
+
+ResultCache& ResultCache::operator=(const ResultCache& source)
+{
+    if (this != &source) {
+        clear();
+        enabled = source.enabled;
+        tolerance = source.tolerance;
+        maximum_memory_size = source.maximum_memory_size;
+        number_of_hits = 0u;
+        number_of_misses = 0u;
+        number_of_evictions = 0u;
+    }
+    return *this;
+}
+
+void ResultCache::enable(double tolerance_in, std::size_t maximum_memory_size_in)
+{
+    if (tolerance_in != tolerance) {
+        clear(); // Existing keys were quantized differently
+    }
+    enabled = true;
+    tolerance = tolerance_in;
+    maximum_memory_size = maximum_memory_size_in;
+    while (memory_size > maximum_memory_size) {
+        evict_least_recently_used();
+    }
+}
+
+void ResultCache::disable()
+{
+    clear();
+    enabled = false;
+}
+
+const ResultCache::Entry* ResultCache::find(const std::vector<double>& target)
+{
+    set_key(target);
+    auto entry_iterator = entry_map.find(temporary_key);
+    if (entry_iterator == entry_map.end()) {
+        ++number_of_misses;
+        return nullptr;
+    }
+    ++number_of_hits;
+    entries.splice(entries.begin(), entries, entry_iterator->second);
+    return &entries.front();
+}
+
+void ResultCache::insert(const std::vector<double>& target, const std::vector<double>& results)
+{
+    set_key(target);
+    if (entry_map.count(temporary_key)) {
+        return;
+    }
+    Entry entry {temporary_key, results};
+    std::size_t entry_memory_size = get_entry_memory_size(entry);
+    if (entry_memory_size > maximum_memory_size) {
+        return;
+    }
+    while (memory_size + entry_memory_size > maximum_memory_size) {
+        evict_least_recently_used();
+    }
+    entries.push_front(std::move(entry));
+    entry_map.emplace(entries.front().key, entries.begin());
+    memory_size += entry_memory_size;
+}
+
+void ResultCache::clear()
+{
+    entry_map.clear();
+    entries.clear();
+    memory_size = 0u;
+}
+
+ResultCacheStatistics ResultCache::get_statistics() const
+{
+    return {number_of_hits, number_of_misses, number_of_evictions, entries.size(), memory_size};
+}
+
+std::size_t ResultCache::KeyHash::operator()(const std::vector<double>& key) const
+{
+    std::size_t hash = key.size();
+    for (auto value : key) {
+        hash ^= std::hash<double> {}(value) + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u);
+    }
+    return hash;
+}
+
+void ResultCache::set_key(const std::vector<double>& target)
+{
+    // Targets are identified by the nearest multiple of the tolerance along each axis
+    temporary_key.resize(target.size());
+    for (std::size_t axis_index = 0; axis_index < target.size(); ++axis_index) {
+        double value = tolerance > 0.0 ? std::round(target[axis_index] / tolerance)
+                                       : target[axis_index];
+        temporary_key[axis_index] = value + 0.0; // Treat -0.0 as 0.0
+    }
+}
+
+std::size_t ResultCache::get_entry_memory_size(const Entry& entry)
+{
+    // Estimated: list node, hash map node (with its copy of the key) and vector contents
+    return sizeof(Entry) + 2u * sizeof(void*) + sizeof(std::vector<double>) +
+           sizeof(std::list<Entry>::iterator) + 2u * sizeof(void*) +
+           2u * entry.key.size() * sizeof(double) + entry.results.size() * sizeof(double);
+}
+
+void ResultCache::evict_least_recently_used()
+{
+    const Entry& entry = entries.back();
+    memory_size -= get_entry_memory_size(entry);
+    entry_map.erase(entry.key);
+    entries.pop_back();
+    ++number_of_evictions;
+}
+
+} // namespace Btwxt
@@ -0,0 +1,73 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// btwxt
+#include <btwxt/regular-grid-interpolator.h>
+
+namespace Btwxt {
+
+class ResultCache {
+    // Bounded, least-recently-used cache of interpolation results keyed on targets quantized to a
+    // tolerance. Copies keep the settings but start empty.
+  public:
+    struct Entry {
+        std::vector<double> key;
+        std::vector<double> results;
+    };
+
+    ResultCache() = default;
+
+    ResultCache(const ResultCache& source);
+
+    ResultCache& operator=(const ResultCache& source);
+
+    void enable(double tolerance_in, std::size_t maximum_memory_size_in);
+
+    void disable();
+
+    [[nodiscard]] bool is_enabled() const { return enabled; }
+
+    // Whether only identical targets share results (tolerance of zero)
+    [[nodiscard]] bool is_exact() const { return tolerance == 0.0; }
+
+    // Returns the entry for the target (and marks it most recently used), or nullptr
+    const Entry* find(const std::vector<double>& target);
+
+    void insert(const std::vector<double>& target, const std::vector<double>& results);
+
+    // Removes all entries (statistics are kept)
+    void clear();
+
+    [[nodiscard]] ResultCacheStatistics get_statistics() const;
+
+  private:
+    struct KeyHash {
+        std::size_t operator()(const std::vector<double>& key) const;
+    };
+
+    bool enabled {false};
+    double tolerance {0.0};
+    std::size_t maximum_memory_size {0u};
+    std::size_t memory_size {0u};
+    std::size_t number_of_hits {0u};
+    std::size_t number_of_misses {0u};
+    std::size_t number_of_evictions {0u};
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<std::vector<double>, std::list<Entry>::iterator, KeyHash> entry_map;
+    std::vector<double> temporary_key; // Reused to avoid allocating on every lookup
+
+    void set_key(const std::vector<double>& target);
+
+    [[nodiscard]] static std::size_t get_entry_memory_size(const Entry& entry);
+
+    void evict_least_recently_used();
+};
+
+} // namespace Btwxt
@@ -0,0 +1,120 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// btwxt
+#include "shared-hypercube-cache.h"
+
+namespace Btwxt {
+
+SharedHypercubeCache::SharedHypercubeCache(std::size_t maximum_memory_size,
+                                           std::size_t maximum_entry_size_in)
+    : maximum_entry_size(maximum_entry_size_in)
+{
+    const std::size_t slot_memory_size =
+        sizeof(Slot) + maximum_entry_size * sizeof(std::atomic<double>);
+    const std::size_t maximum_number_of_slots = maximum_memory_size / slot_memory_size;
+    if (maximum_number_of_slots == 0u) {
+        return;
+    }
+    number_of_slots = 1u;
+    while (number_of_slots <= maximum_number_of_slots / 2u) {
+        number_of_slots *= 2u;
+    }
+    slots = std::make_unique<Slot[]>(number_of_slots);
+    values = std::make_unique<std::atomic<double>[]>(number_of_slots * maximum_entry_size);
+}
+
+std::size_t SharedHypercubeCache::get_slot_index(std::uint64_t floor_grid_point_index,
+                                                 std::uint64_t hypercube_size_hash) const
+{
+    // Mixes the key so that neighboring cells and hypercube shapes spread across slots
+    std::uint64_t hash = floor_grid_point_index * 0x9E3779B97F4A7C15u ^ hypercube_size_hash;
+    hash ^= hash >> 31u;
+    hash *= 0xBF58476D1CE4E5B9u;
+    hash ^= hash >> 29u;
+    return static_cast<std::size_t>(hash & (number_of_slots - 1u));
+}
+
+bool SharedHypercubeCache::find(std::uint64_t floor_grid_point_index,
+                                std::uint64_t hypercube_size_hash,
+                                std::size_t number_of_data_sets,
+                                std::vector<std::vector<double>>& hypercube_grid_point_data) const
+{
+    if (number_of_slots == 0u || hypercube_grid_point_data.empty() ||
+        hypercube_grid_point_data.size() * number_of_data_sets > maximum_entry_size) {
+        return false;
+    }
+    const Slot& slot = slots[get_slot_index(floor_grid_point_index, hypercube_size_hash)];
+    const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence % 2u == 1u) {
+        return false; // Being written
+    }
+    if (slot.floor_grid_point_index.load(std::memory_order_relaxed) != floor_grid_point_index ||
+        slot.hypercube_size_hash.load(std::memory_order_relaxed) != hypercube_size_hash ||
+        slot.number_of_values.load(std::memory_order_relaxed) !=
+            hypercube_grid_point_data.size() * number_of_data_sets) {
+        return false;
+    }
+    const std::atomic<double>* slot_values =
+        values.get() + (&slot - slots.get()) * maximum_entry_size;
+    for (auto& vertex_grid_point_data : hypercube_grid_point_data) {
+        vertex_grid_point_data.resize(number_of_data_sets);
+        for (double& value : vertex_grid_point_data) {
+            value = (slot_values++)->load(std::memory_order_relaxed);
+        }
+    }
+    // The copy is only valid if no writer claimed the slot while it was read
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+void SharedHypercubeCache::insert(std::uint64_t floor_grid_point_index,
+                                  std::uint64_t hypercube_size_hash,
+                                  const std::vector<std::vector<double>>& hypercube_grid_point_data)
+{
+    if (number_of_slots == 0u || hypercube_grid_point_data.empty()) {
+        return;
+    }
+    const std::size_t number_of_values =
+        hypercube_grid_point_data.size() * hypercube_grid_point_data[0].size();
+    if (number_of_values > maximum_entry_size) {
+        return;
+    }
+    Slot& slot = slots[get_slot_index(floor_grid_point_index, hypercube_size_hash)];
+    std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    if (sequence % 2u == 1u ||
+        !slot.sequence.compare_exchange_strong(
+            sequence, sequence + 1u, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return; // Another writer holds the slot
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.floor_grid_point_index.store(floor_grid_point_index, std::memory_order_relaxed);
+    slot.hypercube_size_hash.store(hypercube_size_hash, std::memory_order_relaxed);
+    slot.number_of_values.store(number_of_values, std::memory_order_relaxed);
+    std::atomic<double>* slot_values = values.get() + (&slot - slots.get()) * maximum_entry_size;
+    for (const auto& vertex_grid_point_data : hypercube_grid_point_data) {
+        for (double value : vertex_grid_point_data) {
+            (slot_values++)->store(value, std::memory_order_relaxed);
+        }
+    }
+    slot.sequence.store(sequence + 2u, std::memory_order_release);
+}
+
+std::size_t SharedHypercubeCache::get_number_of_entries() const
+{
+    std::size_t number_of_entries = 0u;
+    for (std::size_t slot_index = 0; slot_index < number_of_slots; ++slot_index) {
+        if (slots[slot_index].sequence.load(std::memory_order_relaxed) >= 2u) {
+            ++number_of_entries;
+        }
+    }
+    return number_of_entries;
+}
+
+std::size_t SharedHypercubeCache::get_memory_size() const
+{
+    return sizeof(SharedHypercubeCache) + number_of_slots * sizeof(Slot) +
+           number_of_slots * maximum_entry_size * sizeof(std::atomic<double>);
+}
+
+} // namespace Btwxt
@@ -0,0 +1,65 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Btwxt {
+
+class SharedHypercubeCache {
+    // Fixed-size, direct-mapped cache of gathered hypercube grid point data, keyed by floor grid
+    // point index and hypercube size hash, that may be used from many threads at once (by every
+    // evaluator of an interpolator). Each slot is guarded by a sequence counter that is odd while
+    // the slot is written:
+    //   - Lookups are lock-free. A reader copies the slot and keeps the copy only if the counter
+    //     was even and unchanged throughout.
+    //   - Insertions never wait. A writer claims a slot by making its counter odd and skips the
+    //     insertion if another writer holds it. An occupied slot is evicted by overwriting it.
+    // Values are stored as relaxed atomics so that concurrent reads and writes are well defined.
+  public:
+    // Slots hold up to maximum_entry_size values. The number of slots is the largest power of two
+    // that fits in maximum_memory_size (possibly zero, in which case nothing is cached).
+    SharedHypercubeCache(std::size_t maximum_memory_size, std::size_t maximum_entry_size_in);
+
+    // Copies the entry into hypercube_grid_point_data (one vector of number_of_data_sets values for
+    // each vertex, already sized for the hypercube) and returns true if it is found
+    bool find(std::uint64_t floor_grid_point_index,
+              std::uint64_t hypercube_size_hash,
+              std::size_t number_of_data_sets,
+              std::vector<std::vector<double>>& hypercube_grid_point_data) const;
+
+    void insert(std::uint64_t floor_grid_point_index,
+                std::uint64_t hypercube_size_hash,
+                const std::vector<std::vector<double>>& hypercube_grid_point_data);
+
+    [[nodiscard]] std::size_t get_maximum_entry_size() const { return maximum_entry_size; }
+
+    [[nodiscard]] std::size_t get_number_of_slots() const { return number_of_slots; }
+
+    [[nodiscard]] std::size_t get_number_of_entries() const;
+
+    [[nodiscard]] std::size_t get_memory_size() const;
+
+  private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence {0u};
+        std::atomic<std::uint64_t> floor_grid_point_index {UINT64_MAX};
+        std::atomic<std::uint64_t> hypercube_size_hash {0u};
+        std::atomic<std::uint64_t> number_of_values {0u};
+    };
+
+    std::size_t maximum_entry_size;
+    std::size_t number_of_slots {0u};
+    std::unique_ptr<Slot[]> slots;
+    std::unique_ptr<std::atomic<double>[]> values; // maximum_entry_size values for each slot
+
+    [[nodiscard]] std::size_t get_slot_index(std::uint64_t floor_grid_point_index,
+                                             std::uint64_t hypercube_size_hash) const;
+};
+
+} // namespace Btwxt
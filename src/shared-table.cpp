@@ -0,0 +1,352 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BTWXT_POSIX_SHARED_TABLES
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// btwxt
+#include "shared-table.h"
+
+namespace Btwxt {
+
+namespace {
+
+void append_uint64(std::vector<std::uint64_t>& words, std::uint64_t value)
+{
+    words.push_back(value);
+}
+
+void append_double(std::vector<std::uint64_t>& words, double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    words.push_back(bits);
+}
+
+void append_name(std::vector<std::uint64_t>& words, const std::string& name)
+{
+    words.push_back(name.size());
+    std::size_t first_word = words.size();
+    words.resize(first_word + (name.size() + 7u) / 8u, 0u);
+    std::memcpy(words.data() + first_word, name.data(), name.size());
+}
+
+class SharedTableReader {
+    // Reads 8-byte values from a mapping, checking that they are within it
+  public:
+    SharedTableReader(const void* mapping, std::size_t mapped_size)
+        : words(static_cast<const std::uint64_t*>(mapping))
+        , number_of_words(mapped_size / sizeof(std::uint64_t))
+    {
+    }
+
+    [[nodiscard]] bool has(std::uint64_t count) const
+    {
+        return count <= number_of_words - position;
+    }
+
+    const std::uint64_t* take(std::uint64_t count)
+    {
+        if (!has(count)) {
+            throw std::out_of_range("shared table");
+        }
+        const std::uint64_t* taken = words + position;
+        position += count;
+        return taken;
+    }
+
+    std::uint64_t read_uint64() { return *take(1u); }
+
+    double read_double()
+    {
+        double value;
+        std::memcpy(&value, take(1u), sizeof(value));
+        return value;
+    }
+
+    std::string read_name()
+    {
+        std::uint64_t length = read_uint64();
+        const auto* characters =
+            reinterpret_cast<const char*>(take(length / 8u + (length % 8u != 0u)));
+        return std::string(characters, length);
+    }
+
+  private:
+    const std::uint64_t* words;
+    std::size_t number_of_words;
+    std::size_t position {0u};
+};
+
+class SharedTableWriter : public Courier::Sender {
+  public:
+    SharedTableWriter(const std::string& name, const std::shared_ptr<Courier::Courier>& courier)
+        : Courier::Sender(name, courier)
+    {
+        class_name = "SharedTable";
+    }
+
+    using Courier::Sender::send_error;
+};
+
+} // namespace
+
+// SharedTable
+
+SharedTable::SharedTable(const std::string& name,
+                         SharedTableStorage storage,
+                         const std::shared_ptr<Courier::Courier>& courier)
+    : Courier::Sender(name, courier)
+{
+    class_name = "SharedTable";
+#ifdef BTWXT_POSIX_SHARED_TABLES
+    int file_descriptor = storage == SharedTableStorage::shared_memory
+                              ? shm_open(name.c_str(), O_RDONLY, 0)
+                              : open(name.c_str(), O_RDONLY);
+    if (file_descriptor < 0) {
+        send_error(fmt::format("Unable to open table ({}).", std::strerror(errno)));
+    }
+    struct stat status {};
+    if (fstat(file_descriptor, &status) != 0 || status.st_size <= 0) {
+        close(file_descriptor);
+        send_error("Unable to read table size.");
+    }
+    mapped_size = static_cast<std::size_t>(status.st_size);
+    mapping = mmap(nullptr, mapped_size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor); // The mapping remains valid
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        send_error(fmt::format("Unable to map table ({}).", std::strerror(errno)));
+    }
+    try {
+        read_header();
+    }
+    catch (const std::out_of_range&) {
+        munmap(mapping, mapped_size);
+        mapping = nullptr;
+        send_error("Table is truncated.");
+    }
+    catch (...) {
+        munmap(mapping, mapped_size);
+        mapping = nullptr;
+        throw;
+    }
+#else
+    (void)storage;
+    send_error("Shared tables are not supported on this platform.");
+#endif
+}
+
+SharedTable::~SharedTable()
+{
+#ifdef BTWXT_POSIX_SHARED_TABLES
+    if (mapping) {
+        munmap(mapping, mapped_size);
+    }
+#endif
+}
+
+void SharedTable::read_header()
+{
+    SharedTableReader reader(mapping, mapped_size);
+    const auto* magic = reader.take(1u);
+    if (*magic == 0u) {
+        send_error("Table is incomplete (it is still being written).");
+    }
+    if (std::memcmp(magic, shared_table_magic, sizeof(shared_table_magic)) != 0) {
+        send_error("Not a shared table.");
+    }
+    // Pairs with the release fence before the writer stores the magic
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t version = reader.read_uint64();
+    if (version != shared_table_version) {
+        send_error(fmt::format("Unsupported table version ({}).", version));
+    }
+    std::uint64_t number_of_axes = reader.read_uint64();
+    std::uint64_t number_of_data_sets = reader.read_uint64();
+    number_of_grid_points = reader.read_uint64();
+    std::uint64_t expected_number_of_grid_points = 1u;
+    for (std::uint64_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        AxisRecord axis_record;
+        axis_record.length = reader.read_uint64();
+        axis_record.interpolation_method =
+            static_cast<InterpolationMethod>(reader.read_uint64());
+        axis_record.extrapolation_method =
+            static_cast<ExtrapolationMethod>(reader.read_uint64());
+        axis_record.extrapolation_limits.first = reader.read_double();
+        axis_record.extrapolation_limits.second = reader.read_double();
+        axis_record.name = reader.read_name();
+        axis_record.values = reinterpret_cast<const double*>(reader.take(axis_record.length));
+        if (axis_record.length != 0u &&
+            expected_number_of_grid_points > UINT64_MAX / axis_record.length) {
+            send_error("Number of grid points of the grid axes is too large.");
+        }
+        expected_number_of_grid_points *= axis_record.length;
+        axis_records.push_back(std::move(axis_record));
+    }
+    for (std::uint64_t data_set_index = 0; data_set_index < number_of_data_sets;
+         ++data_set_index) {
+        data_set_names.push_back(reader.read_name());
+    }
+    if (expected_number_of_grid_points != number_of_grid_points) {
+        send_error(fmt::format("Number of grid points ({}) does not match the grid axes ({}).",
+                               number_of_grid_points,
+                               expected_number_of_grid_points));
+    }
+    if (number_of_data_sets != 0u && number_of_grid_points > UINT64_MAX / number_of_data_sets) {
+        send_error("Number of grid point values is too large.");
+    }
+    grid_point_values = reinterpret_cast<const double*>(
+        reader.take(number_of_grid_points * number_of_data_sets));
+}
+
+std::vector<GridAxis> SharedTable::get_grid_axes() const
+{
+    std::vector<GridAxis> grid_axes;
+    grid_axes.reserve(axis_records.size());
+    for (const auto& axis_record : axis_records) {
+        grid_axes.emplace_back(
+            std::vector<double>(axis_record.values, axis_record.values + axis_record.length),
+            axis_record.interpolation_method,
+            axis_record.extrapolation_method,
+            axis_record.extrapolation_limits,
+            axis_record.name,
+            courier);
+    }
+    return grid_axes;
+}
+
+// Free functions
+
+void write_shared_table(const std::string& name,
+                        SharedTableStorage storage,
+                        const std::vector<GridAxis>& grid_axes,
+                        const std::vector<std::string>& data_set_names,
+                        std::uint64_t number_of_grid_points,
+                        const std::function<std::vector<double>(std::size_t)>& row_major_data,
+                        const std::shared_ptr<Courier::Courier>& courier)
+{
+    SharedTableWriter writer(name, courier);
+    std::vector<std::uint64_t> header;
+    std::uint64_t magic;
+    std::memcpy(&magic, shared_table_magic, sizeof(magic));
+    append_uint64(header, magic);
+    append_uint64(header, shared_table_version);
+    append_uint64(header, grid_axes.size());
+    append_uint64(header, data_set_names.size());
+    append_uint64(header, number_of_grid_points);
+    for (const auto& grid_axis : grid_axes) {
+        const auto& values = grid_axis.get_values();
+        append_uint64(header, values.size());
+        append_uint64(header, static_cast<std::uint64_t>(grid_axis.get_interpolation_method()));
+        append_uint64(header, static_cast<std::uint64_t>(grid_axis.get_extrapolation_method()));
+        append_double(header, grid_axis.get_extrapolation_limits().first);
+        append_double(header, grid_axis.get_extrapolation_limits().second);
+        append_name(header, grid_axis.name);
+        for (double value : values) {
+            append_double(header, value);
+        }
+    }
+    for (const auto& data_set_name : data_set_names) {
+        append_name(header, data_set_name);
+    }
+    const std::size_t header_size = header.size() * sizeof(std::uint64_t);
+    const std::size_t table_size =
+        header_size + number_of_grid_points * data_set_names.size() * sizeof(double);
+
+#ifdef BTWXT_POSIX_SHARED_TABLES
+    // Replaced tables remain mapped by processes already attached to them. Files are written
+    // under a temporary name and then renamed, so no process attaches to a partial table. Shared
+    // memory objects cannot be renamed, so the magic is stored last: until then, it is zero and
+    // processes attaching to the table find it incomplete.
+    const std::string temporary_path = name + ".partial";
+    int file_descriptor;
+    if (storage == SharedTableStorage::shared_memory) {
+        shm_unlink(name.c_str());
+        file_descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    else {
+        file_descriptor = open(temporary_path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    }
+    if (file_descriptor < 0) {
+        writer.send_error(fmt::format("Unable to create table ({}).", std::strerror(errno)));
+    }
+    void* mapping = MAP_FAILED;
+    if (ftruncate(file_descriptor, static_cast<off_t>(table_size)) == 0) {
+        mapping =
+            mmap(nullptr, table_size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    }
+    close(file_descriptor);
+    auto discard = [&]() {
+        if (storage == SharedTableStorage::shared_memory) {
+            shm_unlink(name.c_str());
+        }
+        else {
+            std::remove(temporary_path.c_str());
+        }
+    };
+    if (mapping == MAP_FAILED) {
+        discard();
+        writer.send_error(fmt::format("Unable to map table ({}).", std::strerror(errno)));
+    }
+    std::memcpy(static_cast<char*>(mapping) + sizeof(magic),
+                header.data() + 1u,
+                header_size - sizeof(magic));
+    auto* grid_point_values =
+        reinterpret_cast<double*>(static_cast<char*>(mapping) + header_size);
+    const std::size_t number_of_data_sets = data_set_names.size();
+    try {
+        for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+             ++data_set_index) {
+            auto data = row_major_data(data_set_index);
+            for (std::uint64_t grid_point_index = 0; grid_point_index < number_of_grid_points;
+                 ++grid_point_index) {
+                grid_point_values[grid_point_index * number_of_data_sets + data_set_index] =
+                    data[grid_point_index];
+            }
+        }
+    }
+    catch (...) {
+        munmap(mapping, table_size);
+        discard();
+        throw;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(mapping, &magic, sizeof(magic));
+    munmap(mapping, table_size);
+    if (storage == SharedTableStorage::file &&
+        std::rename(temporary_path.c_str(), name.c_str()) != 0) {
+        discard();
+        writer.send_error(fmt::format("Unable to write table ({}).", std::strerror(errno)));
+    }
+#else
+    (void)storage;
+    (void)row_major_data;
+    (void)table_size;
+    writer.send_error("Shared tables are not supported on this platform.");
+#endif
+}
+
+bool remove_shared_table(const std::string& name, SharedTableStorage storage)
+{
+#ifdef BTWXT_POSIX_SHARED_TABLES
+    if (storage == SharedTableStorage::shared_memory) {
+        return shm_unlink(name.c_str()) == 0;
+    }
+#endif
+    return storage == SharedTableStorage::file && std::remove(name.c_str()) == 0;
+}
+
+} // namespace Btwxt
@@ -0,0 +1,89 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// btwxt
+#include <btwxt/grid-axis.h>
+#include <btwxt/regular-grid-interpolator.h>
+
+namespace Btwxt {
+
+// Shared table format (all values are 8 bytes, so the grid point values are aligned):
+//   "BTWXTTBL", version, number of axes, number of data sets, number of grid points (uint64)
+//   For each axis: number of values, interpolation method, extrapolation method (uint64),
+//     lower and upper extrapolation limits (double), name, and values (double)
+//   For each data set: name
+//   Grid point values, interleaved by grid point, in row-major order (double)
+// Names are stored as a length (uint64) followed by the characters (padded to a multiple of 8
+// bytes). The magic is written last, so a table that is still being written starts with zero.
+constexpr char shared_table_magic[8] {'B', 'T', 'W', 'X', 'T', 'T', 'B', 'L'};
+constexpr std::uint64_t shared_table_version {1u};
+
+class SharedTable : public Courier::Sender {
+    // A table (grid axes and grid point data) in a read-only memory mapping of a POSIX shared
+    // memory object or a file. Every process attached to the same table shares its memory.
+  public:
+    SharedTable(const std::string& name,
+                SharedTableStorage storage,
+                const std::shared_ptr<Courier::Courier>& courier);
+
+    ~SharedTable();
+
+    SharedTable(const SharedTable&) = delete;
+
+    SharedTable& operator=(const SharedTable&) = delete;
+
+    [[nodiscard]] std::vector<GridAxis> get_grid_axes() const;
+
+    [[nodiscard]] const std::vector<std::string>& get_data_set_names() const
+    {
+        return data_set_names;
+    }
+
+    [[nodiscard]] std::uint64_t get_number_of_grid_points() const { return number_of_grid_points; }
+
+    // Values for each data set, interleaved by grid point
+    [[nodiscard]] const double* get_grid_point_values() const { return grid_point_values; }
+
+    [[nodiscard]] std::size_t get_mapped_size() const { return mapped_size; }
+
+  private:
+    struct AxisRecord {
+        std::string name;
+        InterpolationMethod interpolation_method;
+        ExtrapolationMethod extrapolation_method;
+        std::pair<double, double> extrapolation_limits;
+        const double* values;
+        std::size_t length;
+    };
+
+    void* mapping {nullptr};
+    std::size_t mapped_size {0u};
+    std::vector<AxisRecord> axis_records;
+    std::vector<std::string> data_set_names;
+    std::uint64_t number_of_grid_points {0u};
+    const double* grid_point_values {nullptr};
+
+    void read_header();
+};
+
+// Writes a table, replacing any existing table of the same name without affecting processes
+// already attached to it. row_major_data returns the grid point data of a data set.
+void write_shared_table(const std::string& name,
+                        SharedTableStorage storage,
+                        const std::vector<GridAxis>& grid_axes,
+                        const std::vector<std::string>& data_set_names,
+                        std::uint64_t number_of_grid_points,
+                        const std::function<std::vector<double>(std::size_t)>& row_major_data,
+                        const std::shared_ptr<Courier::Courier>& courier);
+
+bool remove_shared_table(const std::string& name, SharedTableStorage storage);
+
+} // namespace Btwxt
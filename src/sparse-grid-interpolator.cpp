@@ -0,0 +1,541 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+#include <map>
+#include <string_view>
+
+#include <fmt/format.h>
+
+// btwxt
+#include <btwxt/sparse-grid-interpolator.h>
+
+namespace Btwxt {
+
+namespace {
+
+constexpr std::size_t grid_points_per_task {256u};
+constexpr std::size_t minimum_targets_per_task {256u};
+constexpr std::size_t maximum_number_of_tasks {1024u};
+
+} // namespace
+
+SparseGridInterpolator::SparseGridInterpolator(std::vector<GridAxis> grid_axes_in,
+                                               std::size_t level_in,
+                                               std::vector<std::string> data_set_names_in,
+                                               const GridPointFunction& grid_point_function,
+                                               const TaskExecutor& executor,
+                                               std::string name,
+                                               const std::shared_ptr<Courier::Courier>& courier)
+    : Courier::Sender(std::move(name), courier)
+    , grid_axes(std::move(grid_axes_in))
+    , level(level_in)
+    , data_set_names(std::move(data_set_names_in))
+    , number_of_data_sets(data_set_names.size())
+{
+    class_name = "SparseGridInterpolator";
+    if (grid_axes.empty()) {
+        send_error("Cannot construct sparse grid. There are no grid axes.");
+    }
+    if (number_of_data_sets == 0u) {
+        send_error("Cannot construct sparse grid. There are no data sets.");
+    }
+    if (!grid_point_function) {
+        send_error("Grid point function is empty.");
+    }
+    const std::size_t number_of_dimensions = grid_axes.size();
+    std::size_t number_of_axis_levels = 0u;
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        const auto& grid_axis = grid_axes[axis_index];
+        const std::size_t length = grid_axis.get_length();
+        if (length == 0u || (length > 1u && ((length - 1u) & (length - 2u)) != 0u)) {
+            send_error(fmt::format("Cannot construct sparse grid. GridAxis '{}' has {} values "
+                                   "(expected one, or 2^k + 1).",
+                                   grid_axis.name,
+                                   length));
+        }
+        if (grid_axis.get_interpolation_method() != InterpolationMethod::linear) {
+            send_warning(fmt::format("GridAxis '{}' will be interpolated linearly. Sparse grids do "
+                                     "not support other interpolation methods.",
+                                     grid_axis.name));
+        }
+        std::size_t maximum_axis_level = 0u;
+        for (std::size_t intervals = length - 1u; intervals > 0u; intervals /= 2u) {
+            ++maximum_axis_level;
+        }
+        maximum_axis_levels.push_back(maximum_axis_level);
+        axis_level_offsets.push_back(number_of_axis_levels);
+        number_of_axis_levels += maximum_axis_level + 1u;
+    }
+    subspace_offsets.push_back(0u);
+    std::vector<std::uint8_t> levels(number_of_dimensions);
+    enumerate_subspaces(0u, level, levels);
+    scratch.basis_values.resize(number_of_axis_levels);
+    scratch.basis_indices.resize(number_of_axis_levels);
+    results.resize(number_of_data_sets);
+
+    const std::size_t number_of_grid_points = get_number_of_grid_points();
+    surpluses.resize(number_of_grid_points * number_of_data_sets);
+    auto sample_range = [&](std::size_t begin, std::size_t end) {
+        std::vector<double> coordinates(number_of_dimensions);
+        for (std::size_t grid_point_index = begin; grid_point_index < end; ++grid_point_index) {
+            get_grid_point(grid_point_index, coordinates);
+            const std::vector<double> values = grid_point_function(coordinates);
+            if (values.size() != number_of_data_sets) {
+                send_error(fmt::format("Grid point function returned {} values at grid point {} "
+                                       "(expected one for each of {} data sets).",
+                                       values.size(),
+                                       grid_point_index,
+                                       number_of_data_sets));
+            }
+            std::copy(values.begin(),
+                      values.end(),
+                      surpluses.begin() +
+                          static_cast<std::ptrdiff_t>(grid_point_index * number_of_data_sets));
+        }
+    };
+    if (!executor || number_of_grid_points <= grid_points_per_task) {
+        sample_range(0u, number_of_grid_points);
+    }
+    else {
+        executor((number_of_grid_points + grid_points_per_task - 1u) / grid_points_per_task,
+                 [&](std::size_t task_index) {
+                     const std::size_t begin = task_index * grid_points_per_task;
+                     sample_range(begin,
+                                  std::min(begin + grid_points_per_task, number_of_grid_points));
+                 });
+    }
+    hierarchize();
+}
+
+void SparseGridInterpolator::enumerate_subspaces(std::size_t axis_index,
+                                                 std::size_t remaining_level,
+                                                 std::vector<std::uint8_t>& levels)
+{
+    const std::size_t maximum_axis_level =
+        std::min(maximum_axis_levels[axis_index], remaining_level);
+    for (std::size_t axis_level = 0; axis_level <= maximum_axis_level; ++axis_level) {
+        levels[axis_index] = static_cast<std::uint8_t>(axis_level);
+        if (axis_index + 1u < levels.size()) {
+            enumerate_subspaces(axis_index + 1u, remaining_level - axis_level, levels);
+            continue;
+        }
+        std::size_t number_of_subspace_points = 1u;
+        for (auto subspace_axis_level : levels) {
+            number_of_subspace_points *= get_number_of_level_points(subspace_axis_level);
+        }
+        subspace_levels.insert(subspace_levels.end(), levels.begin(), levels.end());
+        subspace_offsets.push_back(subspace_offsets.back() + number_of_subspace_points);
+    }
+}
+
+std::size_t SparseGridInterpolator::get_axis_value_index(std::size_t axis_index,
+                                                         std::size_t axis_level,
+                                                         std::size_t basis_index) const
+{
+    if (axis_level == 0u) {
+        return 0u;
+    }
+    if (axis_level == 1u) {
+        return grid_axes[axis_index].get_length() - 1u;
+    }
+    const std::size_t half_width = std::size_t {1u}
+                                   << (maximum_axis_levels[axis_index] - axis_level);
+    return half_width * (2u * basis_index + 1u);
+}
+
+void SparseGridInterpolator::get_grid_point(std::size_t grid_point_index,
+                                            std::vector<double>& coordinates) const
+{
+    const std::size_t number_of_dimensions = grid_axes.size();
+    const auto subspace_index = static_cast<std::size_t>(
+        std::upper_bound(subspace_offsets.begin(), subspace_offsets.end(), grid_point_index) -
+        subspace_offsets.begin() - 1);
+    std::size_t local_index = grid_point_index - subspace_offsets[subspace_index];
+    for (std::size_t axis_index = number_of_dimensions; axis_index-- > 0;) {
+        const std::size_t axis_level =
+            subspace_levels[subspace_index * number_of_dimensions + axis_index];
+        const std::size_t number_of_level_points = get_number_of_level_points(axis_level);
+        coordinates[axis_index] = grid_axes[axis_index].get_values()[get_axis_value_index(
+            axis_index, axis_level, local_index % number_of_level_points)];
+        local_index /= number_of_level_points;
+    }
+}
+
+std::vector<std::vector<double>> SparseGridInterpolator::get_grid_points() const
+{
+    std::vector<std::vector<double>> grid_points(get_number_of_grid_points(),
+                                                 std::vector<double>(grid_axes.size()));
+    for (std::size_t grid_point_index = 0; grid_point_index < grid_points.size();
+         ++grid_point_index) {
+        get_grid_point(grid_point_index, grid_points[grid_point_index]);
+    }
+    return grid_points;
+}
+
+void SparseGridInterpolator::set_grid_point_data_sets(
+    const std::vector<GridPointDataSet>& grid_point_data_sets)
+{
+    const std::size_t number_of_grid_points = get_number_of_grid_points();
+    if (grid_point_data_sets.empty()) {
+        send_error("Cannot set grid point data. There are no data sets.");
+    }
+    for (const auto& grid_point_data_set : grid_point_data_sets) {
+        if (grid_point_data_set.data.size() != number_of_grid_points) {
+            send_error(fmt::format(
+                "GridPointDataSet '{}': Size ({}) does not match number of grid points ({}).",
+                grid_point_data_set.name,
+                grid_point_data_set.data.size(),
+                number_of_grid_points));
+        }
+    }
+    number_of_data_sets = grid_point_data_sets.size();
+    data_set_names.clear();
+    surpluses.resize(number_of_grid_points * number_of_data_sets);
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        const auto& grid_point_data_set = grid_point_data_sets[data_set_index];
+        data_set_names.push_back(grid_point_data_set.name);
+        for (std::size_t grid_point_index = 0; grid_point_index < number_of_grid_points;
+             ++grid_point_index) {
+            surpluses[grid_point_index * number_of_data_sets + data_set_index] =
+                grid_point_data_set.data[grid_point_index];
+        }
+    }
+    results.resize(number_of_data_sets);
+    hierarchize();
+}
+
+void SparseGridInterpolator::hierarchize()
+{
+    // Values are converted to surpluses along one axis at a time. Along each axis, finer levels
+    // are converted first, so that the points they are interpolated from still hold values
+    // (already converted along the previous axes) rather than surpluses.
+    const std::size_t number_of_dimensions = grid_axes.size();
+    const std::size_t number_of_subspaces = subspace_offsets.size() - 1u;
+    std::map<std::vector<std::uint8_t>, std::size_t> subspace_indices;
+    for (std::size_t subspace_index = 0; subspace_index < number_of_subspaces; ++subspace_index) {
+        auto first = subspace_levels.begin() +
+                     static_cast<std::ptrdiff_t>(subspace_index * number_of_dimensions);
+        subspace_indices.emplace(
+            std::vector<std::uint8_t>(first,
+                                      first + static_cast<std::ptrdiff_t>(number_of_dimensions)),
+            subspace_index);
+    }
+    std::vector<std::uint8_t> parent_levels(number_of_dimensions);
+    std::vector<std::size_t> parent_subspace_indices;
+    for (std::size_t axis_index = 0; axis_index < number_of_dimensions; ++axis_index) {
+        const auto& axis_values = grid_axes[axis_index].get_values();
+        const std::size_t maximum_axis_level = maximum_axis_levels[axis_index];
+        // Level and basis index of the point with the given index along the axis
+        auto get_axis_point = [&](std::size_t value_index) -> std::pair<std::size_t, std::size_t> {
+            if (value_index == 0u) {
+                return {0u, 0u};
+            }
+            if (value_index == axis_values.size() - 1u) {
+                return {1u, 0u};
+            }
+            const std::size_t half_width = value_index & (~value_index + 1u); // Lowest set bit
+            std::size_t axis_level = maximum_axis_level;
+            for (std::size_t width = half_width; width > 1u; width /= 2u) {
+                --axis_level;
+            }
+            return {axis_level, (value_index / half_width - 1u) / 2u};
+        };
+        for (std::size_t axis_level = maximum_axis_level; axis_level > 0u; --axis_level) {
+            const std::size_t number_of_level_points = get_number_of_level_points(axis_level);
+            for (std::size_t subspace_index = 0; subspace_index < number_of_subspaces;
+                 ++subspace_index) {
+                const std::uint8_t* levels =
+                    subspace_levels.data() + subspace_index * number_of_dimensions;
+                if (levels[axis_index] != axis_level) {
+                    continue;
+                }
+                std::copy_n(levels, number_of_dimensions, parent_levels.begin());
+                parent_subspace_indices.clear();
+                for (std::size_t parent_axis_level = 0; parent_axis_level < axis_level;
+                     ++parent_axis_level) {
+                    parent_levels[axis_index] = static_cast<std::uint8_t>(parent_axis_level);
+                    parent_subspace_indices.push_back(subspace_indices.at(parent_levels));
+                }
+                std::size_t stride = 1u; // Of the axis's basis index within the subspace
+                for (std::size_t later_axis_index = axis_index + 1u;
+                     later_axis_index < number_of_dimensions;
+                     ++later_axis_index) {
+                    stride *= get_number_of_level_points(levels[later_axis_index]);
+                }
+                auto get_parent_surpluses = [&](std::size_t value_index,
+                                                std::size_t outer_index,
+                                                std::size_t inner_index) {
+                    const auto [parent_axis_level, parent_basis_index] =
+                        get_axis_point(value_index);
+                    const std::size_t local_index =
+                        (outer_index * get_number_of_level_points(parent_axis_level) +
+                         parent_basis_index) *
+                            stride +
+                        inner_index;
+                    return surpluses.data() +
+                           (subspace_offsets[parent_subspace_indices[parent_axis_level]] +
+                            local_index) *
+                               number_of_data_sets;
+                };
+                for (std::size_t local_index = 0;
+                     local_index < subspace_offsets[subspace_index + 1] -
+                                       subspace_offsets[subspace_index];
+                     ++local_index) {
+                    const std::size_t inner_index = local_index % stride;
+                    const std::size_t basis_index = (local_index / stride) % number_of_level_points;
+                    const std::size_t outer_index = local_index / (stride * number_of_level_points);
+                    double* point_surpluses =
+                        surpluses.data() +
+                        (subspace_offsets[subspace_index] + local_index) * number_of_data_sets;
+                    if (axis_level == 1u) {
+                        // Ramp: difference between the last and first values
+                        const double* first_surpluses =
+                            get_parent_surpluses(0u, outer_index, inner_index);
+                        for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+                             ++data_set_index) {
+                            point_surpluses[data_set_index] -= first_surpluses[data_set_index];
+                        }
+                        continue;
+                    }
+                    // Hat: difference from linear interpolation between its neighbors
+                    const std::size_t value_index =
+                        get_axis_value_index(axis_index, axis_level, basis_index);
+                    const std::size_t half_width = std::size_t {1u}
+                                                   << (maximum_axis_level - axis_level);
+                    const std::size_t floor_index = value_index - half_width;
+                    const std::size_t ceiling_index = value_index + half_width;
+                    const double ceiling_weight =
+                        (axis_values[value_index] - axis_values[floor_index]) /
+                        (axis_values[ceiling_index] - axis_values[floor_index]);
+                    const double* floor_surpluses =
+                        get_parent_surpluses(floor_index, outer_index, inner_index);
+                    const double* ceiling_surpluses =
+                        get_parent_surpluses(ceiling_index, outer_index, inner_index);
+                    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+                         ++data_set_index) {
+                        point_surpluses[data_set_index] -=
+                            (1.0 - ceiling_weight) * floor_surpluses[data_set_index] +
+                            ceiling_weight * ceiling_surpluses[data_set_index];
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<double>
+SparseGridInterpolator::get_hierarchical_surpluses(std::size_t grid_point_index) const
+{
+    if (grid_point_index >= get_number_of_grid_points()) {
+        send_error(fmt::format("Grid point index ({}) is out of range ({} grid points).",
+                               grid_point_index,
+                               get_number_of_grid_points()));
+    }
+    auto first =
+        surpluses.begin() + static_cast<std::ptrdiff_t>(grid_point_index * number_of_data_sets);
+    return {first, first + static_cast<std::ptrdiff_t>(number_of_data_sets)};
+}
+
+void SparseGridInterpolator::set_basis_functions(const double* target,
+                                                 EvaluationScratch& evaluation_scratch) const
+{
+    constexpr std::string_view error_format {"GridAxis '{}': The target ({:.6g}) is {} the "
+                                             "extrapolation limit ({:.6g})."};
+    for (std::size_t axis_index = 0; axis_index < grid_axes.size(); ++axis_index) {
+        const auto& grid_axis = grid_axes[axis_index];
+        const auto& axis_values = grid_axis.get_values();
+        double value = target[axis_index];
+        const auto limits = grid_axis.get_extrapolation_limits();
+        if (value < limits.first) {
+            send_error(fmt::format(error_format, grid_axis.name, value, "below", limits.first));
+        }
+        if (value > limits.second) {
+            send_error(fmt::format(error_format, grid_axis.name, value, "above", limits.second));
+        }
+        double* basis_values =
+            evaluation_scratch.basis_values.data() + axis_level_offsets[axis_index];
+        std::size_t* basis_indices =
+            evaluation_scratch.basis_indices.data() + axis_level_offsets[axis_index];
+        basis_values[0] = 1.0;
+        basis_indices[0] = 0u;
+        const std::size_t maximum_axis_level = maximum_axis_levels[axis_index];
+        if (maximum_axis_level == 0u) {
+            continue;
+        }
+        // Linear extrapolation extends the basis functions of the first or last cell
+        if (grid_axis.get_extrapolation_method() == ExtrapolationMethod::constant) {
+            value = std::clamp(value, axis_values.front(), axis_values.back());
+        }
+        basis_values[1] =
+            (value - axis_values.front()) / (axis_values.back() - axis_values.front());
+        basis_indices[1] = 0u;
+        const std::size_t floor_index = grid_axis.get_floor_index(value);
+        for (std::size_t axis_level = 2; axis_level <= maximum_axis_level; ++axis_level) {
+            const std::size_t half_width = std::size_t {1u} << (maximum_axis_level - axis_level);
+            const std::size_t basis_index = floor_index / (2u * half_width);
+            const std::size_t first_index = 2u * half_width * basis_index;
+            const std::size_t peak_index = first_index + half_width;
+            const std::size_t last_index = peak_index + half_width;
+            basis_values[axis_level] =
+                floor_index < peak_index
+                    ? (value - axis_values[first_index]) /
+                          (axis_values[peak_index] - axis_values[first_index])
+                    : (axis_values[last_index] - value) /
+                          (axis_values[last_index] - axis_values[peak_index]);
+            basis_indices[axis_level] = basis_index;
+        }
+    }
+}
+
+void SparseGridInterpolator::accumulate(std::size_t axis_index,
+                                        std::size_t remaining_level,
+                                        double weight,
+                                        std::size_t local_index,
+                                        std::size_t& subspace_index,
+                                        const EvaluationScratch& evaluation_scratch,
+                                        double* results_at_target) const
+{
+    // Visits subspaces in the order they are stored, accumulating the product of the basis
+    // functions and the grid point's index within its subspace one axis at a time
+    const std::size_t maximum_axis_level =
+        std::min(maximum_axis_levels[axis_index], remaining_level);
+    const double* basis_values =
+        evaluation_scratch.basis_values.data() + axis_level_offsets[axis_index];
+    const std::size_t* basis_indices =
+        evaluation_scratch.basis_indices.data() + axis_level_offsets[axis_index];
+    const bool is_last_axis = axis_index + 1u == grid_axes.size();
+    for (std::size_t axis_level = 0; axis_level <= maximum_axis_level; ++axis_level) {
+        const double axis_weight = weight * basis_values[axis_level];
+        const std::size_t axis_local_index =
+            local_index * get_number_of_level_points(axis_level) + basis_indices[axis_level];
+        if (!is_last_axis) {
+            accumulate(axis_index + 1u,
+                       remaining_level - axis_level,
+                       axis_weight,
+                       axis_local_index,
+                       subspace_index,
+                       evaluation_scratch,
+                       results_at_target);
+            continue;
+        }
+        const double* point_surpluses =
+            surpluses.data() +
+            (subspace_offsets[subspace_index++] + axis_local_index) * number_of_data_sets;
+        for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+             ++data_set_index) {
+            results_at_target[data_set_index] += axis_weight * point_surpluses[data_set_index];
+        }
+    }
+}
+
+void SparseGridInterpolator::evaluate(const double* target,
+                                      double* results_at_target,
+                                      EvaluationScratch& evaluation_scratch) const
+{
+    set_basis_functions(target, evaluation_scratch);
+    std::fill_n(results_at_target, number_of_data_sets, 0.0);
+    std::size_t subspace_index = 0u;
+    accumulate(0u, level, 1.0, 0u, subspace_index, evaluation_scratch, results_at_target);
+}
+
+std::vector<double> SparseGridInterpolator::get_values_at_target(const std::vector<double>& target)
+{
+    if (target.size() != grid_axes.size()) {
+        send_error(
+            fmt::format("Target (size={}) and grid (size={}) do not have the same dimensions.",
+                        target.size(),
+                        grid_axes.size()));
+    }
+    evaluate(target.data(), results.data(), scratch);
+    return results;
+}
+
+double SparseGridInterpolator::get_value_at_target(const std::vector<double>& target,
+                                                   std::size_t data_set_index)
+{
+    if (data_set_index >= number_of_data_sets) {
+        send_error(fmt::format("Data set index ({}) is out of range ({} data sets).",
+                               data_set_index,
+                               number_of_data_sets));
+    }
+    return get_values_at_target(target)[data_set_index];
+}
+
+std::vector<std::vector<double>>
+SparseGridInterpolator::get_values_at_targets(const std::vector<std::vector<double>>& targets,
+                                              const TaskExecutor& executor) const
+{
+    const std::size_t number_of_dimensions = grid_axes.size();
+    std::vector<double> flattened_targets;
+    flattened_targets.reserve(targets.size() * number_of_dimensions);
+    for (const auto& target : targets) {
+        if (target.size() != number_of_dimensions) {
+            send_error(
+                fmt::format("Target (size={}) and grid (size={}) do not have the same dimensions.",
+                            target.size(),
+                            number_of_dimensions));
+        }
+        flattened_targets.insert(flattened_targets.end(), target.begin(), target.end());
+    }
+    std::vector<double> flattened_results(targets.size() * number_of_data_sets);
+    get_values_at_targets(
+        flattened_targets.data(), targets.size(), flattened_results.data(), executor);
+
+    std::vector<std::vector<double>> batch_results(targets.size());
+    for (std::size_t target_index = 0; target_index < targets.size(); ++target_index) {
+        auto begin = flattened_results.begin() +
+                     static_cast<std::ptrdiff_t>(target_index * number_of_data_sets);
+        batch_results[target_index].assign(
+            begin, begin + static_cast<std::ptrdiff_t>(number_of_data_sets));
+    }
+    return batch_results;
+}
+
+void SparseGridInterpolator::get_values_at_targets(const double* targets,
+                                                   std::size_t number_of_targets,
+                                                   double* results_out,
+                                                   const TaskExecutor& executor) const
+{
+    const std::size_t number_of_dimensions = grid_axes.size();
+    auto evaluate_range = [&](std::size_t begin, std::size_t end) {
+        EvaluationScratch evaluation_scratch {scratch};
+        for (std::size_t target_index = begin; target_index < end; ++target_index) {
+            evaluate(targets + target_index * number_of_dimensions,
+                     results_out + target_index * number_of_data_sets,
+                     evaluation_scratch);
+        }
+    };
+    const std::size_t number_of_tasks =
+        executor ? std::min(number_of_targets / minimum_targets_per_task, maximum_number_of_tasks)
+                 : 1u;
+    if (number_of_tasks <= 1u) {
+        evaluate_range(0u, number_of_targets);
+        return;
+    }
+    const std::size_t targets_per_task =
+        (number_of_targets + number_of_tasks - 1) / number_of_tasks;
+    executor(number_of_tasks, [&](std::size_t task_index) {
+        const std::size_t begin = task_index * targets_per_task;
+        evaluate_range(begin, std::min(begin + targets_per_task, number_of_targets));
+    });
+}
+
+std::size_t SparseGridInterpolator::get_memory_size() const
+{
+    std::size_t memory_size = sizeof(SparseGridInterpolator);
+    for (const auto& grid_axis : grid_axes) {
+        memory_size += sizeof(GridAxis) + grid_axis.get_length() * sizeof(double) +
+                       grid_axis.get_search_tree().capacity() * sizeof(double);
+    }
+    memory_size += surpluses.capacity() * sizeof(double) +
+                   subspace_levels.capacity() * sizeof(std::uint8_t) +
+                   subspace_offsets.capacity() * sizeof(std::size_t) +
+                   scratch.basis_values.capacity() * sizeof(double) +
+                   scratch.basis_indices.capacity() * sizeof(std::size_t) +
+                   results.capacity() * sizeof(double);
+    return memory_size;
+}
+
+} // namespace Btwxt
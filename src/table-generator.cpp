@@ -0,0 +1,164 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+
+// btwxt
+#include <btwxt/grid-point-data-file-writer.h>
+#include <btwxt/table-generator.h>
+
+namespace Btwxt {
+
+TableGenerator::TableGenerator(std::vector<GridAxis> grid_axes_in,
+                               std::vector<std::string> data_set_names_in,
+                               GridPointFunction grid_point_function_in,
+                               std::string name,
+                               const std::shared_ptr<Courier::Courier>& courier)
+    : Courier::Sender(std::move(name), courier)
+    , grid_axes(std::move(grid_axes_in))
+    , data_set_names(std::move(data_set_names_in))
+    , grid_point_function(std::move(grid_point_function_in))
+{
+    class_name = "TableGenerator";
+    if (!grid_point_function) {
+        send_error("Grid point function is empty.");
+    }
+    for (const auto& grid_axis : grid_axes) {
+        number_of_grid_points *= grid_axis.get_values().size();
+    }
+}
+
+void TableGenerator::set_grid_points_per_task(std::size_t grid_points_per_task_in)
+{
+    grid_points_per_task = std::max(grid_points_per_task_in, std::size_t {1u});
+}
+
+template <typename Store>
+void TableGenerator::evaluate_grid_points(std::uint64_t first_grid_point_index,
+                                          std::uint64_t number_of_grid_points_to_evaluate,
+                                          const Store& store,
+                                          const TaskExecutor& executor) const
+{
+    const std::size_t number_of_axes = grid_axes.size();
+    const std::size_t number_of_data_sets = data_set_names.size();
+    auto evaluate_range = [&](std::uint64_t begin, std::uint64_t end) {
+        // Axis indices of the first grid point, then advanced in row-major order
+        std::vector<std::size_t> axis_indices(number_of_axes);
+        std::vector<double> coordinates(number_of_axes);
+        std::uint64_t remainder = begin;
+        for (std::size_t axis_index = number_of_axes; axis_index-- > 0;) {
+            const auto& values = grid_axes[axis_index].get_values();
+            axis_indices[axis_index] = remainder % values.size();
+            remainder /= values.size();
+            coordinates[axis_index] = values[axis_indices[axis_index]];
+        }
+        for (std::uint64_t grid_point_index = begin; grid_point_index < end; ++grid_point_index) {
+            std::vector<double> values = grid_point_function(coordinates);
+            if (values.size() != number_of_data_sets) {
+                send_error(fmt::format("Grid point function returned {} values at grid point {} "
+                                       "(expected one for each of {} data sets).",
+                                       values.size(),
+                                       grid_point_index,
+                                       number_of_data_sets));
+            }
+            store(grid_point_index, values);
+            for (std::size_t axis_index = number_of_axes; axis_index-- > 0;) {
+                const auto& axis_values = grid_axes[axis_index].get_values();
+                if (++axis_indices[axis_index] < axis_values.size()) {
+                    coordinates[axis_index] = axis_values[axis_indices[axis_index]];
+                    break;
+                }
+                axis_indices[axis_index] = 0;
+                coordinates[axis_index] = axis_values[0];
+            }
+        }
+    };
+
+    if (number_of_grid_points_to_evaluate == 0u) {
+        return;
+    }
+    const std::uint64_t end_grid_point_index =
+        first_grid_point_index + number_of_grid_points_to_evaluate;
+    if (!executor || number_of_grid_points_to_evaluate <= grid_points_per_task) {
+        evaluate_range(first_grid_point_index, end_grid_point_index);
+        return;
+    }
+    const std::size_t number_of_tasks =
+        (number_of_grid_points_to_evaluate + grid_points_per_task - 1u) / grid_points_per_task;
+    executor(number_of_tasks, [&](std::size_t task_index) {
+        const std::uint64_t begin = first_grid_point_index + task_index * grid_points_per_task;
+        evaluate_range(begin, std::min(begin + grid_points_per_task, end_grid_point_index));
+    });
+}
+
+RegularGridInterpolator TableGenerator::generate_interpolator(const TaskExecutor& executor) const
+{
+    std::vector<GridPointDataSet> grid_point_data_sets;
+    grid_point_data_sets.reserve(data_set_names.size());
+    for (const auto& data_set_name : data_set_names) {
+        grid_point_data_sets.emplace_back(std::vector<double>(number_of_grid_points),
+                                          data_set_name);
+    }
+    evaluate_grid_points(
+        0u,
+        number_of_grid_points,
+        [&](std::uint64_t grid_point_index, const std::vector<double>& values) {
+            for (std::size_t data_set_index = 0; data_set_index < values.size();
+                 ++data_set_index) {
+                grid_point_data_sets[data_set_index].data[grid_point_index] =
+                    values[data_set_index];
+            }
+        },
+        executor);
+    return RegularGridInterpolator(grid_axes, std::move(grid_point_data_sets), name, courier);
+}
+
+void TableGenerator::generate(const GridPointDataSink& sink,
+                              const TaskExecutor& executor,
+                              std::size_t chunk_size) const
+{
+    const std::size_t number_of_data_sets = data_set_names.size();
+    chunk_size = std::max(chunk_size, std::size_t {1u});
+    std::vector<double> chunk_values(
+        std::min<std::uint64_t>(chunk_size, number_of_grid_points) * number_of_data_sets);
+    std::vector<double> grid_point_values(number_of_data_sets);
+    for (std::uint64_t first_grid_point_index = 0; first_grid_point_index < number_of_grid_points;
+         first_grid_point_index += chunk_size) {
+        const std::uint64_t number_of_chunk_grid_points =
+            std::min<std::uint64_t>(chunk_size, number_of_grid_points - first_grid_point_index);
+        evaluate_grid_points(
+            first_grid_point_index,
+            number_of_chunk_grid_points,
+            [&](std::uint64_t grid_point_index, const std::vector<double>& values) {
+                std::copy(values.begin(),
+                          values.end(),
+                          chunk_values.begin() +
+                              (grid_point_index - first_grid_point_index) * number_of_data_sets);
+            },
+            executor);
+        for (std::uint64_t chunk_index = 0; chunk_index < number_of_chunk_grid_points;
+             ++chunk_index) {
+            auto chunk_grid_point = chunk_values.begin() + chunk_index * number_of_data_sets;
+            std::copy(chunk_grid_point,
+                      chunk_grid_point + number_of_data_sets,
+                      grid_point_values.begin());
+            sink(grid_point_values);
+        }
+    }
+}
+
+void TableGenerator::generate_grid_point_data_file(const std::string& path,
+                                                   std::uint64_t block_size,
+                                                   const TaskExecutor& executor) const
+{
+    GridPointDataFileWriter writer(
+        path, data_set_names, number_of_grid_points, block_size, courier);
+    generate(
+        [&](const std::vector<double>& grid_point_values) { writer.append(grid_point_values); },
+        executor,
+        std::max<std::uint64_t>(block_size, 1u << 16u));
+    writer.close();
+}
+
+} // namespace Btwxt
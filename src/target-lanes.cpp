@@ -0,0 +1,170 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// btwxt
+#include "target-lanes.h"
+
+namespace Btwxt {
+
+namespace {
+
+using LaneIndices = std::array<std::int64_t, number_of_target_lanes>;
+using LaneValues = std::array<double, number_of_target_lanes>;
+
+// values[lane] = base[indices[lane]]
+inline void gather_lanes(const double* base, const LaneIndices& indices, LaneValues& values)
+{
+#if defined(__AVX512F__)
+    __m512i lane_indices = _mm512_loadu_si512(indices.data());
+    _mm512_storeu_pd(values.data(),
+                     _mm512_mask_i64gather_pd(
+                         _mm512_setzero_pd(), 0xFF, lane_indices, base, sizeof(double)));
+#elif defined(__AVX2__)
+    for (std::size_t lane = 0; lane < number_of_target_lanes; lane += 4u) {
+        __m256i lane_indices =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices.data() + lane));
+        _mm256_storeu_pd(values.data() + lane,
+                         _mm256_i64gather_pd(base, lane_indices, sizeof(double)));
+    }
+#else
+    for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+        values[lane] = base[indices[lane]];
+    }
+#endif
+}
+
+} // namespace
+
+void evaluate_linear_target_lanes(const LinearLaneGrid& grid,
+                                  const double* const* target_columns,
+                                  std::size_t first_target,
+                                  std::size_t number_of_targets,
+                                  double* const* result_columns)
+{
+    const std::size_t number_of_axes = grid.axis_values.size();
+    const std::size_t number_of_data_sets = grid.grid_point_data.size();
+
+    // Per axis and lane: index offsets of the floor and ceiling grid points and their weights
+    std::vector<LaneIndices> floor_offsets(number_of_axes);
+    std::vector<LaneIndices> ceiling_offsets(number_of_axes);
+    std::vector<LaneValues> floor_weights(number_of_axes);
+    std::vector<LaneValues> ceiling_weights(number_of_axes);
+
+    LaneValues x;
+    LaneIndices floor;
+    LaneIndices probe;
+    LaneValues probe_values;
+    LaneValues ceiling_values;
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        const double* values = grid.axis_values[axis_index];
+        const std::size_t length = grid.axis_lengths[axis_index];
+        const auto step_size = static_cast<std::int64_t>(grid.axis_step_sizes[axis_index]);
+        // Unused lanes repeat the last target
+        for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+            x[lane] = target_columns[axis_index]
+                                    [first_target + std::min(lane, number_of_targets - 1u)];
+        }
+        if (length == 1u) {
+            // Single grid point: the "ceiling" is the same point
+            for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+                floor_offsets[axis_index][lane] = 0;
+                ceiling_offsets[axis_index][lane] = 0;
+                floor_weights[axis_index][lane] = 0.0;
+                ceiling_weights[axis_index][lane] = 1.0;
+            }
+            continue;
+        }
+
+        // Branchless search for the last grid point at or below x (within [0, length - 2]),
+        // walking the axis's search tree. Every lane takes the same number of steps.
+        const double* search_tree = grid.axis_search_trees[axis_index];
+        const std::size_t search_tree_height = grid.axis_search_tree_heights[axis_index];
+        probe.fill(1);
+        for (std::size_t depth = 0; depth < search_tree_height; ++depth) {
+            gather_lanes(search_tree, probe, probe_values);
+            for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+                probe[lane] = 2 * probe[lane] + (probe_values[lane] <= x[lane] ? 1 : 0);
+            }
+        }
+        const auto maximum_floor = static_cast<std::int64_t>(length) - 2;
+        for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+            // Number of values at or below x
+            const std::int64_t count = probe[lane] - (std::int64_t {1} << search_tree_height);
+            floor[lane] = std::min(count - (count > 0 ? 1 : 0), maximum_floor);
+        }
+
+        gather_lanes(values, floor, probe_values);
+        for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+            probe[lane] = floor[lane] + 1;
+        }
+        gather_lanes(values, probe, ceiling_values);
+        const double first_value = values[0];
+        const double last_value = values[length - 1u];
+        const bool is_constant_extrapolation = grid.axis_constant_extrapolation[axis_index] != 0;
+        for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+            double mu =
+                (x[lane] - probe_values[lane]) / (ceiling_values[lane] - probe_values[lane]);
+            if (is_constant_extrapolation && (x[lane] < first_value || x[lane] > last_value)) {
+                mu = mu < 0 ? 0 : 1;
+            }
+            floor_offsets[axis_index][lane] = floor[lane] * step_size;
+            ceiling_offsets[axis_index][lane] = (floor[lane] + 1) * step_size;
+            floor_weights[axis_index][lane] = 1 - mu;
+            ceiling_weights[axis_index][lane] = mu;
+        }
+    }
+
+    // Vertices in the same order as single-target evaluation (first axis outermost, floor before
+    // ceiling). Vertices with a zero weight along any axis are skipped (masked).
+    std::vector<LaneValues> results(number_of_data_sets, LaneValues {});
+    LaneIndices vertex_indices;
+    LaneValues vertex_weights;
+    LaneValues vertex_data;
+    std::array<bool, number_of_target_lanes> vertex_is_used;
+    const std::size_t number_of_vertices = std::size_t {1} << number_of_axes;
+    for (std::size_t vertex = 0; vertex < number_of_vertices; ++vertex) {
+        for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+            vertex_indices[lane] = 0;
+            vertex_weights[lane] = 1.0;
+            vertex_is_used[lane] = true;
+        }
+        for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+            const bool is_ceiling = (vertex >> (number_of_axes - 1u - axis_index)) & 1u;
+            const auto& offsets =
+                is_ceiling ? ceiling_offsets[axis_index] : floor_offsets[axis_index];
+            const auto& weights =
+                is_ceiling ? ceiling_weights[axis_index] : floor_weights[axis_index];
+            for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+                vertex_indices[lane] += offsets[lane];
+                vertex_weights[lane] *= weights[lane];
+                vertex_is_used[lane] = vertex_is_used[lane] && weights[lane] != 0.0;
+            }
+        }
+        for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+             ++data_set_index) {
+            gather_lanes(grid.grid_point_data[data_set_index], vertex_indices, vertex_data);
+            auto& data_set_results = results[data_set_index];
+            for (std::size_t lane = 0; lane < number_of_target_lanes; ++lane) {
+                data_set_results[lane] +=
+                    vertex_is_used[lane] ? vertex_data[lane] * vertex_weights[lane] : 0.0;
+            }
+        }
+    }
+
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        for (std::size_t lane = 0; lane < number_of_targets; ++lane) {
+            result_columns[data_set_index][first_target + lane] = results[data_set_index][lane];
+        }
+    }
+}
+
+} // namespace Btwxt
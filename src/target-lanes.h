@@ -0,0 +1,36 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <cstddef>
+#include <vector>
+
+namespace Btwxt {
+
+// Targets evaluated at once by evaluate_linear_target_lanes (one per SIMD lane)
+static constexpr std::size_t number_of_target_lanes {8u};
+
+struct LinearLaneGrid {
+    // View of a grid that is linearly interpolated along every axis, with row-major grid point
+    // data in memory
+    std::vector<const double*> axis_values;
+    std::vector<std::size_t> axis_lengths;
+    std::vector<std::size_t> axis_step_sizes;
+    std::vector<const double*> axis_search_trees; // See GridAxis::get_search_tree()
+    std::vector<std::size_t> axis_search_tree_heights;
+    std::vector<char> axis_constant_extrapolation; // Otherwise linear
+    std::vector<const double*> grid_point_data;    // For each data set
+};
+
+// Evaluates number_of_targets (up to number_of_target_lanes) targets starting at first_target.
+// target_columns[axis_index][target_index] and result_columns[data_set_index][target_index].
+// Targets must be within the extrapolation limits. Results match single-target evaluation.
+void evaluate_linear_target_lanes(const LinearLaneGrid& grid,
+                                  const double* const* target_columns,
+                                  std::size_t first_target,
+                                  std::size_t number_of_targets,
+                                  double* const* result_columns);
+
+} // namespace Btwxt
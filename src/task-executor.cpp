@@ -0,0 +1,129 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// btwxt
+#include <btwxt/task-executor.h>
+
+namespace Btwxt {
+
+namespace {
+// Pool whose task the current thread is running (if any)
+thread_local const ThreadPool* pool_of_running_task {nullptr};
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t number_of_threads)
+{
+    // hardware_concurrency() may return 0 when it cannot be determined
+    for (std::size_t thread_index = 1; thread_index < number_of_threads; ++thread_index) {
+        workers.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run(std::size_t number_of_tasks_in, const std::function<void(std::size_t)>& task)
+{
+    if (number_of_tasks_in == 0u) {
+        return;
+    }
+    if (pool_of_running_task == this) {
+        // Called from one of this pool's tasks: the pool is busy with the outer run, so run the
+        // nested tasks on this thread
+        std::exception_ptr exception;
+        for (std::size_t task_index = 0; task_index < number_of_tasks_in; ++task_index) {
+            try {
+                task(task_index);
+            }
+            catch (...) {
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    std::unique_lock<std::mutex> lock(mutex);
+    current_task = &task;
+    number_of_tasks = number_of_tasks_in;
+    next_task_index = 0u;
+    number_of_completed_tasks = 0u;
+    first_exception = nullptr;
+    ++generation;
+    work_available.notify_all();
+
+    work(lock);
+    work_complete.wait(lock, [this]() { return number_of_completed_tasks == number_of_tasks; });
+    current_task = nullptr;
+    std::exception_ptr exception = first_exception;
+    first_exception = nullptr;
+    lock.unlock();
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+TaskExecutor ThreadPool::get_executor()
+{
+    return [this](std::size_t number_of_tasks_in, const std::function<void(std::size_t)>& task) {
+        run(number_of_tasks_in, task);
+    };
+}
+
+void ThreadPool::work(std::unique_lock<std::mutex>& lock)
+{
+    while (next_task_index < number_of_tasks) {
+        std::size_t task_index = next_task_index++;
+        const auto& task = *current_task;
+        lock.unlock();
+        const ThreadPool* outer_pool = pool_of_running_task;
+        pool_of_running_task = this;
+        try {
+            task(task_index);
+        }
+        catch (...) {
+            lock.lock();
+            if (!first_exception) {
+                first_exception = std::current_exception();
+            }
+            lock.unlock();
+        }
+        pool_of_running_task = outer_pool;
+        lock.lock();
+        if (++number_of_completed_tasks == number_of_tasks) {
+            work_complete.notify_all();
+        }
+    }
+}
+
+void ThreadPool::worker_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    std::size_t observed_generation = generation;
+    while (true) {
+        work_available.wait(lock, [this, &observed_generation]() {
+            return stopping ||
+                   (generation != observed_generation && next_task_index < number_of_tasks);
+        });
+        if (stopping) {
+            return;
+        }
+        observed_generation = generation;
+        work(lock);
+    }
+}
+
+} // namespace Btwxt
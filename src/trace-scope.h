@@ -0,0 +1,47 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// btwxt
+#include <btwxt/tracing.h>
+
+#ifdef BTWXT_TRACING
+
+// Standard
+#include <chrono>
+
+namespace Btwxt {
+
+void record_trace_stage(TraceStage stage,
+                        std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end);
+
+class ScopedStageTimer {
+  public:
+    explicit ScopedStageTimer(TraceStage stage)
+        : stage(stage), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedStageTimer() { record_trace_stage(stage, start, std::chrono::steady_clock::now()); }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+  private:
+    TraceStage stage;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace Btwxt
+
+// Times the rest of the enclosing scope as the given stage
+#define BTWXT_TRACE_SCOPE(stage) ::Btwxt::ScopedStageTimer btwxt_stage_timer(stage)
+
+#else
+
+#define BTWXT_TRACE_SCOPE(stage) static_cast<void>(0)
+
+#endif
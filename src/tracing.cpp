@@ -0,0 +1,268 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <fmt/format.h>
+
+// btwxt
+#include "trace-scope.h"
+
+namespace Btwxt {
+
+namespace {
+
+constexpr std::array<std::string_view, number_of_trace_stages> trace_stage_names {
+    "floor_search", "fractions", "consolidate_methods", "coefficients", "hypercube", "gather",
+    "reduction"};
+
+#ifdef BTWXT_TRACING
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point trace_epoch = Clock::now();
+
+struct StageStatistics {
+    // Written only by the recording thread; atomic so that profiles can be read at any time
+    std::atomic<std::uint64_t> count {0u};
+    std::atomic<std::uint64_t> total_duration {0u};
+    std::atomic<std::uint64_t> minimum_duration {UINT64_MAX};
+    std::atomic<std::uint64_t> maximum_duration {0u};
+    std::array<std::atomic<std::uint64_t>, number_of_trace_histogram_buckets> histogram {};
+};
+
+struct TraceEvent {
+    TraceStage stage;
+    std::uint64_t start; // ns since the trace epoch
+    std::uint64_t duration;
+};
+
+struct ThreadTraceRecorder {
+    std::size_t thread_index {0u};
+    std::array<StageStatistics, number_of_trace_stages> stages;
+    std::mutex events_mutex;
+    std::vector<TraceEvent> events;
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    // Recorders outlive their threads so that their timings remain in the profiles
+    std::vector<std::shared_ptr<ThreadTraceRecorder>> recorders;
+    std::atomic<bool> record_events {false};
+    std::atomic<std::size_t> maximum_events_per_thread {1u << 20u};
+};
+
+TraceRegistry& get_trace_registry()
+{
+    static TraceRegistry registry;
+    return registry;
+}
+
+ThreadTraceRecorder& get_thread_trace_recorder()
+{
+    thread_local std::shared_ptr<ThreadTraceRecorder> recorder = []() {
+        auto& registry = get_trace_registry();
+        auto new_recorder = std::make_shared<ThreadTraceRecorder>();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        new_recorder->thread_index = registry.recorders.size();
+        registry.recorders.push_back(new_recorder);
+        return new_recorder;
+    }();
+    return *recorder;
+}
+
+std::size_t get_histogram_bucket(std::uint64_t duration)
+{
+    std::size_t bucket = 0u;
+    while (duration > 0u && bucket + 1u < number_of_trace_histogram_buckets) {
+        duration >>= 1u;
+        ++bucket;
+    }
+    return bucket;
+}
+
+std::uint64_t get_nanoseconds(Clock::duration duration)
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+#endif // BTWXT_TRACING
+
+} // namespace
+
+#ifdef BTWXT_TRACING
+
+void record_trace_stage(TraceStage stage, Clock::time_point start, Clock::time_point end)
+{
+    auto& recorder = get_thread_trace_recorder();
+    const std::uint64_t duration = get_nanoseconds(end - start);
+    auto& statistics = recorder.stages[static_cast<std::size_t>(stage)];
+    statistics.count.fetch_add(1u, std::memory_order_relaxed);
+    statistics.total_duration.fetch_add(duration, std::memory_order_relaxed);
+    if (duration < statistics.minimum_duration.load(std::memory_order_relaxed)) {
+        statistics.minimum_duration.store(duration, std::memory_order_relaxed);
+    }
+    if (duration > statistics.maximum_duration.load(std::memory_order_relaxed)) {
+        statistics.maximum_duration.store(duration, std::memory_order_relaxed);
+    }
+    statistics.histogram[get_histogram_bucket(duration)].fetch_add(1u,
+                                                                   std::memory_order_relaxed);
+
+    auto& registry = get_trace_registry();
+    if (registry.record_events.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(recorder.events_mutex);
+        if (recorder.events.size() <
+            registry.maximum_events_per_thread.load(std::memory_order_relaxed)) {
+            recorder.events.push_back({stage, get_nanoseconds(start - trace_epoch), duration});
+        }
+    }
+}
+
+#endif // BTWXT_TRACING
+
+double TraceStageProfile::get_quantile(double quantile) const
+{
+    if (count == 0u) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::uint64_t>(std::clamp(quantile, 0.0, 1.0) * count);
+    std::uint64_t cumulative_count = 0u;
+    for (std::size_t bucket = 0; bucket < number_of_trace_histogram_buckets; ++bucket) {
+        cumulative_count += histogram[bucket];
+        if (cumulative_count > rank || cumulative_count == count) {
+            const std::uint64_t bucket_upper_bound = std::uint64_t {1u} << bucket;
+            return static_cast<double>(
+                std::min(bucket_upper_bound, std::max(maximum_duration, std::uint64_t {1u})));
+        }
+    }
+    return static_cast<double>(maximum_duration);
+}
+
+std::string_view get_trace_stage_name(TraceStage stage)
+{
+    return trace_stage_names[static_cast<std::size_t>(stage)];
+}
+
+bool tracing_is_enabled()
+{
+#ifdef BTWXT_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<TraceStageProfile> get_trace_stage_profiles()
+{
+    std::vector<TraceStageProfile> profiles;
+#ifdef BTWXT_TRACING
+    auto& registry = get_trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (std::size_t stage_index = 0; stage_index < number_of_trace_stages; ++stage_index) {
+        TraceStageProfile profile;
+        profile.stage = static_cast<TraceStage>(stage_index);
+        std::uint64_t minimum_duration = UINT64_MAX;
+        for (const auto& recorder : registry.recorders) {
+            const auto& statistics = recorder->stages[stage_index];
+            profile.count += statistics.count.load(std::memory_order_relaxed);
+            profile.total_duration += statistics.total_duration.load(std::memory_order_relaxed);
+            minimum_duration = std::min(
+                minimum_duration, statistics.minimum_duration.load(std::memory_order_relaxed));
+            profile.maximum_duration =
+                std::max(profile.maximum_duration,
+                         statistics.maximum_duration.load(std::memory_order_relaxed));
+            for (std::size_t bucket = 0; bucket < number_of_trace_histogram_buckets; ++bucket) {
+                profile.histogram[bucket] +=
+                    statistics.histogram[bucket].load(std::memory_order_relaxed);
+            }
+        }
+        profile.minimum_duration = profile.count > 0u ? minimum_duration : 0u;
+        profiles.push_back(profile);
+    }
+#endif
+    return profiles;
+}
+
+void reset_trace()
+{
+#ifdef BTWXT_TRACING
+    auto& registry = get_trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& recorder : registry.recorders) {
+        for (auto& statistics : recorder->stages) {
+            statistics.count.store(0u, std::memory_order_relaxed);
+            statistics.total_duration.store(0u, std::memory_order_relaxed);
+            statistics.minimum_duration.store(UINT64_MAX, std::memory_order_relaxed);
+            statistics.maximum_duration.store(0u, std::memory_order_relaxed);
+            for (auto& bucket_count : statistics.histogram) {
+                bucket_count.store(0u, std::memory_order_relaxed);
+            }
+        }
+        std::lock_guard<std::mutex> events_lock(recorder->events_mutex);
+        recorder->events.clear();
+    }
+#endif
+}
+
+void set_trace_event_recording(bool record_events, std::size_t maximum_events_per_thread)
+{
+#ifdef BTWXT_TRACING
+    auto& registry = get_trace_registry();
+    registry.maximum_events_per_thread.store(maximum_events_per_thread);
+    registry.record_events.store(record_events);
+#else
+    static_cast<void>(record_events);
+    static_cast<void>(maximum_events_per_thread);
+#endif
+}
+
+void write_chrome_trace(std::ostream& stream)
+{
+    stream << "{\"traceEvents\":[";
+#ifdef BTWXT_TRACING
+    auto& registry = get_trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    bool is_first_event = true;
+    for (const auto& recorder : registry.recorders) {
+        std::lock_guard<std::mutex> events_lock(recorder->events_mutex);
+        for (const auto& event : recorder->events) {
+            // Timestamps and durations are in microseconds
+            stream << fmt::format("{}\n{{\"name\":\"{}\",\"cat\":\"btwxt\",\"ph\":\"X\","
+                                  "\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":0,\"tid\":{}}}",
+                                  is_first_event ? "" : ",",
+                                  get_trace_stage_name(event.stage),
+                                  static_cast<double>(event.start) / 1000.0,
+                                  static_cast<double>(event.duration) / 1000.0,
+                                  recorder->thread_index);
+            is_first_event = false;
+        }
+    }
+#endif
+    stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void write_trace_profile_csv(std::ostream& stream)
+{
+    stream << "stage,count,total_ns,mean_ns,minimum_ns,maximum_ns,p50_ns,p90_ns,p99_ns\n";
+    for (const auto& profile : get_trace_stage_profiles()) {
+        const double mean_duration =
+            profile.count > 0u ? static_cast<double>(profile.total_duration) / profile.count : 0.0;
+        stream << fmt::format("{},{},{},{:.1f},{},{},{},{},{}\n",
+                              get_trace_stage_name(profile.stage),
+                              profile.count,
+                              profile.total_duration,
+                              mean_duration,
+                              profile.minimum_duration,
+                              profile.maximum_duration,
+                              profile.get_quantile(0.5),
+                              profile.get_quantile(0.9),
+                              profile.get_quantile(0.99));
+    }
+}
+
+} // namespace Btwxt
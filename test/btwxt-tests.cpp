@@ -3,7 +3,18 @@
 
 // Standard
 #include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BTWXT_TEST_SHARED_TABLES // Shared tables are only supported on POSIX platforms
+#include <unistd.h>
+#endif
 
 // vendor
 #include <fmt/format.h>
@@ -12,6 +23,7 @@
 
 // btwxt
 #include <btwxt/btwxt.h>
+#include <btwxt/grid-point-data-file-writer.h>
 #include "fixtures/public-fixtures.h"
 
 namespace Btwxt {
@@ -98,6 +110,42 @@ TEST(Constructors, test_all_constructors)
     RegularGridInterpolator rgi4(std::vector<std::vector<double>> {{1}}, {GridPointDataSet({1})});
 }
 
+TEST(Constructors, move_grid_point_data)
+{
+    static_assert(std::is_nothrow_move_constructible_v<RegularGridInterpolator>);
+    static_assert(std::is_nothrow_move_assignable_v<RegularGridInterpolator>);
+
+    std::vector<double> axis(1000);
+    std::iota(axis.begin(), axis.end(), 0.0);
+    std::vector<double> data(axis);
+    const double* data_address = data.data();
+
+    // Moved-in vectors are not copied (initializer lists would copy)
+    std::vector<std::vector<double>> grid_point_data_vectors;
+    grid_point_data_vectors.push_back(std::move(data));
+    RegularGridInterpolator interpolator(std::vector<std::vector<double>> {axis},
+                                         std::move(grid_point_data_vectors));
+    EXPECT_EQ(interpolator.get_grid_point_data_set(0).data.data(), data_address);
+
+    std::vector<double> added_data(axis);
+    const double* added_data_address = added_data.data();
+    interpolator.add_grid_point_data_set(std::move(added_data));
+    EXPECT_EQ(interpolator.get_grid_point_data_set(1).data.data(), added_data_address);
+
+    // Moving (including vector growth) keeps the same grid point data
+    std::vector<RegularGridInterpolator> interpolators;
+    interpolators.push_back(std::move(interpolator));
+    interpolators.emplace_back(interpolators[0]);
+    EXPECT_EQ(interpolators[0].get_grid_point_data_set(0).data.data(), data_address);
+    EXPECT_EQ(interpolators[1].get_grid_point_data_set(0).data.data(),
+              data_address); // Copies share grid point data until it is modified
+    EXPECT_EQ(interpolators[1](std::vector<double> {2.5})[1], 2.5);
+
+    RegularGridInterpolator assigned;
+    assigned = std::move(interpolators[0]);
+    EXPECT_EQ(assigned.get_grid_point_data_set(1).data.data(), added_data_address);
+}
+
 TEST_F(GridFixture, four_point_1d_cubic_interpolate)
 {
 
@@ -224,6 +272,19 @@ TEST_F(GridFixture, get_neighboring_indices)
                         testing::ElementsAre(interpolator.get_values_at_target()[0]));
         }
     }
+
+    // Indices are row-major regardless of the storage layout
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked);
+    EXPECT_THAT(interpolator.get_neighboring_indices_at_target({1.5, 0.5}),
+                testing::ElementsAre(3, 4, 6, 7));
+    EXPECT_THAT(interpolator.get_neighboring_indices_at_target({3, 3}), testing::ElementsAre(8));
+    for (auto g0 : grid[0]) {
+        for (auto g1 : grid[1]) {
+            interpolator.set_target({g0, g1});
+            EXPECT_THAT(interpolator.get_neighboring_indices_at_target(),
+                        testing::ElementsAre(interpolator.get_values_at_target()[0]));
+        }
+    }
 }
 
 TEST_F(Grid2DFixture, target_undefined)
@@ -573,6 +634,1674 @@ TEST_F(Function4DFixture, multi_timer)
     }
 }
 
+TEST_F(Function4DFixture, blocked_layout)
+{
+    std::vector<std::vector<double>> set_of_targets = {{0.1, 0.1, 0.1, 0.1},
+                                                       {3.3, 2.2, 4.1, 1.4},
+                                                       {4.5, 4.5, 4.5, 4.5},
+                                                       {-1.0, 2.0, 5.0, 2.1}};
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    std::vector<std::vector<double>> row_major_results;
+    for (const auto& target : set_of_targets) {
+        row_major_results.push_back(interpolator(target));
+    }
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked);
+    EXPECT_EQ(interpolator.get_grid_point_data_layout(), GridPointDataLayout::blocked);
+    for (std::size_t i = 0; i < set_of_targets.size(); i++) {
+        EXPECT_EQ(interpolator(set_of_targets[i]), row_major_results[i]);
+    }
+    interpolator.add_grid_point_data_set(data_sets[1]);
+    EXPECT_EQ(interpolator(set_of_targets[1])[2], row_major_results[1][1]);
+}
+
+TEST_F(FunctionFixture, blocked_layout_timer)
+{
+    const std::size_t number_of_axes = 6;
+    grid.resize(number_of_axes);
+    for (std::size_t i = 0; i < number_of_axes; i++) {
+        grid[i] = linspace(0.0, 1.0, 12);
+    }
+    functions = {[](std::vector<double> x) -> double {
+        return x[0] + 2 * x[1] - x[2] * x[3] + x[4] * x[4] - x[5];
+    }};
+    setup();
+
+    std::vector<std::vector<double>> set_of_targets(1000, std::vector<double>(number_of_axes));
+    std::size_t seed = 1;
+    for (auto& target : set_of_targets) {
+        for (auto& value : target) {
+            seed = (seed * 1103515245u + 12345u) % 2147483648u;
+            value = static_cast<double>(seed) / 2147483648.;
+        }
+    }
+
+    auto time_targets = [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& target : set_of_targets) {
+            interpolator.set_target(target);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    };
+
+    auto row_major_duration = time_targets();
+    double row_major_result = interpolator.get_value_at_target(set_of_targets.back(), 0);
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked);
+    auto blocked_duration = time_targets();
+    EXPECT_DOUBLE_EQ(interpolator.get_value_at_target(0), row_major_result);
+
+    interpolator.get_courier()->send_info(
+        fmt::format("Time taken by 1000 6-D interpolations: {} microseconds (row-major), {} "
+                    "microseconds (blocked)",
+                    row_major_duration,
+                    blocked_duration));
+}
+
+TEST_F(Function4DFixture, compressed_grid_point_data)
+{
+    std::vector<std::vector<double>> set_of_targets = {{0.1, 0.1, 0.1, 0.1},
+                                                       {3.3, 2.2, 4.1, 1.4},
+                                                       {4.5, 4.5, 4.5, 4.5},
+                                                       {2.1, 2.9, 1.8, 1.9}};
+    std::vector<std::vector<double>> expected_results;
+    for (const auto& target : set_of_targets) {
+        expected_results.push_back(interpolator(target));
+    }
+
+    interpolator.set_grid_point_data_compression(0.0, 64);
+    EXPECT_GT(interpolator.get_grid_point_data_compression_ratio(), 1.0);
+    for (std::size_t target_index = 0; target_index < set_of_targets.size(); ++target_index) {
+        EXPECT_EQ(interpolator(set_of_targets[target_index]), expected_results[target_index]);
+    }
+
+    const double maximum_error = 1e-6;
+    interpolator.set_grid_point_data_compression(maximum_error);
+    EXPECT_GT(interpolator.get_grid_point_data_compression_ratio(), 3.0);
+    for (std::size_t target_index = 0; target_index < set_of_targets.size(); ++target_index) {
+        EXPECT_THAT(interpolator(set_of_targets[target_index]),
+                    testing::ElementsAre(
+                        testing::DoubleNear(expected_results[target_index][0], maximum_error),
+                        testing::DoubleNear(expected_results[target_index][1], maximum_error)));
+    }
+
+    // Data can still be modified (and stays compressed)
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked);
+    interpolator.normalize_grid_point_data_sets_at_target(set_of_targets[1]);
+    EXPECT_GT(interpolator.get_grid_point_data_compression_ratio(), 3.0);
+    EXPECT_THAT(interpolator(set_of_targets[1]),
+                testing::ElementsAre(testing::DoubleNear(1.0, maximum_error),
+                                     testing::DoubleNear(1.0, maximum_error)));
+
+    interpolator.clear_grid_point_data_compression();
+    EXPECT_EQ(interpolator.get_grid_point_data_compression_ratio(), 1.0);
+    EXPECT_THAT(interpolator(set_of_targets[1]),
+                testing::ElementsAre(testing::DoubleNear(1.0, maximum_error),
+                                     testing::DoubleNear(1.0, maximum_error)));
+}
+
+TEST_F(Grid2DFixture, compressed_grid_point_data_set)
+{
+    interpolator.set_grid_point_data_compression(0.0);
+    std::string expected_stdout =
+        "  [ERROR] RegularGridInterpolator 'Test RGI': GridPointDataSet 'Data Set 1': Cannot get "
+        "compressed grid point data set. Clear the grid point data compression first.\n";
+    EXPECT_STDOUT(EXPECT_THROW(std::ignore = interpolator.get_grid_point_data_set(0),
+                               std::runtime_error);
+                  , expected_stdout)
+    interpolator.clear_grid_point_data_compression();
+    EXPECT_EQ(interpolator.get_grid_point_data_set(0).data, data_sets[0]);
+}
+
+TEST_F(Function2DFixture, coarsened_interpolator_bilinear)
+{
+    // Bilinear data is reproduced exactly by the axis end points
+    grid = {linspace(2.0, 7.0, 6), linspace(1.0, 3.0, 5)};
+    data_sets.clear();
+    setup();
+    auto coarsened = interpolator.get_coarsened_interpolator(1e-12);
+    EXPECT_EQ(coarsened.interpolator.get_grid_axis(0).get_values(), std::vector<double>({2., 7.}));
+    EXPECT_EQ(coarsened.interpolator.get_grid_axis(1).get_values(), std::vector<double>({1., 3.}));
+    EXPECT_THAT(coarsened.maximum_errors, testing::ElementsAre(testing::DoubleNear(0.0, 1e-12)));
+    EXPECT_NEAR(coarsened.interpolator({4.5, 2.5}, 0), 4.5 * 2.5, 1e-12);
+}
+
+TEST_F(Function4DFixture, coarsened_interpolator)
+{
+    const double tolerance = 0.5;
+    for (auto method : {InterpolationMethod::linear, InterpolationMethod::cubic}) {
+        for (std::size_t axis_index = 0; axis_index < grid.size(); ++axis_index) {
+            interpolator.set_axis_interpolation_method(axis_index, method);
+        }
+        auto coarsened = interpolator.get_coarsened_interpolator(tolerance);
+        EXPECT_LT(coarsened.interpolator.get_number_of_grid_points(),
+                  interpolator.get_number_of_grid_points());
+        ASSERT_EQ(coarsened.maximum_errors.size(), 2u);
+        EXPECT_LE(coarsened.maximum_errors[0], tolerance);
+        EXPECT_LE(coarsened.maximum_errors[1], 1e-12); // Linear function
+        EXPECT_EQ(coarsened.interpolator.get_grid_axis(0).get_interpolation_method(), method);
+
+        // Check against the original data at the grid points
+        double maximum_error = 0.0;
+        for (const auto& grid_point : cartesian_product(grid)) {
+            maximum_error = std::max(maximum_error,
+                                     std::abs(coarsened.interpolator(grid_point, 0) -
+                                              functions[0](grid_point)));
+        }
+        EXPECT_DOUBLE_EQ(maximum_error, coarsened.maximum_errors[0]);
+    }
+    EXPECT_THROW(std::ignore = interpolator.get_coarsened_interpolator(-1.0), std::runtime_error);
+}
+
+TEST_F(Function4DFixture, paged_grid_point_data)
+{
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "btwxt-paged-grid-point-data.bin").string();
+    const std::size_t block_size = 64;
+    std::vector<GridPointDataSet> grid_point_data_sets;
+    for (const auto& data_set : data_sets) {
+        grid_point_data_sets.emplace_back(data_set);
+    }
+    write_grid_point_data_file(path, grid_point_data_sets, block_size);
+
+    std::vector<std::vector<double>> set_of_targets;
+    for (std::size_t target_index = 0; target_index < 500; ++target_index) {
+        std::vector<double> target(grid.size());
+        for (std::size_t axis_index = 0; axis_index < grid.size(); ++axis_index) {
+            target[axis_index] =
+                4.5 * static_cast<double>((target_index * (7 + 4 * axis_index)) % 101) / 100.0;
+        }
+        set_of_targets.push_back(target);
+    }
+    auto expected_results = interpolator.get_values_at_targets(set_of_targets);
+
+    // Smaller than the file (157 blocks)
+    const std::size_t maximum_resident_size = 16 * block_size * 2 * sizeof(double);
+    RegularGridInterpolator paged_interpolator(grid);
+    paged_interpolator.set_grid_point_data_file(path, maximum_resident_size);
+    EXPECT_EQ(paged_interpolator.get_number_of_grid_point_data_sets(), 2u);
+    EXPECT_EQ(paged_interpolator.get_values_at_targets(set_of_targets), expected_results);
+    EXPECT_EQ(paged_interpolator(target), interpolator(target));
+    {
+        ThreadPool thread_pool(4);
+        EXPECT_EQ(
+            paged_interpolator.get_values_at_targets(set_of_targets, thread_pool.get_executor()),
+            expected_results);
+    }
+
+    auto statistics = paged_interpolator.get_grid_point_data_paging_statistics();
+    EXPECT_EQ(statistics.maximum_number_of_resident_blocks, 16u);
+    EXPECT_LE(statistics.number_of_resident_blocks, 16u);
+    EXPECT_GT(statistics.number_of_block_reads, 16u);
+
+    // Paged grid point data is read-only
+    EXPECT_THROW(paged_interpolator.normalize_grid_point_data_sets_at_target(target),
+                 std::runtime_error);
+    EXPECT_THROW(paged_interpolator.set_grid_point_data_compression(0.0), std::runtime_error);
+    EXPECT_THROW(std::ignore = paged_interpolator.get_grid_point_data_set(0), std::runtime_error);
+
+    // Mismatched grid
+    RegularGridInterpolator mismatched_interpolator(std::vector<std::vector<double>>(
+        {linspace(0.0, 4.5, 5), linspace(0.0, 4.5, 5), linspace(0.0, 4.5, 5)}));
+    EXPECT_THROW(mismatched_interpolator.set_grid_point_data_file(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
+
+TEST(GridPointDataFile, corrupt_header)
+{
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "btwxt-corrupt-grid-point-data.bin").string();
+    auto write_file = [&](std::uint64_t name_length, std::uint64_t number_of_values) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write("BTWXTGPD", 8);
+        for (std::uint64_t value : {std::uint64_t {1u}, // Version
+                                    std::uint64_t {1u}, // Data sets
+                                    std::uint64_t {4u}, // Grid points
+                                    std::uint64_t {2u}, // Block size
+                                    name_length}) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        file.write("name\0\0\0\0", 8);
+        const std::vector<double> values(number_of_values, 1.0);
+        file.write(reinterpret_cast<const char*>(values.data()),
+                   static_cast<std::streamsize>(values.size() * sizeof(double)));
+    };
+    RegularGridInterpolator interpolator(std::vector<std::vector<double>> {{0, 1, 2, 3}});
+    write_file(4u, 4u);
+    interpolator.set_grid_point_data_file(path);
+    EXPECT_EQ(interpolator(std::vector<double> {1.5}), std::vector<double> {1.0});
+
+    // Sizes beyond the end of the file are not allocated or read
+    write_file(std::uint64_t {1u} << 62u, 4u);
+    EXPECT_THROW(interpolator.set_grid_point_data_file(path), std::runtime_error);
+    write_file(4u, 3u);
+    EXPECT_THROW(interpolator.set_grid_point_data_file(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_F(Function4DFixture, table_generator)
+{
+    std::vector<GridAxis> grid_axes;
+    for (const auto& axis_values : grid) {
+        grid_axes.emplace_back(axis_values);
+    }
+    TableGenerator generator(
+        grid_axes, {"trigonometric", "sum"}, [&](const std::vector<double>& x) {
+            return std::vector<double> {functions[0](x), functions[1](x)};
+        });
+    generator.set_grid_points_per_task(100);
+    EXPECT_EQ(generator.get_number_of_grid_points(), 10000u);
+
+    auto generated_interpolator = generator.generate_interpolator();
+    EXPECT_EQ(generated_interpolator.get_grid_point_data_set(0).data, data_sets[0]);
+    EXPECT_EQ(generated_interpolator.get_grid_point_data_set(1).data, data_sets[1]);
+    EXPECT_EQ(generated_interpolator.get_grid_point_data_set(1).name, "sum");
+    EXPECT_EQ(generated_interpolator(target), interpolator(target));
+    {
+        ThreadPool thread_pool(4);
+        auto parallel_interpolator = generator.generate_interpolator(thread_pool.get_executor());
+        EXPECT_EQ(parallel_interpolator.get_grid_point_data_set(0).data, data_sets[0]);
+        EXPECT_EQ(parallel_interpolator.get_grid_point_data_set(1).data, data_sets[1]);
+
+        // Streamed in chunks that are not a multiple of the task size
+        std::vector<std::vector<double>> streamed_data_sets(2);
+        generator.generate(
+            [&](const std::vector<double>& grid_point_values) {
+                streamed_data_sets[0].push_back(grid_point_values[0]);
+                streamed_data_sets[1].push_back(grid_point_values[1]);
+            },
+            thread_pool.get_executor(),
+            750);
+        EXPECT_EQ(streamed_data_sets, data_sets);
+
+        const std::string path =
+            (std::filesystem::temp_directory_path() / "btwxt-generated-table.bin").string();
+        generator.generate_grid_point_data_file(path, 64, thread_pool.get_executor());
+        RegularGridInterpolator paged_interpolator(grid);
+        paged_interpolator.set_grid_point_data_file(path);
+        EXPECT_EQ(paged_interpolator(target), interpolator(target));
+        std::filesystem::remove(path);
+    }
+
+    TableGenerator mismatched_generator(grid_axes, {"one", "two", "three"}, [&](auto x) {
+        return std::vector<double> {functions[0](x), functions[1](x)};
+    });
+    EXPECT_THROW(std::ignore = mismatched_generator.generate_interpolator(), std::runtime_error);
+}
+
+TEST_F(FunctionFixture, chebyshev_surrogate)
+{
+    grid = {linspace(0.0, 3.0, 16), linspace(-1.0, 2.0, 13)};
+    functions = {[](std::vector<double> x) -> double { return sin(x[0]) * cos(x[1]); },
+                 [](std::vector<double> x) -> double { return exp(0.3 * x[0]) + x[1]; }};
+    setup();
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    interpolator.set_axis_extrapolation_method(0, ExtrapolationMethod::linear);
+
+    const double tolerance = 1e-3;
+    ChebyshevSurrogate surrogate(interpolator, tolerance);
+    EXPECT_EQ(surrogate.get_fitted_region(),
+              (std::vector<std::pair<double, double>> {{grid[0].front(), grid[0].back()},
+                                                       {grid[1].front(), grid[1].back()}}));
+    EXPECT_LE(surrogate.get_maximum_errors()[0], tolerance);
+    EXPECT_LE(surrogate.get_maximum_errors()[1], tolerance);
+    EXPECT_GT(surrogate.get_speedup(), 0.0);
+    interpolator.get_courier()->send_info(
+        fmt::format("Chebyshev surrogate: {}x{} coefficients, maximum errors {:.2e} and {:.2e}, "
+                    "{:.1f} times faster than the table",
+                    surrogate.get_points_per_axis()[0],
+                    surrogate.get_points_per_axis()[1],
+                    surrogate.get_maximum_errors()[0],
+                    surrogate.get_maximum_errors()[1],
+                    surrogate.get_speedup()));
+
+    for (const auto& inner_target :
+         std::vector<std::vector<double>> {{0.37, 1.21}, {2.95, -0.99}, {1.5, 0.5}}) {
+        EXPECT_TRUE(surrogate.is_in_fitted_region(inner_target));
+        auto expected_results = interpolator(inner_target);
+        auto results = surrogate(inner_target);
+        EXPECT_NEAR(results[0], expected_results[0], tolerance);
+        EXPECT_NEAR(results[1], expected_results[1], tolerance);
+        EXPECT_EQ(surrogate(inner_target, 1), results[1]);
+    }
+
+    // Outside the fitted region, the table is evaluated
+    const std::vector<double> outer_target {3.5, 0.5};
+    EXPECT_FALSE(surrogate.is_in_fitted_region(outer_target));
+    EXPECT_EQ(surrogate(outer_target), interpolator(outer_target));
+    EXPECT_EQ(surrogate.get_values_at_targets({outer_target, {1.5, 0.5}})[0],
+              interpolator(outer_target));
+
+    // Smaller regions need fewer coefficients
+    ChebyshevSurrogate region_surrogate(interpolator, tolerance, {{1.0, 1.5}, {0.0, 0.5}});
+    EXPECT_LT(region_surrogate.get_number_of_coefficients(),
+              surrogate.get_number_of_coefficients());
+    EXPECT_EQ(region_surrogate({1.0, 1.0}), interpolator({1.0, 1.0}));
+
+    EXPECT_THROW(ChebyshevSurrogate(interpolator, 1e-12, {}, 8), std::runtime_error);
+    EXPECT_THROW(ChebyshevSurrogate(interpolator, tolerance, {{1.0, 0.0}, {0.0, 1.0}}),
+                 std::runtime_error);
+}
+
+TEST_F(Function2DFixture, chebyshev_surrogate_bilinear)
+{
+    // Bilinear tables are reproduced by polynomials of degree one
+    ChebyshevSurrogate surrogate(interpolator, 1e-12);
+    EXPECT_EQ(surrogate.get_points_per_axis(), (std::vector<std::size_t> {2u, 2u}));
+    EXPECT_NEAR(surrogate({4.5, 1.5}, 0), 6.75, 1e-12);
+}
+
+TEST_F(SparseGridFixture, full_level)
+{
+    // When every grid point is included, results equal linear interpolation of the full grid
+    SparseGridInterpolator sparse_grid(
+        grid_axes, 4 + 4 + 3, {"smooth", "multilinear"}, grid_point_function);
+    EXPECT_EQ(sparse_grid.get_number_of_grid_points(), 9u * 9u * 5u);
+    for (const auto& target : targets) {
+        auto expected_results = interpolator(target);
+        auto results = sparse_grid(target);
+        EXPECT_NEAR(results[0], expected_results[0], 1e-12);
+        EXPECT_NEAR(results[1], expected_results[1], 1e-12);
+    }
+}
+
+TEST_F(SparseGridFixture, partial_level)
+{
+    // Multilinear functions only need the first and last values of each axis
+    SparseGridInterpolator sparse_grid(
+        grid_axes, 5, {"smooth", "multilinear"}, grid_point_function);
+    EXPECT_LT(sparse_grid.get_number_of_grid_points(), 9u * 9u * 5u);
+    for (const auto& target : targets) {
+        EXPECT_NEAR(sparse_grid(target, 1), interpolator(target)[1], 1e-12);
+    }
+
+    // Grid point values are reproduced
+    for (const auto& grid_point : sparse_grid.get_grid_points()) {
+        EXPECT_NEAR(sparse_grid(grid_point, 0), functions[0](grid_point), 1e-12);
+    }
+}
+
+TEST_F(SparseGridFixture, axis_lengths)
+{
+    // Axes have one value, or 2^k + 1
+    for (std::size_t length : {1u, 2u, 3u, 5u, 17u}) {
+        grid_axes[2] = GridAxis(linspace(-1.0, 1.0, length));
+        EXPECT_NO_THROW(SparseGridInterpolator(grid_axes, 3, {"smooth", "multilinear"},
+                                               grid_point_function));
+    }
+    for (std::size_t length : {4u, 6u, 16u}) {
+        grid_axes[2] = GridAxis(linspace(-1.0, 1.0, length));
+        EXPECT_THROW(SparseGridInterpolator(grid_axes, 3, {"smooth", "multilinear"},
+                                            grid_point_function),
+                     std::runtime_error);
+    }
+}
+
+TEST_F(SparseGridFixture, set_grid_point_data_sets)
+{
+    SparseGridInterpolator sparse_grid(
+        grid_axes, 5, {"smooth", "multilinear"}, grid_point_function);
+    const auto grid_points = sparse_grid.get_grid_points();
+    EXPECT_EQ(grid_points.size(), sparse_grid.get_number_of_grid_points());
+
+    // Data given in the order of get_grid_points() is reproduced at each grid point
+    std::vector<GridPointDataSet> grid_point_data_sets {GridPointDataSet({}, "doubled"),
+                                                        GridPointDataSet({}, "sum"),
+                                                        GridPointDataSet({}, "product")};
+    for (const auto& grid_point : grid_points) {
+        grid_point_data_sets[0].data.push_back(2.0 * functions[0](grid_point));
+        grid_point_data_sets[1].data.push_back(grid_point[0] + grid_point[1] + grid_point[2]);
+        grid_point_data_sets[2].data.push_back(grid_point[0] * grid_point[1] * grid_point[2]);
+    }
+    auto expected_results = sparse_grid(targets[0]);
+    sparse_grid.set_grid_point_data_sets(grid_point_data_sets);
+    EXPECT_EQ(sparse_grid.get_number_of_data_sets(), 3u);
+    EXPECT_EQ(sparse_grid.get_data_set_names(),
+              (std::vector<std::string> {"doubled", "sum", "product"}));
+    for (std::size_t grid_point_index = 0; grid_point_index < grid_points.size();
+         ++grid_point_index) {
+        auto results = sparse_grid(grid_points[grid_point_index]);
+        for (std::size_t data_set_index = 0; data_set_index < 3u; ++data_set_index) {
+            EXPECT_NEAR(results[data_set_index],
+                        grid_point_data_sets[data_set_index].data[grid_point_index],
+                        1e-12);
+        }
+    }
+    EXPECT_NEAR(sparse_grid(targets[0], 0), 2.0 * expected_results[0], 1e-12);
+
+    // Multilinear data is interpolated exactly within the grid (the first three targets)
+    for (const auto& target : {targets[0], targets[1], targets[2]}) {
+        EXPECT_NEAR(sparse_grid(target, 1), target[0] + target[1] + target[2], 1e-12);
+        EXPECT_NEAR(sparse_grid(target, 2), target[0] * target[1] * target[2], 1e-12);
+    }
+
+    grid_point_data_sets[1].data.pop_back();
+    EXPECT_THROW(sparse_grid.set_grid_point_data_sets(grid_point_data_sets), std::runtime_error);
+    EXPECT_THROW(sparse_grid.set_grid_point_data_sets({}), std::runtime_error);
+    EXPECT_THROW(SparseGridInterpolator(grid_axes, 3, {"smooth"}, grid_point_function),
+                 std::runtime_error);
+}
+
+TEST_F(SparseGridFixture, extrapolation_limits)
+{
+    grid_axes[0].set_extrapolation_limits({-1.0, 3.0});
+    grid_axes[2].set_extrapolation_limits({-1.0, 1.1});
+    SparseGridInterpolator sparse_grid(
+        grid_axes, 3, {"smooth", "multilinear"}, grid_point_function);
+
+    // Within the limits, axis 0 is extrapolated linearly and axis 2 is held constant
+    EXPECT_NO_THROW(sparse_grid({-0.9, 1.0, 0.5}));
+    EXPECT_NEAR(sparse_grid({1.0, 1.0, 1.05}, 0), sparse_grid({1.0, 1.0, 1.0}, 0), 1e-12);
+
+    for (const auto& beyond_target : std::vector<std::vector<double>> {
+             {-1.5, 1.0, 0.0}, {3.5, 1.0, 0.0}, {1.0, 1.0, -1.2}, {1.0, 1.0, 1.2}}) {
+        EXPECT_THROW(sparse_grid(beyond_target), std::runtime_error);
+        EXPECT_THROW(std::ignore = sparse_grid.get_values_at_targets({targets[0], beyond_target}),
+                     std::runtime_error);
+    }
+}
+
+TEST_F(SparseGridFixture, batch_evaluation)
+{
+    SparseGridInterpolator sparse_grid(
+        grid_axes, 5, {"smooth", "multilinear"}, grid_point_function);
+    std::vector<std::vector<double>> many_targets;
+    for (std::size_t target_index = 0; target_index < 1000u; ++target_index) {
+        const double t = 0.001 * static_cast<double>(target_index);
+        many_targets.push_back({2.0 * t, 3.6 * (1.0 - t), sin(10.0 * t)});
+    }
+    std::vector<std::vector<double>> expected_results;
+    for (const auto& target : many_targets) {
+        expected_results.push_back(sparse_grid(target));
+    }
+    EXPECT_EQ(sparse_grid.get_values_at_targets(many_targets), expected_results);
+
+    ThreadPool thread_pool(4);
+    EXPECT_EQ(sparse_grid.get_values_at_targets(many_targets, thread_pool.get_executor()),
+              expected_results);
+
+    // Flattened targets and results
+    std::vector<double> flattened_targets;
+    for (const auto& target : many_targets) {
+        flattened_targets.insert(flattened_targets.end(), target.begin(), target.end());
+    }
+    std::vector<double> flattened_results(2u * many_targets.size());
+    sparse_grid.get_values_at_targets(flattened_targets.data(),
+                                      many_targets.size(),
+                                      flattened_results.data(),
+                                      thread_pool.get_executor());
+    for (std::size_t target_index = 0; target_index < many_targets.size(); ++target_index) {
+        EXPECT_EQ(flattened_results[2u * target_index], expected_results[target_index][0]);
+        EXPECT_EQ(flattened_results[2u * target_index + 1u], expected_results[target_index][1]);
+    }
+
+    // Grid points are sampled concurrently with an executor
+    SparseGridInterpolator parallel_sparse_grid(grid_axes,
+                                                5,
+                                                {"smooth", "multilinear"},
+                                                grid_point_function,
+                                                thread_pool.get_executor());
+    EXPECT_EQ(parallel_sparse_grid.get_values_at_targets(many_targets), expected_results);
+}
+
+TEST(SparseGridInterpolator, high_dimensional_timer)
+{
+    // A smooth 9-D function whose full grid (17 points along each axis) would hold 1.2e11 points
+    const std::size_t number_of_axes = 9;
+    std::vector<GridAxis> grid_axes(number_of_axes, GridAxis(linspace(0.0, 1.0, 17)));
+    auto function = [](const std::vector<double>& x) {
+        double exponent = 0.0;
+        for (std::size_t axis_index = 0; axis_index < x.size(); ++axis_index) {
+            exponent -= 0.1 * static_cast<double>(axis_index + 1) * (x[axis_index] - 0.3) *
+                        (x[axis_index] - 0.3);
+        }
+        return std::vector<double> {std::exp(exponent)};
+    };
+    std::vector<std::vector<double>> targets(2000, std::vector<double>(number_of_axes));
+    std::size_t seed = 1;
+    for (auto& target : targets) {
+        for (double& value : target) {
+            seed = (seed * 1103515245u + 12345u) % 2147483648u;
+            value = static_cast<double>(seed) / 2147483648.;
+        }
+    }
+    auto courier = std::make_shared<BtwxtDefaultCourier>();
+    ThreadPool thread_pool(4);
+    double previous_maximum_error = 1.0;
+    for (std::size_t level : {3u, 5u, 7u}) {
+        SparseGridInterpolator sparse_grid(
+            grid_axes, level, {"f"}, function, thread_pool.get_executor());
+        auto start = std::chrono::steady_clock::now();
+        auto results = sparse_grid.get_values_at_targets(targets);
+        auto stop = std::chrono::steady_clock::now();
+        double maximum_error = 0.0;
+        for (std::size_t target_index = 0; target_index < targets.size(); ++target_index) {
+            maximum_error =
+                std::max(maximum_error,
+                         std::abs(results[target_index][0] - function(targets[target_index])[0]));
+        }
+        EXPECT_LT(maximum_error, previous_maximum_error);
+        previous_maximum_error = maximum_error;
+        courier->send_info(fmt::format("Level {} sparse grid: {} grid points ({} bytes), {} "
+                                       "interpolations in {:.1f} milliseconds, maximum error "
+                                       "{:.2e}",
+                                       level,
+                                       sparse_grid.get_number_of_grid_points(),
+                                       sparse_grid.get_memory_size(),
+                                       targets.size(),
+                                       std::chrono::duration<double, std::milli>(stop - start)
+                                           .count(),
+                                       maximum_error));
+    }
+    EXPECT_LT(previous_maximum_error, 2e-2);
+}
+
+#ifdef BTWXT_TEST_SHARED_TABLES
+TEST_F(Function4DFixture, shared_table)
+{
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    interpolator.set_axis_extrapolation_method(3, ExtrapolationMethod::linear);
+    interpolator.set_axis_extrapolation_limits(3, {-1.0, 6.0});
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked);
+    const std::vector<std::vector<double>> set_of_targets {
+        {0.1, 2.25, 3.9, -0.5}, {4.4, 0.0, 1.3, 2.0}, {3.1, 4.3, 2.0, 5.5}};
+    auto expected_results = interpolator.get_values_at_targets(set_of_targets);
+
+    // Names are unique to the process, so concurrent test runs do not share tables
+    const std::string process_id = std::to_string(getpid());
+    const std::string file_path = (std::filesystem::temp_directory_path() /
+                                   fmt::format("btwxt-shared-table-{}.bin", process_id))
+                                      .string();
+    const std::string shared_memory_name = fmt::format("/btwxt-shared-table-test-{}", process_id);
+    for (const auto& [table_name, storage] :
+         {std::pair {shared_memory_name, SharedTableStorage::shared_memory},
+          std::pair {file_path, SharedTableStorage::file}}) {
+        interpolator.publish_shared_table(table_name, storage);
+        auto attached = RegularGridInterpolator::attach_shared_table(table_name, storage);
+        EXPECT_EQ(attached.get_number_of_grid_point_data_sets(), 2u);
+        EXPECT_EQ(attached.get_grid_axis(1).get_interpolation_method(), InterpolationMethod::cubic);
+        EXPECT_EQ(attached.get_grid_axis(3).get_extrapolation_limits(),
+                  std::make_pair(-1.0, 6.0));
+        EXPECT_EQ(attached.get_values_at_targets(set_of_targets), expected_results);
+        EXPECT_GE(attached.get_memory_usage().grid_point_data,
+                  2 * interpolator.get_number_of_grid_points() * sizeof(double));
+
+        // Copies share the mapping. Attached grid point data is read-only.
+        RegularGridInterpolator copy(attached);
+        EXPECT_EQ(copy(set_of_targets[0]), expected_results[0]);
+        EXPECT_THROW(attached.normalize_grid_point_data_sets_at_target(set_of_targets[0]),
+                     std::runtime_error);
+        EXPECT_THROW(attached.set_grid_point_data_layout(GridPointDataLayout::blocked),
+                     std::runtime_error);
+        EXPECT_THROW(std::ignore = attached.get_grid_point_data_set(0), std::runtime_error);
+
+        // Republishing and removing leave attached interpolators unchanged
+        RegularGridInterpolator(grid, std::vector<std::vector<double>> {data_sets[1]})
+            .publish_shared_table(table_name, storage);
+        EXPECT_EQ(RegularGridInterpolator::attach_shared_table(table_name, storage)
+                      .get_number_of_grid_point_data_sets(),
+                  1u);
+        EXPECT_TRUE(RegularGridInterpolator::remove_shared_table(table_name, storage));
+        EXPECT_FALSE(RegularGridInterpolator::remove_shared_table(table_name, storage));
+        EXPECT_EQ(attached.get_values_at_targets(set_of_targets), expected_results);
+        EXPECT_THROW(RegularGridInterpolator::attach_shared_table(table_name, storage),
+                     std::runtime_error);
+    }
+}
+
+TEST(SharedTable, corrupt_header)
+{
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              fmt::format("btwxt-corrupt-shared-table-{}.bin", getpid()))
+                                 .string();
+    auto write_table = [&](std::uint64_t magic,
+                           std::size_t number_of_axes,
+                           std::uint64_t number_of_data_sets,
+                           std::uint64_t number_of_grid_points) {
+        std::vector<std::uint64_t> words {magic,
+                                          shared_table_version,
+                                          number_of_axes,
+                                          number_of_data_sets,
+                                          number_of_grid_points};
+        for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+            // Length, methods, limits (-inf, inf), empty name, and values (0, 1), as bits
+            words.insert(words.end(),
+                         {2u,
+                          0u,
+                          0u,
+                          0xFFF0000000000000u,
+                          0x7FF0000000000000u,
+                          0u,
+                          0u,
+                          0x3FF0000000000000u});
+        }
+        for (std::uint64_t data_set_index = 0; data_set_index < number_of_data_sets;
+             ++data_set_index) {
+            words.push_back(0u); // Empty name
+        }
+        words.resize(words.size() + 4u * number_of_data_sets, 0u); // Values, if two grid points
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(words.data()),
+                   static_cast<std::streamsize>(words.size() * sizeof(std::uint64_t)));
+    };
+    std::uint64_t magic;
+    std::memcpy(&magic, shared_table_magic, sizeof(magic));
+    write_table(magic, 2u, 2u, 4u);
+    EXPECT_EQ(RegularGridInterpolator::attach_shared_table(path, SharedTableStorage::file)
+                  .get_number_of_grid_point_data_sets(),
+              2u);
+
+    // Tables that are still being written (the magic is stored last)
+    write_table(0u, 2u, 2u, 4u);
+    EXPECT_THROW(RegularGridInterpolator::attach_shared_table(path, SharedTableStorage::file),
+                 std::runtime_error);
+
+    // Sizes whose products overflow are not used
+    write_table(magic, 64u, 1u, 0u); // 2^64 grid points
+    EXPECT_THROW(RegularGridInterpolator::attach_shared_table(path, SharedTableStorage::file),
+                 std::runtime_error);
+    write_table(magic, 63u, 2u, std::uint64_t {1u} << 63u); // 2^64 values
+    EXPECT_THROW(RegularGridInterpolator::attach_shared_table(path, SharedTableStorage::file),
+                 std::runtime_error);
+    std::filesystem::remove(path);
+}
+#else
+TEST_F(Function4DFixture, shared_table_unsupported)
+{
+    const std::string file_path =
+        (std::filesystem::temp_directory_path() / "btwxt-shared-table.bin").string();
+    EXPECT_THROW(interpolator.publish_shared_table(file_path, SharedTableStorage::file),
+                 std::runtime_error);
+    EXPECT_THROW(RegularGridInterpolator::attach_shared_table(file_path, SharedTableStorage::file),
+                 std::runtime_error);
+}
+#endif // BTWXT_TEST_SHARED_TABLES
+
+TEST_F(FunctionFixture, compressed_grid_point_data_timer)
+{
+    const std::size_t number_of_axes = 6;
+    grid.resize(number_of_axes);
+    for (std::size_t i = 0; i < number_of_axes; i++) {
+        grid[i] = linspace(0.0, 1.0, 12);
+    }
+    functions = {[](std::vector<double> x) -> double {
+        return sin(x[0] + 2 * x[1]) - x[2] * x[3] + exp(x[4] * x[5]);
+    }};
+    setup();
+
+    std::vector<std::vector<double>> set_of_targets(1000, std::vector<double>(number_of_axes));
+    std::size_t seed = 1;
+    for (auto& target : set_of_targets) {
+        for (auto& value : target) {
+            seed = (seed * 1103515245u + 12345u) % 2147483648u;
+            value = static_cast<double>(seed) / 2147483648.;
+        }
+    }
+
+    auto time_targets = [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& target : set_of_targets) {
+            interpolator.set_target(target);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+    };
+
+    auto uncompressed_duration = time_targets();
+    interpolator.set_grid_point_data_compression(0.0);
+    double lossless_ratio = interpolator.get_grid_point_data_compression_ratio();
+    auto lossless_duration = time_targets();
+    interpolator.set_grid_point_data_compression(1e-6);
+    double lossy_ratio = interpolator.get_grid_point_data_compression_ratio();
+    auto lossy_duration = time_targets();
+
+    interpolator.get_courier()->send_info(fmt::format(
+        "Time taken by 1000 6-D interpolations: {} microseconds (uncompressed), {} microseconds "
+        "(lossless, compression ratio {:.2f}), {} microseconds (maximum error 1e-6, compression "
+        "ratio {:.2f})",
+        uncompressed_duration,
+        lossless_duration,
+        lossless_ratio,
+        lossy_duration,
+        lossy_ratio));
+}
+
+TEST_F(Function4DFixture, batch_evaluation)
+{
+    std::vector<std::vector<double>> set_of_targets;
+    for (double x = 0.05; x < 4.5; x += 0.25) {
+        for (double y = -0.5; y < 5.0; y += 0.5) {
+            set_of_targets.push_back({x, y, 4.5 - x, 1.2});
+        }
+    }
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    std::vector<std::vector<double>> expected_results;
+    for (const auto& target : set_of_targets) {
+        expected_results.push_back(interpolator(target));
+    }
+
+    EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets), expected_results);
+
+    interpolator.set_minimum_targets_per_task(7);
+    for (std::size_t number_of_threads : {1u, 2u, 3u, 8u}) {
+        ThreadPool thread_pool(number_of_threads);
+        EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets, thread_pool.get_executor()),
+                  expected_results);
+    }
+
+    // A user-supplied executor (runs tasks in reverse order on the calling thread)
+    std::size_t number_of_tasks_run = 0;
+    TaskExecutor reverse_executor =
+        [&](std::size_t number_of_tasks, const std::function<void(std::size_t)>& task) {
+            number_of_tasks_run = number_of_tasks;
+            for (std::size_t task_index = number_of_tasks; task_index-- > 0;) {
+                task(task_index);
+            }
+        };
+    std::vector<double> flattened_targets;
+    for (const auto& target : set_of_targets) {
+        flattened_targets.insert(flattened_targets.end(), target.begin(), target.end());
+    }
+    std::vector<double> flattened_results(set_of_targets.size() * 2);
+    interpolator.get_values_at_targets(flattened_targets.data(),
+                                       set_of_targets.size(),
+                                       flattened_results.data(),
+                                       reverse_executor);
+    EXPECT_EQ(number_of_tasks_run, set_of_targets.size() / 7);
+    for (std::size_t i = 0; i < set_of_targets.size(); i++) {
+        EXPECT_EQ(flattened_results[2 * i], expected_results[i][0]);
+        EXPECT_EQ(flattened_results[2 * i + 1], expected_results[i][1]);
+    }
+
+    // Small batches are evaluated serially
+    number_of_tasks_run = 0;
+    interpolator.get_values_at_targets({set_of_targets[0]}, reverse_executor);
+    EXPECT_EQ(number_of_tasks_run, 0u);
+}
+
+TEST_F(Grid2DFixture, batch_evaluation_errors)
+{
+    interpolator.set_axis_extrapolation_limits(0, {-5., 20.});
+    interpolator.set_minimum_targets_per_task(1);
+    ThreadPool thread_pool(2);
+    std::vector<std::vector<double>> targets {{1., 5.}, {25., 5.}, {3., 5.}};
+    auto executor = thread_pool.get_executor();
+    EXPECT_STDOUT(EXPECT_THROW(interpolator.get_values_at_targets(targets, executor),
+                               std::runtime_error);
+                  ,
+                  std::string("  [ERROR] RegularGridInterpolator 'Test RGI': GridAxis 'Axis 1': "
+                              "The target (25) is above the extrapolation limit (20).\n"))
+    targets[1] = {2.};
+    EXPECT_STDOUT(EXPECT_THROW(interpolator.get_values_at_targets(targets), std::runtime_error);
+                  ,
+                  std::string("  [ERROR] RegularGridInterpolator 'Test RGI': Target (size=1) and "
+                              "grid (size=2) do not have the same dimensions.\n"))
+}
+
+TEST_F(Grid2DFixture, nested_batch_evaluation)
+{
+    // Tasks that evaluate batches with the same pool run the nested tasks on their own thread
+    interpolator.set_minimum_targets_per_task(1);
+    ThreadPool thread_pool(4);
+    auto executor = thread_pool.get_executor();
+    std::vector<std::vector<double>> targets {{1., 5.}, {12., 5.5}, {3., 6.}, {7.5, 4.5}};
+    auto expected_results = interpolator.get_values_at_targets(targets);
+    std::vector<std::vector<std::vector<double>>> nested_results(8);
+    executor(nested_results.size(), [&](std::size_t task_index) {
+        nested_results[task_index] = interpolator.get_values_at_targets(targets, executor);
+    });
+    for (const auto& results : nested_results) {
+        EXPECT_EQ(results, expected_results);
+    }
+
+    // Exceptions from nested tasks reach the outer caller
+    EXPECT_THROW(executor(2,
+                          [&](std::size_t) {
+                              executor(2, [](std::size_t nested_task_index) {
+                                  if (nested_task_index == 1u) {
+                                      throw std::runtime_error("Nested task failed.");
+                                  }
+                              });
+                          }),
+                 std::runtime_error);
+}
+
+TEST_F(Grid2DFixture, target_column_evaluation)
+{
+    // Interpolation, extrapolation (linear along the first axis, constant along the second), and
+    // grid points. 11 targets, so the last group of lanes is partially filled.
+    std::vector<std::vector<double>> target_columns {
+        {12., -3., 0., 15., 19., 7.5, 10., 1., 14.99, -1., 16.},
+        {5., 5., 4., 6., 7., 3., 4.5, 5.5, 6., 4., 2.}};
+    std::vector<std::vector<double>> targets;
+    for (std::size_t target_index = 0; target_index < target_columns[0].size(); ++target_index) {
+        targets.push_back({target_columns[0][target_index], target_columns[1][target_index]});
+    }
+    auto expected_results = interpolator.get_values_at_targets(targets);
+    auto result_columns = interpolator.get_values_at_target_columns(target_columns);
+    ASSERT_EQ(result_columns.size(), 2u);
+    for (std::size_t target_index = 0; target_index < targets.size(); ++target_index) {
+        EXPECT_EQ(result_columns[0][target_index], expected_results[target_index][0]);
+        EXPECT_EQ(result_columns[1][target_index], expected_results[target_index][1]);
+    }
+
+    // Cubic axes are evaluated one target at a time
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    expected_results = interpolator.get_values_at_targets(targets);
+    result_columns = interpolator.get_values_at_target_columns(target_columns);
+    for (std::size_t target_index = 0; target_index < targets.size(); ++target_index) {
+        EXPECT_EQ(result_columns[0][target_index], expected_results[target_index][0]);
+    }
+
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::linear);
+    interpolator.set_axis_extrapolation_limits(0, {-5., 20.});
+    target_columns[0][3] = 25.;
+    EXPECT_STDOUT(EXPECT_THROW(std::ignore = interpolator.get_values_at_target_columns(
+                                   target_columns),
+                               std::runtime_error);
+                  ,
+                  std::string("  [ERROR] RegularGridInterpolator 'Test RGI': GridAxis 'Axis 1': "
+                              "The target (25) is above the extrapolation limit (20).\n"))
+}
+
+TEST(TargetColumns, curve_timer)
+{
+    // 1-D and 2-D curves evaluated many times, one target at a time and in lanes
+    const std::size_t number_of_targets = 1000000;
+    std::size_t seed = 1;
+    auto next_value = [&seed]() {
+        seed = (seed * 1103515245u + 12345u) % 2147483648u;
+        return static_cast<double>(seed) / 2147483648.;
+    };
+    for (std::size_t number_of_axes : {1u, 2u}) {
+        std::vector<std::vector<double>> grid(number_of_axes, linspace(0.0, 1.0, 20));
+        std::vector<double> data;
+        for (const auto& grid_point : cartesian_product(grid)) {
+            data.push_back(std::exp(grid_point[0]) + grid_point.back() * grid_point.back());
+        }
+        RegularGridInterpolator curve(grid, {data});
+        std::vector<std::vector<double>> target_columns(number_of_axes,
+                                                        std::vector<double>(number_of_targets));
+        for (auto& target_column : target_columns) {
+            for (auto& value : target_column) {
+                value = next_value();
+            }
+        }
+
+        std::vector<double> results(number_of_targets);
+        std::vector<double> target(number_of_axes);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t target_index = 0; target_index < number_of_targets; ++target_index) {
+            for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+                target[axis_index] = target_columns[axis_index][target_index];
+            }
+            results[target_index] = curve.get_value_at_target(target, 0);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto single_duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+
+        start = std::chrono::high_resolution_clock::now();
+        auto result_columns = curve.get_values_at_target_columns(target_columns);
+        stop = std::chrono::high_resolution_clock::now();
+        auto lane_duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+        EXPECT_EQ(result_columns[0], results);
+
+        curve.get_courier()->send_info(
+            fmt::format("Time taken by {} {}-D interpolations: {} milliseconds (one at a time), {} "
+                        "milliseconds (lanes)",
+                        number_of_targets,
+                        number_of_axes,
+                        single_duration.count(),
+                        lane_duration.count()));
+    }
+}
+
+TEST_F(Grid2DFixture, copies_share_grid_point_data)
+{
+    RegularGridInterpolator copy(interpolator);
+    EXPECT_EQ(&copy.get_grid_point_data_set(0), &interpolator.get_grid_point_data_set(0));
+    copy.normalize_grid_point_data_sets_at_target(target);
+    EXPECT_NE(&copy.get_grid_point_data_set(0), &interpolator.get_grid_point_data_set(0));
+    EXPECT_THAT(copy(target), testing::ElementsAre(testing::DoubleEq(1.), testing::DoubleEq(1.)));
+    EXPECT_THAT(interpolator(target),
+                testing::ElementsAre(testing::DoubleEq(4.2), testing::DoubleEq(8.4)));
+}
+
+TEST_F(Function4DFixture, batch_timer)
+{
+    std::vector<double> flattened_targets(200000 * 4);
+    std::size_t seed = 1;
+    for (auto& value : flattened_targets) {
+        seed = (seed * 1103515245u + 12345u) % 2147483648u;
+        value = 4.5 * static_cast<double>(seed) / 2147483648.;
+    }
+    std::size_t number_of_targets = flattened_targets.size() / 4;
+    std::vector<double> serial_results(number_of_targets * 2);
+    std::vector<double> parallel_results(number_of_targets * 2);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    interpolator.get_values_at_targets(
+        flattened_targets.data(), number_of_targets, serial_results.data());
+    auto stop = std::chrono::high_resolution_clock::now();
+    auto serial_duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+
+    ThreadPool thread_pool;
+    start = std::chrono::high_resolution_clock::now();
+    interpolator.get_values_at_targets(flattened_targets.data(),
+                                       number_of_targets,
+                                       parallel_results.data(),
+                                       thread_pool.get_executor());
+    stop = std::chrono::high_resolution_clock::now();
+    auto parallel_duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    EXPECT_EQ(serial_results, parallel_results);
+
+    interpolator.get_courier()->send_info(
+        fmt::format("Time taken by {} interpolations: {} milliseconds (serial), {} milliseconds "
+                    "({} threads)",
+                    number_of_targets,
+                    serial_duration.count(),
+                    parallel_duration.count(),
+                    thread_pool.get_number_of_threads()));
+}
+
+TEST_F(Function4DFixture, set_target_axis)
+{
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    interpolator.set_axis_extrapolation_method(2, ExtrapolationMethod::linear);
+    RegularGridInterpolator reference(interpolator);
+    interpolator.set_target(target);
+    std::vector<double> current_target = target;
+    for (std::size_t axis_index = 0; axis_index < 4; axis_index++) {
+        for (double value : {2.25, 2.3, 2.35, 0.0, 0.0, 4.5, 5.1, -0.3, 1.5, 1.55}) {
+            interpolator.set_target_axis(axis_index, value);
+            current_target[axis_index] = value;
+            auto expected_results = reference(current_target);
+            EXPECT_THAT(interpolator.get_values_at_target(),
+                        testing::ElementsAre(testing::DoubleNear(expected_results[0], 1e-12),
+                                             testing::DoubleNear(expected_results[1], 1e-12)));
+            EXPECT_EQ(interpolator.get_target(), current_target);
+            EXPECT_EQ(interpolator.get_target_bounds_status(),
+                      reference.get_target_bounds_status());
+        }
+    }
+
+    // Changes to other axes are picked up
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    reference.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    interpolator.set_target_axis(3, 2.0);
+    current_target[3] = 2.0;
+    EXPECT_NEAR(interpolator.get_value_at_target(0), reference(current_target, 0), 1e-12);
+}
+
+TEST_F(Grid2DFixture, set_target_axis_without_target)
+{
+    std::string expected_stdout = "  [ERROR] RegularGridInterpolator 'Test RGI': Cannot set a "
+                                  "single target axis value. No target has been set.\n";
+    EXPECT_STDOUT(EXPECT_THROW(interpolator.set_target_axis(0, 1.), std::runtime_error);
+                  , expected_stdout)
+}
+
+TEST_F(Function4DFixture, reduced_interpolator)
+{
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    interpolator.set_axis_interpolation_method(2, InterpolationMethod::cubic);
+    interpolator.set_axis_extrapolation_method(3, ExtrapolationMethod::linear);
+    const std::vector<std::map<std::size_t, double>> fixed_axis_value_sets {
+        {{1, 3.3}}, {{0, 2.2}, {3, 4.6}}, {{1, 0.0}, {2, 1.4}, {3, -0.2}}, {{0, 4.5}, {2, 0.1}}};
+    for (const auto& fixed_axis_values : fixed_axis_value_sets) {
+        RegularGridInterpolator reduced = interpolator.get_reduced_interpolator(fixed_axis_values);
+        EXPECT_EQ(reduced.get_number_of_dimensions(), 4u - fixed_axis_values.size());
+        EXPECT_EQ(reduced.get_number_of_grid_point_data_sets(), 2u);
+        const std::vector<std::vector<double>> free_targets {
+            {0.1, 2.25, 3.9}, {4.4, 0.0, 1.3}, {3.1, 4.7, 2.0}};
+        for (const auto& free_target : free_targets) {
+            std::vector<double> full_target;
+            std::vector<double> reduced_target;
+            auto free_value = free_target.begin();
+            for (std::size_t axis_index = 0; axis_index < 4; axis_index++) {
+                auto fixed_axis_value = fixed_axis_values.find(axis_index);
+                if (fixed_axis_value != fixed_axis_values.end()) {
+                    full_target.push_back(fixed_axis_value->second);
+                }
+                else {
+                    full_target.push_back(*free_value);
+                    reduced_target.push_back(*free_value);
+                    ++free_value;
+                }
+            }
+            auto expected_results = interpolator(full_target);
+            EXPECT_THAT(reduced(reduced_target),
+                        testing::ElementsAre(testing::DoubleNear(expected_results[0], 1e-12),
+                                             testing::DoubleNear(expected_results[1], 1e-12)));
+        }
+    }
+
+    // Axis settings are carried over to the free axes
+    RegularGridInterpolator reduced = interpolator.get_reduced_interpolator({{0, 1.0}});
+    EXPECT_EQ(reduced.get_grid_axis(0).get_interpolation_method(), InterpolationMethod::cubic);
+    EXPECT_EQ(reduced.get_grid_axis(2).get_extrapolation_method(), ExtrapolationMethod::linear);
+}
+
+TEST_F(Grid2DFixture, reduced_interpolator_errors)
+{
+    std::string expected_stdout = "  [ERROR] RegularGridInterpolator 'Test RGI': Cannot reduce "
+                                  "interpolator. At least one axis must not be fixed.\n";
+    EXPECT_STDOUT(EXPECT_THROW(interpolator.get_reduced_interpolator({{0, 1.}, {1, 5.}}),
+                               std::runtime_error);
+                  , expected_stdout)
+    expected_stdout = "  [ERROR] RegularGridInterpolator 'Test RGI': Axis index, 2, does not "
+                      "exist. Unable to fix axis value. Number of grid axes = 2.\n";
+    EXPECT_STDOUT(EXPECT_THROW(interpolator.get_reduced_interpolator({{2, 1.}}),
+                               std::runtime_error);
+                  , expected_stdout)
+}
+
+TEST_F(Function4DFixture, solve_for_axis_value)
+{
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    interpolator.set_axis_interpolation_method(2, InterpolationMethod::cubic);
+    const std::vector<double> target {1.3, 0.6, 0.0, 3.7};
+    for (std::size_t axis_index : {0u, 2u}) {
+        for (std::size_t data_set_index : {0u, 1u}) {
+            auto full_target = target;
+            full_target[axis_index] = 2.45;
+            const double result = interpolator(full_target, data_set_index);
+            auto solution =
+                interpolator.solve_for_axis_value(target, axis_index, data_set_index, result);
+            ASSERT_NE(solution.status, InverseSolutionStatus::none);
+            for (double axis_value : solution.axis_values) {
+                full_target[axis_index] = axis_value;
+                EXPECT_NEAR(interpolator(full_target, data_set_index), result, 1e-9);
+            }
+            EXPECT_THAT(solution.axis_values, testing::Contains(testing::DoubleNear(2.45, 1e-9)));
+        }
+    }
+
+    // The sum of the axis values is monotonic along each axis
+    auto solution = interpolator.solve_for_axis_value(target, 2, 1, 8.0);
+    EXPECT_EQ(solution.status, InverseSolutionStatus::unique);
+    EXPECT_TRUE(solution.is_monotonic);
+    EXPECT_NEAR(solution.axis_values[0], 2.4, 1e-9);
+    solution = interpolator.solve_for_axis_value(target, 2, 1, 20.0); // Beyond the grid
+    EXPECT_EQ(solution.status, InverseSolutionStatus::none);
+    EXPECT_TRUE(solution.axis_values.empty());
+}
+
+TEST(InverseSolution, non_monotonic_and_extrapolated)
+{
+    RegularGridInterpolator interpolator(std::vector<std::vector<double>> {{0, 1, 2, 3}},
+                                         std::vector<std::vector<double>> {{0, 2, 1, 3}});
+    auto solution = interpolator.solve_for_axis_value({0.0}, 0, 0, 1.5);
+    EXPECT_EQ(solution.status, InverseSolutionStatus::multiple);
+    EXPECT_FALSE(solution.is_monotonic);
+    EXPECT_THAT(solution.axis_values, testing::ElementsAre(0.75, 1.5, 2.25));
+    solution = interpolator.solve_for_axis_value({0.0}, 0, 0, 2.0); // At a grid point
+    EXPECT_THAT(solution.axis_values, testing::ElementsAre(1.0, 2.5));
+
+    // Linear extrapolation within the limits
+    interpolator.set_axis_extrapolation_method(0, ExtrapolationMethod::linear);
+    interpolator.set_axis_extrapolation_limits(0, {-1.0, 10.0});
+    solution = interpolator.solve_for_axis_value({0.0}, 0, 0, 7.0);
+    EXPECT_EQ(solution.status, InverseSolutionStatus::unique);
+    EXPECT_THAT(solution.axis_values, testing::ElementsAre(5.0));
+    solution = interpolator.solve_for_axis_value({0.0}, 0, 0, -2.0);
+    EXPECT_THAT(solution.axis_values, testing::ElementsAre(-1.0));
+    solution = interpolator.solve_for_axis_value({0.0}, 0, 0, -3.0); // Beyond the lower limit
+    EXPECT_EQ(solution.status, InverseSolutionStatus::none);
+}
+
+TEST(InverseSolution, quadratic_cell)
+{
+    // Along the flat middle cell, the cubic curve is the quadratic 1 + (t - t^2) / 2, which peaks
+    // at 1.125 halfway across
+    RegularGridInterpolator interpolator(std::vector<std::vector<double>> {{0, 1, 2, 3}},
+                                         std::vector<std::vector<double>> {{0, 1, 1, 0}});
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    auto solution = interpolator.solve_for_axis_value({0.0}, 0, 0, 1.1);
+    EXPECT_EQ(solution.status, InverseSolutionStatus::multiple);
+    EXPECT_FALSE(solution.is_monotonic);
+    ASSERT_EQ(solution.axis_values.size(), 2u);
+    EXPECT_NEAR(solution.axis_values[0], 1.5 - std::sqrt(0.05), 1e-12);
+    EXPECT_NEAR(solution.axis_values[1], 1.5 + std::sqrt(0.05), 1e-12);
+    solution = interpolator.solve_for_axis_value({0.0}, 0, 0, 1.2);
+    EXPECT_EQ(solution.status, InverseSolutionStatus::none);
+}
+
+TEST_F(Function2DFixture, integral_bilinear)
+{
+    // The integral of x * y over [2, 7] x [1, 3]
+    const std::map<std::size_t, std::pair<double, double>> box {{0, {2.0, 7.0}}, {1, {1.0, 3.0}}};
+    EXPECT_NEAR(interpolator.get_integral({0.0, 0.0}, box)[0], 90.0, 1e-12);
+    EXPECT_NEAR(interpolator.get_mean({0.0, 0.0}, box)[0], 9.0, 1e-12);
+    EXPECT_NEAR(interpolator.get_integral({0.0, 0.0}, {{0, {7.0, 2.0}}, {1, {1.0, 3.0}}})[0],
+                -90.0,
+                1e-12);
+
+    // Along one axis, with the other at its target value
+    EXPECT_NEAR(interpolator.get_integral({0.0, 2.5}, {{0, {2.0, 7.0}}})[0], 56.25, 1e-12);
+    EXPECT_NEAR(interpolator.get_mean({4.0, 0.0}, {{1, {1.5, 1.5}}})[0], 6.0, 1e-12);
+
+    // Constant extrapolation beyond the grid
+    EXPECT_NEAR(interpolator.get_integral({0.0, 1.0}, {{0, {2.0, 9.0}}})[0], 36.5, 1e-12);
+    interpolator.set_axis_extrapolation_limits(0, {0.0, 10.0});
+    EXPECT_THROW(std::ignore = interpolator.get_integral({0.0, 1.0}, {{0, {-1.0, 5.0}}}),
+                 std::runtime_error);
+}
+
+TEST_F(Function4DFixture, integral)
+{
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    interpolator.set_axis_extrapolation_method(2, ExtrapolationMethod::linear);
+
+    // Matches a fine midpoint rule over interpolated values along a cubic axis
+    const std::size_t number_of_samples = 20000u;
+    const double lower_bound = 0.3;
+    const double upper_bound = 3.7;
+    const double width = (upper_bound - lower_bound) / static_cast<double>(number_of_samples);
+    std::vector<double> sums(2, 0.0);
+    auto sample_target = target;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t sample_index = 0; sample_index < number_of_samples; ++sample_index) {
+        sample_target[1] = lower_bound + (static_cast<double>(sample_index) + 0.5) * width;
+        auto results = interpolator(sample_target);
+        sums[0] += results[0] * width;
+        sums[1] += results[1] * width;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    auto sampled_duration = std::chrono::duration<double, std::milli>(stop - start).count();
+    // The samples filled the hypercube cache, which integration does not copy
+    const auto memory_usage = interpolator.get_memory_usage();
+    EXPECT_GT(memory_usage.hypercube_cache, 0u);
+    start = std::chrono::steady_clock::now();
+    auto integral = interpolator.get_integral(target, {{1, {lower_bound, upper_bound}}});
+    stop = std::chrono::steady_clock::now();
+    auto integral_duration = std::chrono::duration<double, std::milli>(stop - start).count();
+    EXPECT_NEAR(integral[0], sums[0], 1e-6);
+    EXPECT_NEAR(integral[1], sums[1], 1e-6);
+    EXPECT_EQ(interpolator.get_memory_usage().get_total(), memory_usage.get_total());
+    interpolator.get_courier()->send_info(
+        fmt::format("Integral along one axis: {:.3f} milliseconds ({:.1f} milliseconds for {} "
+                    "samples)",
+                    integral_duration,
+                    sampled_duration,
+                    number_of_samples));
+
+    // Linear data is reproduced by every method, including linear extrapolation
+    auto mean = interpolator.get_mean(target, {{0, {0.3, 3.7}}, {2, {-1.0, 2.2}}});
+    EXPECT_NEAR(mean[1], 2.0 + target[1] + 0.6 + target[3], 1e-12);
+
+    interpolator.set_axis_interpolation_method(2, InterpolationMethod::simplex);
+    interpolator.set_axis_interpolation_method(3, InterpolationMethod::simplex);
+    EXPECT_THROW(std::ignore = interpolator.get_mean(target, {{0, {0.3, 3.7}}}),
+                 std::runtime_error);
+}
+
+TEST_F(Function4DFixture, result_cache)
+{
+    interpolator.enable_result_cache(1e-9);
+    RegularGridInterpolator reference(interpolator);
+    reference.disable_result_cache();
+    auto expected_results = reference(target);
+    EXPECT_EQ(interpolator(target), expected_results);
+    std::vector<double> nearby_target {2.2 + 1e-12, 3.3, 1.4, 4.1 - 1e-12};
+    EXPECT_EQ(interpolator(nearby_target), expected_results);
+    auto statistics = interpolator.get_result_cache_statistics();
+    EXPECT_EQ(statistics.number_of_hits, 1u);
+    EXPECT_EQ(statistics.number_of_misses, 1u);
+    EXPECT_EQ(statistics.number_of_entries, 1u);
+    EXPECT_DOUBLE_EQ(statistics.get_hit_rate(), 0.5);
+
+    // State skipped by a cache hit is recalculated when needed
+    EXPECT_EQ(interpolator.get_target(), nearby_target);
+    EXPECT_EQ(interpolator.get_neighboring_indices_at_target(),
+              reference.get_neighboring_indices_at_target(nearby_target));
+    interpolator.set_target_axis(0, 0.7);
+    nearby_target[0] = 0.7;
+    expected_results = reference(nearby_target);
+    EXPECT_THAT(interpolator.get_values_at_target(),
+                testing::ElementsAre(testing::DoubleNear(expected_results[0], 1e-12),
+                                     testing::DoubleNear(expected_results[1], 1e-12)));
+
+    // Changes to data or axis settings clear the cache
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    reference.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    EXPECT_EQ(interpolator(target), reference(target));
+    EXPECT_EQ(interpolator.get_result_cache_statistics().number_of_entries, 1u);
+    interpolator.normalize_grid_point_data_sets_at_target(2.0);
+    reference.normalize_grid_point_data_sets_at_target(2.0);
+    EXPECT_EQ(interpolator.get_result_cache_statistics().number_of_entries, 0u);
+    EXPECT_EQ(interpolator(target), reference(target));
+    interpolator.add_grid_point_data_set(interpolator.get_grid_point_data_set(0));
+    EXPECT_EQ(interpolator.get_result_cache_statistics().number_of_entries, 0u);
+    EXPECT_EQ(interpolator(target).size(), 3u);
+}
+
+TEST_F(Function4DFixture, result_cache_memory_limit)
+{
+    const std::vector<double> target_a {0.1, 0.2, 0.3, 0.4};
+    const std::vector<double> target_b {1.1, 1.2, 1.3, 1.4};
+    const std::vector<double> target_c {2.1, 2.2, 2.3, 2.4};
+    interpolator.enable_result_cache();
+    interpolator(target_a);
+    std::size_t entry_memory_size = interpolator.get_result_cache_statistics().memory_size;
+    interpolator.enable_result_cache(0.0, 2 * entry_memory_size);
+    interpolator(target_b);
+    interpolator(target_a);
+    interpolator(target_c); // Evicts target_b (least recently used)
+    auto statistics = interpolator.get_result_cache_statistics();
+    EXPECT_EQ(statistics.number_of_entries, 2u);
+    EXPECT_EQ(statistics.number_of_evictions, 1u);
+    EXPECT_LE(statistics.memory_size, 2 * entry_memory_size);
+    interpolator(target_a);
+    interpolator(target_c);
+    EXPECT_EQ(interpolator.get_result_cache_statistics().number_of_hits, 3u);
+    interpolator(target_b);
+    EXPECT_EQ(interpolator.get_result_cache_statistics().number_of_misses, 4u);
+
+    interpolator.disable_result_cache();
+    EXPECT_EQ(interpolator.get_result_cache_statistics().number_of_entries, 0u);
+}
+
+TEST_F(Function4DFixture, result_cache_tolerance)
+{
+    interpolator.enable_result_cache(0.1);
+    RegularGridInterpolator reference(interpolator);
+    reference.disable_result_cache();
+
+    // Batches do not share results between nearby targets, however they are split
+    std::vector<std::vector<double>> targets;
+    for (std::size_t target_index = 0; target_index < 64; ++target_index) {
+        targets.push_back({2.2 + 0.001 * static_cast<double>(target_index), 3.3, 1.4, 4.1});
+    }
+    interpolator(target);
+    auto expected_results = reference.get_values_at_targets(targets);
+    EXPECT_EQ(interpolator.get_values_at_targets(targets), expected_results);
+    ThreadPool thread_pool(4);
+    interpolator.set_minimum_targets_per_task(4);
+    EXPECT_EQ(interpolator.get_values_at_targets(targets, thread_pool.get_executor()),
+              expected_results);
+
+    // Targets beyond the extrapolation limits send errors, even if a nearby target was cached
+    interpolator.set_axis_extrapolation_limits(0, {0.0, 4.5});
+    std::vector<double> target_within_limits {4.49, 3.3, 1.4, 4.1};
+    std::vector<double> target_beyond_limits {4.51, 3.3, 1.4, 4.1};
+    interpolator(target_within_limits);
+    EXPECT_THROW(interpolator(target_beyond_limits), std::runtime_error);
+}
+
+TEST_F(Grid2DFixture, memory_usage)
+{
+    auto memory_usage = interpolator.get_memory_usage();
+    EXPECT_EQ(memory_usage.grid_point_data, 2 * 6 * sizeof(double));
+    EXPECT_GE(memory_usage.grid_axes, 5 * sizeof(double));
+    EXPECT_EQ(memory_usage.result_cache, 0u);
+    EXPECT_GT(memory_usage.scratch, 0u);
+    EXPECT_EQ(memory_usage.get_total(),
+              memory_usage.grid_axes + memory_usage.grid_point_data +
+                  memory_usage.hypercube_cache + memory_usage.scratch);
+
+    // Each grid cell evaluated adds to the hypercube cache until the budget is reached
+    interpolator({1, 5});
+    std::size_t cell_memory_size = interpolator.get_memory_usage().hypercube_cache;
+    EXPECT_GT(cell_memory_size, 0u);
+    interpolator.set_hypercube_cache_memory_budget(2 * cell_memory_size);
+    interpolator({11, 5});
+    EXPECT_EQ(interpolator.get_memory_usage().hypercube_cache, 2 * cell_memory_size);
+    EXPECT_THAT(interpolator({-1, 5}),
+                testing::ElementsAre(testing::DoubleEq(4.45), testing::DoubleEq(8.9)));
+    EXPECT_EQ(interpolator.get_memory_usage().hypercube_cache, 2 * cell_memory_size);
+
+    // Copies keep the budget but start with an empty cache
+    RegularGridInterpolator copy(interpolator);
+    EXPECT_EQ(copy.get_memory_usage().hypercube_cache, 0u);
+    copy({1, 5});
+    copy({11, 5});
+    copy({3, 5});
+    EXPECT_EQ(copy.get_memory_usage().hypercube_cache, 2 * cell_memory_size);
+
+    interpolator.set_hypercube_cache_memory_budget(0u);
+    EXPECT_EQ(interpolator.get_memory_usage().hypercube_cache, 0u);
+    EXPECT_THAT(interpolator(target),
+                testing::ElementsAre(testing::DoubleEq(4.2), testing::DoubleEq(8.4)));
+    EXPECT_EQ(interpolator.get_memory_usage().hypercube_cache, 0u);
+}
+
+TEST_F(Grid2DFixture, evaluation_costs)
+{
+    // Axis 1 is extrapolated as a constant
+    auto costs = interpolator.get_evaluation_costs();
+    ASSERT_EQ(costs.size(), 2u);
+    EXPECT_EQ(costs[0].number_of_linear_axes, 2u);
+    EXPECT_EQ(costs[0].number_of_vertices, 4u);
+    EXPECT_EQ(costs[0].bytes_gathered, 4 * 2 * sizeof(double));
+    EXPECT_EQ(costs[1].number_of_constant_axes, 1u);
+    EXPECT_EQ(costs[1].number_of_vertices, 2u);
+
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    interpolator.set_axis_extrapolation_limits(1, {4, 6}); // No extrapolation along axis 1
+    costs = interpolator.get_evaluation_costs();
+    ASSERT_EQ(costs.size(), 2u);
+    EXPECT_EQ(costs[0].number_of_cubic_axes, 1u);
+    EXPECT_EQ(costs[0].number_of_vertices, 8u);
+    EXPECT_EQ(costs[1].number_of_linear_axes, 2u);
+    EXPECT_EQ(costs[1].number_of_vertices, 4u);
+}
+
+TEST(SimplexInterpolation, two_dimensions)
+{
+    RegularGridInterpolator interpolator(std::vector<std::vector<double>> {{0.0, 1.0}, {0.0, 1.0}},
+                                         std::vector<std::vector<double>> {{0.0, 2.0, 1.0, 10.0}});
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::simplex);
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::simplex);
+    // Fraction 0.5 along axis 1 exceeds 0.25 along axis 0: vertices (0, 0), (0, 1), and (1, 1)
+    EXPECT_DOUBLE_EQ(interpolator({0.25, 0.5}, 0), 0.5 * 0.0 + 0.25 * 2.0 + 0.25 * 10.0);
+    EXPECT_DOUBLE_EQ(interpolator({0.5, 0.25}, 0), 0.5 * 0.0 + 0.25 * 1.0 + 0.25 * 10.0);
+    EXPECT_DOUBLE_EQ(interpolator({0.5, 0.5}, 0), 0.5 * 0.0 + 0.5 * 10.0); // On the diagonal
+    EXPECT_DOUBLE_EQ(interpolator({1.0, 0.0}, 0), 1.0);
+
+    auto costs = interpolator.get_evaluation_costs(); // Or constant extrapolation along either axis
+    ASSERT_EQ(costs.size(), 3u);
+    EXPECT_EQ(costs[0].number_of_simplex_axes, 2u);
+    EXPECT_EQ(costs[0].number_of_vertices, 3u);
+
+    // Along a single axis, simplex is linear
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::linear);
+    EXPECT_DOUBLE_EQ(interpolator({0.25, 0.5}, 0), 0.375 * 0.0 + 0.375 * 2.0 + 0.125 * 1.0 +
+                                                       0.125 * 10.0);
+}
+
+TEST_F(Function4DFixture, simplex_interpolation)
+{
+    // Linear functions are reproduced exactly (within and beyond the grid)
+    for (std::size_t axis_index = 0; axis_index < 4; ++axis_index) {
+        interpolator.set_axis_interpolation_method(axis_index, InterpolationMethod::simplex);
+    }
+    interpolator.set_axis_extrapolation_method(3, ExtrapolationMethod::linear);
+    const std::vector<std::vector<double>> set_of_targets {
+        {2.2, 3.3, 1.4, 4.1}, {0.1, 0.2, 0.3, 0.4}, {4.4, 0.05, 2.5, 5.0}, {1.0, 1.5, 2.0, 2.5}};
+    for (const auto& simplex_target : set_of_targets) {
+        EXPECT_NEAR(interpolator(simplex_target, 1), functions[1](simplex_target), 1e-12);
+    }
+    auto get_interpolation_cost = [&]() {
+        auto costs = interpolator.get_evaluation_costs();
+        return *std::find_if(costs.begin(), costs.end(), [](const EvaluationCost& cost) {
+            return cost.number_of_constant_axes == 0u && cost.number_of_linear_axes == 0u;
+        });
+    };
+    EXPECT_EQ(get_interpolation_cost().number_of_vertices, 5u);
+
+    // Batch and single-axis evaluation match
+    auto expected_results = interpolator.get_values_at_targets(set_of_targets);
+    {
+        ThreadPool thread_pool(2);
+        interpolator.set_minimum_targets_per_task(1);
+        EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets, thread_pool.get_executor()),
+                  expected_results);
+    }
+    interpolator.set_target(set_of_targets[0]);
+    interpolator.set_target_axis(2, 0.3);
+    EXPECT_EQ(interpolator.get_values_at_target(),
+              interpolator.get_values_at_target({2.2, 3.3, 0.3, 4.1}));
+
+    // The path steps through blocked grid point data in the same way
+    RegularGridInterpolator blocked_interpolator(interpolator);
+    blocked_interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked);
+    EXPECT_EQ(blocked_interpolator.get_values_at_targets(set_of_targets), expected_results);
+
+    // Combined with cubic interpolation along another axis
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    EXPECT_NEAR(interpolator(set_of_targets[0], 1), functions[1](set_of_targets[0]), 1e-12);
+    EXPECT_EQ(get_interpolation_cost().number_of_vertices, 4u * 4u);
+
+    EXPECT_THROW(std::ignore = interpolator.get_reduced_interpolator({{1, 2.0}}),
+                 std::runtime_error);
+    EXPECT_NO_THROW(std::ignore = interpolator.get_reduced_interpolator({{0, 2.0}}));
+    EXPECT_THROW(std::ignore = interpolator.solve_for_axis_value(target, 0, 1, 10.0),
+                 std::runtime_error);
+}
+
+TEST(SimplexInterpolation, timer)
+{
+    // Speed and accuracy (maximum error from the tabulated function) of simplex and linear
+    // interpolation in four through eight dimensions
+    auto function = [](const std::vector<double>& x) {
+        double value = 0.0;
+        for (std::size_t axis_index = 0; axis_index < x.size(); ++axis_index) {
+            value += sin(x[axis_index] + 0.3 * static_cast<double>(axis_index)) * x[0];
+        }
+        return value;
+    };
+    for (std::size_t number_of_axes = 4; number_of_axes <= 8; ++number_of_axes) {
+        std::vector<std::vector<double>> grid(number_of_axes, linspace(0.0, 2.0, 6));
+        std::vector<double> data;
+        for (const auto& grid_point : cartesian_product(grid)) {
+            data.push_back(function(grid_point));
+        }
+        RegularGridInterpolator interpolator(grid, std::vector<std::vector<double>> {data});
+        RegularGridInterpolator simplex_interpolator(interpolator);
+        for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+            simplex_interpolator.set_axis_interpolation_method(axis_index,
+                                                               InterpolationMethod::simplex);
+        }
+        std::vector<std::vector<double>> set_of_targets(20000,
+                                                        std::vector<double>(number_of_axes));
+        std::size_t seed = 1;
+        for (auto& simplex_target : set_of_targets) {
+            for (auto& value : simplex_target) {
+                seed = (seed * 1103515245u + 12345u) % 2147483648u;
+                value = 2.0 * static_cast<double>(seed) / 2147483648.;
+            }
+        }
+        std::vector<double> durations;
+        std::vector<double> maximum_errors;
+        for (auto* evaluator : {&interpolator, &simplex_interpolator}) {
+            evaluator->set_hypercube_cache_memory_budget(0u);
+            double maximum_error = 0.0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (const auto& simplex_target : set_of_targets) {
+                maximum_error =
+                    std::max(maximum_error,
+                             std::abs((*evaluator)(simplex_target, 0) - function(simplex_target)));
+            }
+            auto stop = std::chrono::high_resolution_clock::now();
+            durations.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+            maximum_errors.push_back(maximum_error);
+        }
+        EXPECT_LT(maximum_errors[1], 0.5);
+
+        interpolator.get_courier()->send_info(
+            fmt::format("Time taken by {} {}-D interpolations: {:.1f} milliseconds (linear), "
+                        "{:.1f} milliseconds (simplex). Maximum errors: {:.2e} (linear), {:.2e} "
+                        "(simplex)",
+                        set_of_targets.size(),
+                        number_of_axes,
+                        durations[0],
+                        durations[1],
+                        maximum_errors[0],
+                        maximum_errors[1]));
+    }
+}
+
+TEST_F(Function4DFixture, shared_hypercube_cache)
+{
+    std::vector<std::vector<double>> set_of_targets;
+    for (std::size_t target_index = 0; target_index < 5000; ++target_index) {
+        std::vector<double> target(grid.size());
+        for (std::size_t axis_index = 0; axis_index < grid.size(); ++axis_index) {
+            target[axis_index] =
+                1.5 * static_cast<double>((target_index * (7 + 4 * axis_index)) % 101) / 100.0;
+        }
+        set_of_targets.push_back(target);
+    }
+    auto expected_results = interpolator.get_values_at_targets(set_of_targets);
+
+    interpolator.enable_shared_hypercube_cache();
+    EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets), expected_results);
+    EXPECT_GT(interpolator.get_memory_usage().hypercube_cache, 1u << 23u);
+    {
+        ThreadPool thread_pool(8);
+        interpolator.set_minimum_targets_per_task(16);
+        EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets, thread_pool.get_executor()),
+                  expected_results);
+
+        // Cubic hypercubes need larger entries
+        interpolator.set_axis_interpolation_method(2, InterpolationMethod::cubic);
+        RegularGridInterpolator cubic_interpolator(grid, data_sets);
+        cubic_interpolator.set_axis_interpolation_method(2, InterpolationMethod::cubic);
+        auto cubic_results = cubic_interpolator.get_values_at_targets(set_of_targets);
+        EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets, thread_pool.get_executor()),
+                  cubic_results);
+        EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets), cubic_results);
+        interpolator.set_axis_interpolation_method(2, InterpolationMethod::linear);
+
+        // Small enough that cells evict each other
+        interpolator.enable_shared_hypercube_cache(8u * 1024u);
+        EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets, thread_pool.get_executor()),
+                  expected_results);
+    }
+
+    // A copy shares the cache until its grid point data changes
+    RegularGridInterpolator copy(interpolator);
+    copy.normalize_grid_point_data_sets_at_target(target, 2.0);
+    RegularGridInterpolator normalized_interpolator(grid, data_sets);
+    normalized_interpolator.normalize_grid_point_data_sets_at_target(target, 2.0);
+    EXPECT_EQ(copy.get_values_at_targets(set_of_targets),
+              normalized_interpolator.get_values_at_targets(set_of_targets));
+    EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets), expected_results);
+
+    interpolator.disable_shared_hypercube_cache();
+    EXPECT_EQ(interpolator.get_values_at_targets(set_of_targets), expected_results);
+}
+
+TEST_F(Function4DFixture, shared_hypercube_cache_timer)
+{
+    // Targets are concentrated in a few hundred (hot) grid cells
+    std::vector<double> flattened_targets(100000 * 4);
+    std::size_t seed = 1;
+    for (auto& value : flattened_targets) {
+        seed = (seed * 1103515245u + 12345u) % 2147483648u;
+        value = 1.5 * static_cast<double>(seed) / 2147483648.;
+    }
+    const std::size_t number_of_targets = flattened_targets.size() / 4;
+    std::vector<double> expected_results(number_of_targets * 2);
+    interpolator.get_values_at_targets(
+        flattened_targets.data(), number_of_targets, expected_results.data());
+    interpolator.set_minimum_targets_per_task(64);
+
+    enum class CacheMode { none, per_thread, shared };
+    std::string report = "Time taken by 100000 interpolations (milliseconds):\n"
+                         "  threads  no cache  per-thread caches  shared cache";
+    for (std::size_t number_of_threads = 1; number_of_threads <= 64; number_of_threads *= 2) {
+        ThreadPool thread_pool(number_of_threads);
+        std::vector<double> durations;
+        for (auto mode : {CacheMode::none, CacheMode::per_thread, CacheMode::shared}) {
+            RegularGridInterpolator evaluator(interpolator);
+            evaluator.set_hypercube_cache_memory_budget(mode == CacheMode::none ? 0u : SIZE_MAX);
+            if (mode == CacheMode::shared) {
+                evaluator.enable_shared_hypercube_cache();
+            }
+            std::vector<double> results(number_of_targets * 2);
+            auto start = std::chrono::high_resolution_clock::now();
+            evaluator.get_values_at_targets(flattened_targets.data(),
+                                            number_of_targets,
+                                            results.data(),
+                                            thread_pool.get_executor());
+            auto stop = std::chrono::high_resolution_clock::now();
+            durations.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+            EXPECT_EQ(results, expected_results);
+        }
+        report += fmt::format("\n  {:>7}  {:>8.1f}  {:>17.1f}  {:>12.1f}",
+                              number_of_threads,
+                              durations[0],
+                              durations[1],
+                              durations[2]);
+    }
+    interpolator.get_courier()->send_info(report);
+}
+
+TEST_F(Function4DFixture, stage_tracing)
+{
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    reset_trace();
+    set_trace_event_recording(true, 100);
+    for (std::size_t target_index = 0; target_index < 50; ++target_index) {
+        interpolator.set_target({0.08 * target_index, 3.3, 1.4, 4.1});
+        interpolator.set_target_axis(3, 0.05 * target_index);
+    }
+    set_trace_event_recording(false);
+
+    std::ostringstream chrome_trace;
+    write_chrome_trace(chrome_trace);
+    std::ostringstream csv_profile;
+    write_trace_profile_csv(csv_profile);
+    EXPECT_EQ(csv_profile.str().substr(0, csv_profile.str().find('\n')),
+              "stage,count,total_ns,mean_ns,minimum_ns,maximum_ns,p50_ns,p90_ns,p99_ns");
+
+    auto profiles = get_trace_stage_profiles();
+    if (!tracing_is_enabled()) {
+        EXPECT_TRUE(profiles.empty());
+        EXPECT_EQ(chrome_trace.str(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+        return;
+    }
+    ASSERT_EQ(profiles.size(), number_of_trace_stages);
+    for (const auto& profile : profiles) {
+        SCOPED_TRACE(std::string(get_trace_stage_name(profile.stage)));
+        EXPECT_GE(profile.count, 50u);
+        EXPECT_EQ(std::accumulate(profile.histogram.begin(), profile.histogram.end(), 0ull),
+                  profile.count);
+        EXPECT_LE(profile.minimum_duration, profile.maximum_duration);
+        EXPECT_LE(profile.get_quantile(0.5), profile.get_quantile(0.99));
+        EXPECT_LE(profile.get_quantile(0.99), static_cast<double>(profile.maximum_duration));
+    }
+    EXPECT_NE(chrome_trace.str().find("\"name\":\"floor_search\""), std::string::npos);
+    EXPECT_NE(csv_profile.str().find("\nreduction,"), std::string::npos);
+
+    // Events beyond the maximum are not recorded
+    std::size_t number_of_events = 0u;
+    for (auto position = chrome_trace.str().find("\"ph\""); position != std::string::npos;
+         position = chrome_trace.str().find("\"ph\"", position + 1u)) {
+        ++number_of_events;
+    }
+    EXPECT_EQ(number_of_events, 100u);
+
+    reset_trace();
+    EXPECT_EQ(get_trace_stage_profiles()[0].count, 0u);
+}
+
+TEST_F(Function4DFixture, result_cache_timer)
+{
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::cubic);
+    std::vector<std::vector<double>> operating_points = {{0.1, 0.1, 0.1, 0.1},
+                                                         {3.3, 2.2, 4.1, 1.4},
+                                                         {2.1, 1.6, 1.6, 2.1},
+                                                         {3.7, 4.3, 0.8, 2.1},
+                                                         {1.9, 3.4, 1.2, 1.1}};
+    const std::size_t number_of_repetitions = 10000;
+    auto time_evaluations = [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t repetition = 0; repetition < number_of_repetitions; ++repetition) {
+            for (const auto& operating_point : operating_points) {
+                interpolator.set_target(operating_point);
+            }
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    };
+    auto uncached_duration = time_evaluations();
+    interpolator.enable_result_cache(1e-9);
+    auto cached_duration = time_evaluations();
+    interpolator.get_courier()->send_info(
+        fmt::format("Time taken by {} interpolations: {} milliseconds (uncached), {} milliseconds "
+                    "(cached, hit rate {:.4f})",
+                    number_of_repetitions * operating_points.size(),
+                    uncached_duration.count(),
+                    cached_duration.count(),
+                    interpolator.get_result_cache_statistics().get_hit_rate()));
+}
+
 TEST_F(Grid2DFixture, write_data)
 {
     EXPECT_EQ("Axis 1,Axis 2,Data Set 1,Data Set 2,\n"
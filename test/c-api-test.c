@@ -0,0 +1,110 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+/* Exercises the C interface from C. Returns nonzero if any check fails. */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <btwxt/btwxt-c.h>
+
+static int number_of_failures = 0;
+
+static void check(int condition, const char* description)
+{
+    if (!condition) {
+        printf("FAILED: %s (%s)\n", description, btwxt_get_last_error_message());
+        ++number_of_failures;
+    }
+}
+
+static int near(double a, double b)
+{
+    return fabs(a - b) < 1e-12;
+}
+
+int main(void)
+{
+    /* Same grid as the Grid2DFixture tests */
+    const size_t axis_lengths[2] = {3, 2};
+    const double axis_values[5] = {0, 10, 15, 4, 6};
+    const double grid_point_data[12] = {6, 3, 2, 8, 4, 2, 12, 6, 4, 16, 8, 4};
+    btwxt_interpolator* interpolator = NULL;
+    check(btwxt_create_interpolator(2, axis_lengths, axis_values, 2, grid_point_data,
+                                    &interpolator) == BTWXT_SUCCESS,
+          "create interpolator");
+    if (!interpolator) {
+        return 1;
+    }
+
+    size_t number_of_dimensions = 0;
+    size_t number_of_data_sets = 0;
+    check(btwxt_get_number_of_dimensions(interpolator, &number_of_dimensions) == BTWXT_SUCCESS &&
+              number_of_dimensions == 2,
+          "number of dimensions");
+    check(btwxt_get_number_of_data_sets(interpolator, &number_of_data_sets) == BTWXT_SUCCESS &&
+              number_of_data_sets == 2,
+          "number of data sets");
+
+    const double target[2] = {12, 5};
+    double results[2] = {0, 0};
+    check(btwxt_evaluate(interpolator, target, results) == BTWXT_SUCCESS, "evaluate");
+    check(near(results[0], 4.2) && near(results[1], 8.4), "evaluated results");
+
+    const double targets[6] = {12, 5, 8.1, 4.2, 17, 5};
+    double batch_results[6] = {0, 0, 0, 0, 0, 0};
+    check(btwxt_set_axis_extrapolation_method(interpolator, 0, BTWXT_EXTRAPOLATION_LINEAR) ==
+              BTWXT_SUCCESS,
+          "set extrapolation method");
+    check(btwxt_evaluate_batch(interpolator, targets, 3, batch_results) == BTWXT_SUCCESS,
+          "evaluate batch");
+    check(near(batch_results[0], 4.2) && near(batch_results[3], 6.378) &&
+              near(batch_results[4], 2.2),
+          "batch results");
+
+    check(btwxt_set_axis_interpolation_method(interpolator, 0, BTWXT_INTERPOLATION_CUBIC) ==
+              BTWXT_SUCCESS,
+          "set interpolation method");
+    check(btwxt_evaluate(interpolator, target, results) == BTWXT_SUCCESS, "evaluate cubic");
+
+    check(btwxt_set_axis_interpolation_method(interpolator, 0, BTWXT_INTERPOLATION_SIMPLEX) ==
+                  BTWXT_SUCCESS &&
+              btwxt_set_axis_interpolation_method(interpolator, 1, BTWXT_INTERPOLATION_SIMPLEX) ==
+                  BTWXT_SUCCESS,
+          "set simplex interpolation method");
+    check(btwxt_evaluate(interpolator, target, results) == BTWXT_SUCCESS, "evaluate simplex");
+    check(btwxt_set_axis_interpolation_method(interpolator, 1, BTWXT_INTERPOLATION_LINEAR) ==
+              BTWXT_SUCCESS,
+          "restore interpolation method");
+
+    /* Errors are returned as status codes */
+    check(btwxt_set_axis_extrapolation_limits(interpolator, 0, 0, 20) == BTWXT_SUCCESS,
+          "set extrapolation limits");
+    const double beyond_limits[2] = {25, 5};
+    check(btwxt_evaluate(interpolator, beyond_limits, results) == BTWXT_ERROR_INTERPOLATOR,
+          "target beyond extrapolation limits");
+    check(strstr(btwxt_get_last_error_message(), "extrapolation limit") != NULL,
+          "error message");
+    check(btwxt_set_axis_interpolation_method(interpolator, 5, BTWXT_INTERPOLATION_LINEAR) ==
+              BTWXT_ERROR_INTERPOLATOR,
+          "axis index out of range");
+    check(btwxt_evaluate(interpolator, NULL, results) == BTWXT_ERROR_INVALID_ARGUMENT,
+          "null target");
+    check(btwxt_evaluate(interpolator, target, results) == BTWXT_SUCCESS,
+          "evaluate after errors");
+
+    btwxt_interpolator* unsorted = NULL;
+    const double unsorted_axis_values[5] = {0, 15, 10, 4, 6};
+    check(btwxt_create_interpolator(2, axis_lengths, unsorted_axis_values, 2, grid_point_data,
+                                    &unsorted) == BTWXT_ERROR_INTERPOLATOR &&
+              unsorted == NULL,
+          "unsorted axis");
+
+    btwxt_destroy_interpolator(interpolator);
+    btwxt_destroy_interpolator(NULL);
+    if (number_of_failures == 0) {
+        printf("C API tests passed\n");
+    }
+    return number_of_failures == 0 ? 0 : 1;
+}
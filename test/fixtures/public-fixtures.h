@@ -129,4 +129,41 @@ class Function4DFixture : public FunctionFixture {
     }
 };
 
+class SparseGridFixture : public FunctionFixture {
+    // A full grid (with axis lengths of 2^k + 1) for comparing sparse grids with linear
+    // interpolation
+  public:
+    std::vector<GridAxis> grid_axes;
+    SparseGridInterpolator::GridPointFunction grid_point_function;
+    std::vector<std::vector<double>> targets;
+
+  protected:
+    SparseGridFixture()
+    {
+        grid = {linspace(0.0, 2.0, 9),
+                {0.0, 0.1, 0.3, 0.6, 1.0, 1.5, 2.1, 2.8, 3.6},
+                linspace(-1.0, 1.0, 5)};
+        functions = {[](std::vector<double> x) -> double {
+                         return sin(x[0]) * cos(x[1]) + x[2] * x[2];
+                     },
+                     [](std::vector<double> x) -> double {
+                         return 1.0 + x[0] + 2.0 * x[1] * x[2] + x[0] * x[1] * x[2];
+                     }};
+        setup();
+        interpolator.set_axis_extrapolation_method(0, ExtrapolationMethod::linear);
+        for (const auto& axis_values : grid) {
+            grid_axes.emplace_back(axis_values);
+        }
+        grid_axes[0].set_extrapolation_method(ExtrapolationMethod::linear);
+        grid_point_function = [this](const std::vector<double>& x) {
+            return std::vector<double> {functions[0](x), functions[1](x)};
+        };
+        targets = {{0.37, 1.21, 0.2},
+                   {1.95, 3.5, -0.9},
+                   {1.0, 0.6, 0.0},
+                   {-0.5, 4.0, 0.7},
+                   {2.6, -1.0, 1.2}};
+    }
+};
+
 } // namespace Btwxt
\ No newline at end of file
@@ -2,10 +2,13 @@
  * See the LICENSE file for additional terms and conditions. */
 
 // Standard
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
 
 // Vendor
+#include <fmt/format.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -73,4 +76,77 @@ TEST(GridAxis, bad_limits)
                                std::runtime_error);
                   , expected_out)
 }
-} // namespace Btwxt
\ No newline at end of file
+
+TEST(GridAxis, floor_index)
+{
+    // Non-uniform axes of every length up to (and past) a complete search tree
+    for (std::size_t length = 1; length <= 33; ++length) {
+        std::vector<double> values(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            values[i] = static_cast<double>(i * i) + 0.5 * static_cast<double>(i);
+        }
+        GridAxis grid_axis(values);
+        std::vector<double> targets {values.front() - 1.0, values.back() + 1.0};
+        for (std::size_t i = 0; i < length; ++i) {
+            targets.push_back(values[i]);
+            targets.push_back(values[i] + 0.25);
+        }
+        const auto maximum_floor =
+            static_cast<std::ptrdiff_t>(std::max(length, std::size_t {2}) - 2);
+        for (double target : targets) {
+            const auto expected_floor = std::clamp<std::ptrdiff_t>(
+                std::upper_bound(values.begin(), values.end(), target) - values.begin() - 1,
+                0,
+                maximum_floor);
+            EXPECT_EQ(grid_axis.get_floor_index(target), static_cast<std::size_t>(expected_floor))
+                << "length " << length << ", target " << target;
+        }
+    }
+}
+
+TEST(GridAxis, floor_search_timer)
+{
+    auto courier = std::make_shared<BtwxtDefaultCourier>();
+    static constexpr std::size_t number_of_targets {1000000u};
+    for (std::size_t length : {10u, 100u, 1000u, 10000u, 100000u}) {
+        std::vector<double> values(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            values[i] = static_cast<double>(i) + 1e-3 * static_cast<double>(i * i);
+        }
+        GridAxis grid_axis(values);
+        std::vector<double> targets(number_of_targets);
+        std::uint32_t seed {1u};
+        for (auto& target : targets) {
+            seed = (seed * 1103515245u + 12345u) % 2147483648u;
+            target = values.back() * static_cast<double>(seed) / 2147483648.0;
+        }
+
+        std::size_t upper_bound_sum {0u};
+        auto start = std::chrono::high_resolution_clock::now();
+        for (double target : targets) {
+            upper_bound_sum += std::max<std::ptrdiff_t>(
+                std::upper_bound(values.begin(), values.end(), target) - values.begin() - 1, 0);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        auto upper_bound_duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+
+        std::size_t floor_index_sum {0u};
+        start = std::chrono::high_resolution_clock::now();
+        for (double target : targets) {
+            floor_index_sum += grid_axis.get_floor_index(target);
+        }
+        stop = std::chrono::high_resolution_clock::now();
+        auto floor_index_duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+
+        EXPECT_EQ(floor_index_sum, upper_bound_sum);
+        courier->send_info(fmt::format("{} floor searches of {} values: std::upper_bound {} ms, "
+                                       "get_floor_index {} ms",
+                                       number_of_targets,
+                                       length,
+                                       upper_bound_duration.count() / 1000.0,
+                                       floor_index_duration.count() / 1000.0));
+    }
+}
+} // namespace Btwxt
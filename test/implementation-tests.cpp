@@ -2,7 +2,9 @@
  * See the LICENSE file for additional terms and conditions. */
 
 // Standard
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 // vendor
 #include <fmt/format.h>
@@ -190,6 +192,46 @@ TEST_F(EmptyGridImplementationFixture, locate_coordinates)
     EXPECT_EQ(grid_point_index, 53u);
 }
 
+TEST_F(EmptyGridImplementationFixture, blocked_grid_point_index)
+{
+    grid = {{1, 2, 3, 4, 5}, {1, 2, 3, 4, 5, 6, 7}, {1, 2, 3}};
+    setup();
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked, 2);
+
+    // Blocks are 2 x 2 x 2 points; axes are padded to 6 x 8 x 4 points (3 x 4 x 2 blocks)
+    EXPECT_EQ(interpolator.get_number_of_stored_grid_points(), 6u * 8u * 4u);
+    EXPECT_EQ(interpolator.get_grid_point_index({0, 0, 0}), 0u);
+    EXPECT_EQ(interpolator.get_grid_point_index({0, 0, 1}), 1u);
+    EXPECT_EQ(interpolator.get_grid_point_index({0, 1, 0}), 2u);
+    EXPECT_EQ(interpolator.get_grid_point_index({1, 0, 0}), 4u);
+    EXPECT_EQ(interpolator.get_grid_point_index({0, 0, 2}), 8u);
+    EXPECT_EQ(interpolator.get_grid_point_index({2, 3, 2}), (4u * 2u + 1u * 2u + 1u) * 8u + 2u);
+
+    // Every grid point maps to a unique stored index
+    std::vector<bool> is_used(interpolator.get_number_of_stored_grid_points(), false);
+    for (const auto& coordinates : cartesian_product(std::vector<std::vector<std::size_t>> {
+             {0, 1, 2, 3, 4}, {0, 1, 2, 3, 4, 5, 6}, {0, 1, 2}})) {
+        std::size_t index = interpolator.get_grid_point_index(coordinates);
+        EXPECT_FALSE(is_used[index]);
+        is_used[index] = true;
+    }
+}
+
+TEST_F(Grid3DImplementationFixture, blocked_layout_round_trip)
+{
+    interpolator.set_target(target);
+    auto row_major_results = interpolator.get_results();
+    auto row_major_data = interpolator.get_row_major_grid_point_data(0);
+
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::blocked);
+    EXPECT_EQ(interpolator.get_row_major_grid_point_data(0), row_major_data);
+    EXPECT_EQ(interpolator.get_results(), row_major_results);
+    EXPECT_EQ(interpolator.get_grid_point_data({2, 1, 0}), std::vector<double> {13.});
+
+    interpolator.set_grid_point_data_layout(GridPointDataLayout::row_major);
+    EXPECT_EQ(interpolator.get_grid_point_data_set(0).data, row_major_data);
+}
+
 TEST_F(EmptyGridImplementationFixture, set_axis_floor)
 {
 
@@ -379,4 +421,122 @@ TEST_F(Grid3DImplementationFixture, make_linear_hypercube)
     EXPECT_THAT(hypercube[5], testing::ElementsAre(1, 0, 1));
 }
 
+TEST_F(Grid3DImplementationFixture, zero_weight_vertices_removed)
+{
+    // Constant extrapolation (axis 2) only uses the ceiling
+    interpolator.set_target({26.9, 12, 7});
+    EXPECT_EQ(interpolator.get_hypercube().size(), 2u * 4u * 1u);
+
+    // Every axis is on a grid point (axis 2 at its ceiling)
+    interpolator.set_target({0.2, 10, 6});
+    EXPECT_EQ(interpolator.get_hypercube().size(), 1u);
+    EXPECT_THAT(interpolator.get_hypercube()[0], testing::ElementsAre(0, 0, 1));
+    EXPECT_EQ(interpolator.get_results(), std::vector<double> {2.});
+
+    interpolator.set_target({26.9, 12, 5});
+    EXPECT_EQ(interpolator.get_hypercube().size(), 2u * 4u * 2u);
+}
+
+TEST(CompressedGridPointData, round_trip)
+{
+    std::vector<double> values {0.0,  -0.0, 1.5,      1e300, -1e-300, DBL_MAX, 3.25,
+                                3.5,  3.75, 4.0,      4.25,  NAN,     INFINITY, 7.0,
+                                -7.0, 1.0,  1.0 / 3., 2.0 / 3.};
+    std::vector<GridPointDataSet> grid_point_data_sets {GridPointDataSet(values, "A"),
+                                                        GridPointDataSet(values, "B")};
+    CompressedGridPointData lossless(grid_point_data_sets, 0.0, 4);
+    EXPECT_EQ(lossless.get_number_of_blocks(), 5u);
+    auto decoded_values = lossless.decode_data_set(1);
+    ASSERT_EQ(decoded_values.size(), values.size());
+    EXPECT_EQ(std::memcmp(decoded_values.data(), values.data(), values.size() * sizeof(double)),
+              0);
+
+    const double maximum_error = 0.01;
+    CompressedGridPointData lossy(grid_point_data_sets, maximum_error, 4);
+    decoded_values = lossy.decode_data_set(0);
+    for (std::size_t index = 0; index < values.size(); ++index) {
+        if (std::isfinite(values[index])) {
+            EXPECT_NEAR(decoded_values[index], values[index], maximum_error);
+        }
+        else {
+            EXPECT_EQ(std::isnan(decoded_values[index]), std::isnan(values[index]));
+        }
+    }
+
+    // Blocks are interleaved by grid point
+    std::vector<double> block_values(8);
+    lossy.decode_block(1, block_values.data());
+    EXPECT_EQ(block_values[0], decoded_values[4]);
+    EXPECT_EQ(block_values[1], decoded_values[4]);
+    EXPECT_EQ(block_values[6], decoded_values[7]);
+}
+
+TEST(SharedHypercubeCache, concurrent_readers_and_writers)
+{
+    // Every value of an entry is derived from its key, so a torn read would be detected
+    const std::size_t number_of_vertices = 4;
+    const std::size_t number_of_data_sets = 3;
+    auto get_entry = [&](std::uint64_t floor_grid_point_index) {
+        std::vector<std::vector<double>> entry(number_of_vertices);
+        for (std::size_t vertex_index = 0; vertex_index < number_of_vertices; ++vertex_index) {
+            for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+                 ++data_set_index) {
+                entry[vertex_index].push_back(static_cast<double>(
+                    floor_grid_point_index * 100 + vertex_index * 10 + data_set_index));
+            }
+        }
+        return entry;
+    };
+    SharedHypercubeCache cache(16u * 1024u, number_of_vertices * number_of_data_sets);
+    ASSERT_GT(cache.get_number_of_slots(), 0u);
+    EXPECT_LE(cache.get_memory_size(), 16u * 1024u + sizeof(SharedHypercubeCache));
+
+    std::vector<std::vector<double>> found(number_of_vertices);
+    EXPECT_FALSE(cache.find(7, 1, number_of_data_sets, found));
+    cache.insert(7, 1, get_entry(7));
+    EXPECT_TRUE(cache.find(7, 1, number_of_data_sets, found));
+    EXPECT_EQ(found, get_entry(7));
+    EXPECT_FALSE(cache.find(7, 2, number_of_data_sets, found)); // Different hypercube shape
+    EXPECT_EQ(cache.get_number_of_entries(), 1u);
+
+    // More keys than slots, so entries are evicted while being read
+    std::atomic<std::size_t> number_of_hits {0u};
+    std::atomic<std::size_t> number_of_mismatches {0u};
+    std::vector<std::thread> threads;
+    for (std::size_t thread_index = 0; thread_index < 8; ++thread_index) {
+        threads.emplace_back([&, thread_index]() {
+            std::vector<std::vector<double>> thread_found(number_of_vertices);
+            for (std::uint64_t iteration = 0; iteration < 20000; ++iteration) {
+                std::uint64_t floor_grid_point_index = (iteration * 7 + thread_index) % 1000;
+                if (cache.find(floor_grid_point_index, 1, number_of_data_sets, thread_found)) {
+                    ++number_of_hits;
+                    if (thread_found != get_entry(floor_grid_point_index)) {
+                        ++number_of_mismatches;
+                    }
+                }
+                else {
+                    cache.insert(floor_grid_point_index, 1, get_entry(floor_grid_point_index));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_GT(number_of_hits.load(), 0u);
+    EXPECT_EQ(number_of_mismatches.load(), 0u);
+    EXPECT_LE(cache.get_number_of_entries(), cache.get_number_of_slots());
+
+    // Entries larger than a slot are not cached
+    std::vector<std::vector<double>> large_entry(number_of_vertices + 1,
+                                                 std::vector<double>(number_of_data_sets));
+    cache.insert(2000, 1, large_entry);
+    EXPECT_FALSE(cache.find(2000, 1, number_of_data_sets, large_entry));
+
+    SharedHypercubeCache empty_cache(8u, number_of_vertices * number_of_data_sets);
+    EXPECT_EQ(empty_cache.get_number_of_slots(), 0u);
+    empty_cache.insert(7, 1, get_entry(7));
+    EXPECT_FALSE(empty_cache.find(7, 1, number_of_data_sets, found));
+}
+
 } // namespace Btwxt
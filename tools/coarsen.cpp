@@ -0,0 +1,62 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Removes grid axis points from a table while every data set is reproduced within a tolerance.
+
+// Standard
+#include <iostream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+// btwxt
+#include "table-csv.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5) {
+        std::cerr << fmt::format(
+            "Usage: {} <input table> <number of axes> <tolerance> <output table> [cubic]\n"
+            "Tables are CSV files with one column per axis followed by one column per data set.\n"
+            "With 'cubic', every axis is interpolated with cubic interpolation.\n",
+            argv[0]);
+        return 1;
+    }
+    try {
+        auto interpolator = Btwxt::read_table_csv(argv[1], std::stoul(argv[2]));
+        const double tolerance = std::stod(argv[3]);
+        if (argc > 5 && std::string(argv[5]) == "cubic") {
+            for (std::size_t axis_index = 0; axis_index < interpolator.get_number_of_dimensions();
+                 ++axis_index) {
+                interpolator.set_axis_interpolation_method(axis_index,
+                                                           Btwxt::InterpolationMethod::cubic);
+            }
+        }
+        auto coarsened = interpolator.get_coarsened_interpolator(tolerance);
+        Btwxt::write_table_csv(argv[4], coarsened.interpolator);
+
+        std::cout << fmt::format("Grid points: {} -> {}\n",
+                                 interpolator.get_number_of_grid_points(),
+                                 coarsened.interpolator.get_number_of_grid_points());
+        for (std::size_t axis_index = 0; axis_index < interpolator.get_number_of_dimensions();
+             ++axis_index) {
+            std::cout << fmt::format(
+                "  Axis '{}': {} -> {} points\n",
+                interpolator.get_grid_axis(axis_index).name,
+                interpolator.get_grid_axis(axis_index).get_length(),
+                coarsened.interpolator.get_grid_axis(axis_index).get_length());
+        }
+        for (std::size_t data_set_index = 0;
+             data_set_index < interpolator.get_number_of_grid_point_data_sets();
+             ++data_set_index) {
+            std::cout << fmt::format("  Data set '{}': maximum error {}\n",
+                                     interpolator.get_grid_point_data_set(data_set_index).name,
+                                     coarsened.maximum_errors[data_set_index]);
+        }
+    }
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
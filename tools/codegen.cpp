@@ -0,0 +1,69 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Writes a table as a C++ header with constexpr data and a specialized evaluation function.
+
+// Standard
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+// btwxt
+#include "header-generator.h"
+#include "table-csv.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5) {
+        std::cerr << fmt::format(
+            "Usage: {} <input table> <number of axes> <namespace> <output header> [options]\n"
+            "Tables are CSV files with one column per axis followed by one column per data set.\n"
+            "Options (axes use linear interpolation and constant extrapolation by default):\n"
+            "  --cubic <axis index>                   Cubic interpolation\n"
+            "  --linear-extrapolation <axis index>    Linear extrapolation\n"
+            "  --extrapolation-limits <axis index> <lower> <upper>\n",
+            argv[0]);
+        return 1;
+    }
+    try {
+        auto interpolator = Btwxt::read_table_csv(argv[1], std::stoul(argv[2]));
+        for (int argument_index = 5; argument_index < argc; ++argument_index) {
+            std::string option = argv[argument_index];
+            auto next_argument = [&]() -> std::string {
+                if (++argument_index >= argc) {
+                    throw std::runtime_error(fmt::format("Missing value for '{}'.", option));
+                }
+                return argv[argument_index];
+            };
+            if (option == "--cubic") {
+                interpolator.set_axis_interpolation_method(std::stoul(next_argument()),
+                                                           Btwxt::InterpolationMethod::cubic);
+            }
+            else if (option == "--linear-extrapolation") {
+                interpolator.set_axis_extrapolation_method(std::stoul(next_argument()),
+                                                           Btwxt::ExtrapolationMethod::linear);
+            }
+            else if (option == "--extrapolation-limits") {
+                std::size_t axis_index = std::stoul(next_argument());
+                double lower = std::stod(next_argument());
+                double upper = std::stod(next_argument());
+                interpolator.set_axis_extrapolation_limits(axis_index, {lower, upper});
+            }
+            else {
+                throw std::runtime_error(fmt::format("Unknown option '{}'.", option));
+            }
+        }
+        std::ofstream header(argv[4]);
+        if (!header) {
+            throw std::runtime_error(fmt::format("Unable to open '{}' for writing.", argv[4]));
+        }
+        header << Btwxt::generate_interpolator_header(interpolator, argv[3]);
+    }
+    catch (const std::exception& exception) {
+        std::cerr << exception.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
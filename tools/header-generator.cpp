@@ -0,0 +1,289 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+// btwxt
+#include "header-generator.h"
+
+namespace Btwxt {
+
+namespace {
+
+// 17 significant digits so that every value is parsed back exactly
+std::string format_double(double value)
+{
+    return fmt::format("{:.17g}", value);
+}
+
+std::string format_array(const std::vector<double>& values)
+{
+    std::string text;
+    for (std::size_t index = 0; index < values.size(); ++index) {
+        const char* separator = index == 0 ? "" : index % 4 == 0 ? ",\n    " : ", ";
+        text += separator + format_double(values[index]);
+    }
+    return text;
+}
+
+std::string generate_axis_weights_function(const GridAxis& grid_axis, std::size_t axis_index)
+{
+    const std::size_t length = grid_axis.get_length();
+    std::string text = fmt::format("constexpr AxisWeights axis_{}_weights(double x)\n{{\n"
+                                   "    AxisWeights axis_weights;\n",
+                                   axis_index);
+    if (length == 1) {
+        text += "    static_cast<void>(x);\n"
+                "    axis_weights.weights[2] = 1.0;\n"
+                "    return axis_weights;\n}\n";
+        return text;
+    }
+
+    auto limits = grid_axis.get_extrapolation_limits();
+    if (limits.first != -DBL_MAX) {
+        text += fmt::format("    x = x < {0} ? {0} : x;\n", format_double(limits.first));
+    }
+    if (limits.second != DBL_MAX) {
+        text += fmt::format("    x = x > {0} ? {0} : x;\n", format_double(limits.second));
+    }
+    text += fmt::format("    constexpr const auto& values = axis_{0}_values;\n"
+                        "    bool is_extrapolating = false;\n"
+                        "    if (x < values[0]) {{\n"
+                        "        is_extrapolating = true;\n"
+                        "    }}\n"
+                        "    else if (x >= values[{1}]) {{\n"
+                        "        axis_weights.floor = {2};\n"
+                        "        is_extrapolating = x > values[{1}];\n"
+                        "    }}\n"
+                        "    else {{\n"
+                        "        axis_weights.floor = find_floor(values, x);\n"
+                        "    }}\n"
+                        "    const std::size_t floor = axis_weights.floor;\n"
+                        "    double mu =\n"
+                        "        (x - values[floor]) / (values[floor + 1] - values[floor]);\n",
+                        axis_index,
+                        length - 1,
+                        length - 2);
+
+    auto linear_weights = "        axis_weights.weights[1] = 1 - mu;\n"
+                          "        axis_weights.weights[2] = mu;\n";
+    text += "    if (is_extrapolating) {\n";
+    if (grid_axis.get_extrapolation_method() == ExtrapolationMethod::constant) {
+        text += "        mu = mu < 0 ? 0 : 1;\n";
+    }
+    text += linear_weights;
+    text += "    }\n    else {\n";
+    if (grid_axis.get_interpolation_method() == InterpolationMethod::cubic) {
+        text += fmt::format(
+            "        const double floor_coefficient = 2 * mu * mu * mu - 3 * mu * mu + 1;\n"
+            "        const double ceiling_coefficient = -2 * mu * mu * mu + 3 * mu * mu;\n"
+            "        const double floor_slope_coefficient =\n"
+            "            (mu * mu * mu - 2 * mu * mu + mu) *\n"
+            "            axis_{0}_floor_spacing_ratios[floor];\n"
+            "        const double ceiling_slope_coefficient =\n"
+            "            (mu * mu * mu - mu * mu) * axis_{0}_ceiling_spacing_ratios[floor];\n"
+            "        axis_weights.weights[0] = -floor_slope_coefficient;\n"
+            "        axis_weights.weights[1] = floor_coefficient - ceiling_slope_coefficient;\n"
+            "        axis_weights.weights[2] = ceiling_coefficient + floor_slope_coefficient;\n"
+            "        axis_weights.weights[3] = ceiling_slope_coefficient;\n",
+            axis_index);
+    }
+    else {
+        text += linear_weights;
+    }
+    text += "    }\n    return axis_weights;\n}\n";
+    return text;
+}
+
+} // namespace
+
+std::string generate_interpolator_header(RegularGridInterpolator& interpolator,
+                                         const std::string& namespace_name)
+{
+    if (interpolator.get_grid_point_data_layout() != GridPointDataLayout::row_major) {
+        throw std::runtime_error("Generated headers require grid point data in row-major order.");
+    }
+    std::size_t number_of_simplex_axes = 0u;
+    for (std::size_t axis_index = 0; axis_index < interpolator.get_number_of_dimensions();
+         ++axis_index) {
+        const auto& grid_axis = interpolator.get_grid_axis(axis_index);
+        if (grid_axis.get_interpolation_method() == InterpolationMethod::simplex &&
+            grid_axis.get_length() > 1) {
+            ++number_of_simplex_axes;
+        }
+    }
+    if (number_of_simplex_axes > 1u) {
+        // Along a single axis, simplex interpolation is linear
+        throw std::runtime_error(
+            "Generated headers do not support simplex interpolation along more than one axis.");
+    }
+    const std::size_t number_of_axes = interpolator.get_number_of_dimensions();
+    const std::size_t number_of_data_sets = interpolator.get_number_of_grid_point_data_sets();
+    const std::size_t number_of_grid_points = interpolator.get_number_of_grid_points();
+
+    std::string text = fmt::format("// Generated by btwxt-codegen. Do not edit.\n"
+                                   "// Results match the btwxt library exactly when compiled "
+                                   "without floating-point\n"
+                                   "// contraction (e.g., -ffp-contract=off with GCC or Clang).\n\n"
+                                   "#pragma once\n\n"
+                                   "#include <array>\n"
+                                   "#include <cstddef>\n\n"
+                                   "namespace {} {{\n\n"
+                                   "inline constexpr std::size_t number_of_axes {{{}}};\n"
+                                   "inline constexpr std::size_t number_of_data_sets {{{}}};\n"
+                                   "inline constexpr std::size_t number_of_grid_points {{{}}};\n\n",
+                                   namespace_name,
+                                   number_of_axes,
+                                   number_of_data_sets,
+                                   number_of_grid_points);
+
+    std::vector<std::string> data_set_names;
+    std::vector<std::vector<double>> data;
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        const auto& data_set = interpolator.get_grid_point_data_set(data_set_index);
+        std::string escaped_name;
+        for (char character : data_set.name) {
+            if (character == '"' || character == '\\') {
+                escaped_name += '\\';
+            }
+            escaped_name += character;
+        }
+        data_set_names.push_back(fmt::format("\"{}\"", escaped_name));
+        data.push_back(data_set.data);
+    }
+    text += fmt::format("inline constexpr const char* data_set_names[] = {{{}}};\n\n",
+                        fmt::join(data_set_names, ", "));
+
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        const auto& grid_axis = interpolator.get_grid_axis(axis_index);
+        text += fmt::format("// Axis {}: '{}'\n", axis_index, grid_axis.name);
+        text += fmt::format("inline constexpr double axis_{}_values[] = {{\n    {}}};\n",
+                            axis_index,
+                            format_array(grid_axis.get_values()));
+        if (grid_axis.get_interpolation_method() == InterpolationMethod::cubic &&
+            grid_axis.get_length() > 1) {
+            text += fmt::format("inline constexpr double axis_{}_floor_spacing_ratios[] = {{\n    "
+                                "{}}};\n",
+                                axis_index,
+                                format_array(grid_axis.get_cubic_spacing_ratios(0)));
+            text += fmt::format("inline constexpr double axis_{}_ceiling_spacing_ratios[] = "
+                                "{{\n    {}}};\n",
+                                axis_index,
+                                format_array(grid_axis.get_cubic_spacing_ratios(1)));
+        }
+        text += "\n";
+    }
+
+    text += "// Row-major (last axis varies fastest), interleaved by grid point\n"
+            "inline constexpr double grid_point_data[number_of_grid_points][number_of_data_sets] "
+            "= {\n";
+    std::vector<double> grid_point_values(number_of_data_sets);
+    for (std::size_t grid_point_index = 0; grid_point_index < number_of_grid_points;
+         ++grid_point_index) {
+        for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+             ++data_set_index) {
+            grid_point_values[data_set_index] = data[data_set_index][grid_point_index];
+        }
+        text += fmt::format("    {{{}}},\n", format_array(grid_point_values));
+    }
+    text += "};\n\n";
+
+    text += "namespace detail {\n\n"
+            "struct AxisWeights {\n"
+            "    std::size_t floor {0};\n"
+            "    double weights[4] {0.0, 0.0, 0.0, 0.0}; // Offsets -1, 0, 1, 2 from the floor\n"
+            "};\n\n"
+            "// Last index with values[index] <= x, for values[0] <= x < values[length - 1]\n"
+            "template <std::size_t length>\n"
+            "constexpr std::size_t find_floor(const double (&values)[length], double x)\n"
+            "{\n"
+            "    std::size_t lower = 0;\n"
+            "    std::size_t upper = length - 1;\n"
+            "    while (upper - lower > 1) {\n"
+            "        std::size_t middle = lower + (upper - lower) / 2;\n"
+            "        if (values[middle] <= x) {\n"
+            "            lower = middle;\n"
+            "        }\n"
+            "        else {\n"
+            "            upper = middle;\n"
+            "        }\n"
+            "    }\n"
+            "    return lower;\n"
+            "}\n\n"
+            "constexpr std::size_t clamp_coordinate(std::ptrdiff_t coordinate,\n"
+            "                                       std::size_t length)\n"
+            "{\n"
+            "    return coordinate < 0 ? 0\n"
+            "                          : static_cast<std::size_t>(coordinate) >= length\n"
+            "                                ? length - 1\n"
+            "                                : static_cast<std::size_t>(coordinate);\n"
+            "}\n\n";
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        text += generate_axis_weights_function(interpolator.get_grid_axis(axis_index), axis_index);
+        text += "\n";
+    }
+    text += "} // namespace detail\n\n";
+
+    // Vertices are visited in the same order as the runtime library (first axis outermost) and
+    // vertices with zero weights are skipped, so results match exactly when the generated code is
+    // also compiled without floating-point contraction (as the library is)
+    text += "constexpr std::array<double, number_of_data_sets>\n"
+            "evaluate(const std::array<double, number_of_axes>& target)\n"
+            "{\n";
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        text += fmt::format(
+            "    const auto axis_{0}_weights = detail::axis_{0}_weights(target[{0}]);\n",
+            axis_index);
+    }
+    text += "    std::array<double, number_of_data_sets> results {};\n";
+    std::string indent = "    ";
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        const auto& grid_axis = interpolator.get_grid_axis(axis_index);
+        const bool is_cubic = grid_axis.get_interpolation_method() == InterpolationMethod::cubic &&
+                              grid_axis.get_length() > 1;
+        const std::string previous_weight =
+            axis_index == 0 ? "1.0" : fmt::format("weight_{}", axis_index - 1);
+        const std::string previous_index =
+            axis_index == 0 ? "0" : fmt::format("index_{}", axis_index - 1);
+        text += fmt::format("{0}for (std::ptrdiff_t offset_{1} = {2}; offset_{1} <= {3}; "
+                            "++offset_{1}) {{\n",
+                            indent,
+                            axis_index,
+                            is_cubic ? -1 : 0,
+                            is_cubic ? 2 : 1);
+        indent += "    ";
+        text += fmt::format(
+            "{0}if (axis_{1}_weights.weights[offset_{1} + 1] == 0.0) {{\n"
+            "{0}    continue;\n"
+            "{0}}}\n"
+            "{0}const double weight_{1} = {2} * axis_{1}_weights.weights[offset_{1} + 1];\n"
+            "{0}const std::size_t index_{1} =\n"
+            "{0}    {3} * {4} + detail::clamp_coordinate(\n"
+            "{0}        static_cast<std::ptrdiff_t>(axis_{1}_weights.floor) + offset_{1}, {4});\n",
+            indent,
+            axis_index,
+            previous_weight,
+            previous_index,
+            grid_axis.get_length());
+    }
+    text += fmt::format("{0}for (std::size_t data_set_index = 0; data_set_index < "
+                        "number_of_data_sets; ++data_set_index) {{\n"
+                        "{0}    results[data_set_index] +=\n"
+                        "{0}        grid_point_data[index_{1}][data_set_index] * weight_{1};\n"
+                        "{0}}}\n",
+                        indent,
+                        number_of_axes - 1);
+    for (std::size_t axis_index = number_of_axes; axis_index-- > 0;) {
+        indent.resize(indent.size() - 4);
+        text += indent + "}\n";
+    }
+    text += "    return results;\n}\n\n";
+    text += fmt::format("}} // namespace {}\n", namespace_name);
+    return text;
+}
+
+} // namespace Btwxt
@@ -0,0 +1,27 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <string>
+
+// btwxt
+#include <btwxt/btwxt.h>
+
+namespace Btwxt {
+
+// Returns the source of a self-contained C++17 header that reproduces the interpolator's results.
+// Axis values and grid point data are constexpr arrays, and each axis's interpolation and
+// extrapolation methods are baked into a constexpr evaluation function:
+//
+//   namespace_name::evaluate(std::array<double, number_of_axes> target)
+//       -> std::array<double, number_of_data_sets>
+//
+// Targets outside the extrapolation limits are clamped to the limits (rather than sending an
+// error). The grid point data must be stored in row-major order, and no more than one axis may be
+// interpolated with simplex.
+std::string generate_interpolator_header(RegularGridInterpolator& interpolator,
+                                         const std::string& namespace_name);
+
+} // namespace Btwxt
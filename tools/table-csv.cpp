@@ -0,0 +1,228 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Standard
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+// btwxt
+#include "table-csv.h"
+
+namespace Btwxt {
+
+namespace {
+
+std::vector<std::string> split_csv_line(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream line_stream(line);
+    std::string field;
+    while (std::getline(line_stream, field, ',')) {
+        auto first = field.find_first_not_of(" \t\r");
+        auto last = field.find_last_not_of(" \t\r");
+        fields.push_back(first == std::string::npos ? "" : field.substr(first, last - first + 1));
+    }
+    return fields;
+}
+
+} // namespace
+
+RegularGridInterpolator read_table_csv(const std::string& path, std::size_t number_of_axes)
+{
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error(fmt::format("Unable to open table '{}'.", path));
+    }
+    std::string line;
+    if (!std::getline(file, line)) {
+        throw std::runtime_error(fmt::format("Table '{}' is empty.", path));
+    }
+    auto column_names = split_csv_line(line);
+    if (column_names.size() <= number_of_axes) {
+        throw std::runtime_error(
+            fmt::format("Table '{}' has {} columns. At least {} are required for {} axes.",
+                        path,
+                        column_names.size(),
+                        number_of_axes + 1,
+                        number_of_axes));
+    }
+    const std::size_t number_of_data_sets = column_names.size() - number_of_axes;
+
+    std::vector<std::vector<double>> rows;
+    std::size_t line_number = 1;
+    while (std::getline(file, line)) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        auto fields = split_csv_line(line);
+        if (fields.size() != column_names.size()) {
+            throw std::runtime_error(
+                fmt::format("Table '{}', line {}: Expected {} values, found {}.",
+                            path,
+                            line_number,
+                            column_names.size(),
+                            fields.size()));
+        }
+        auto& row = rows.emplace_back();
+        for (const auto& field : fields) {
+            try {
+                row.push_back(std::stod(field));
+            }
+            catch (const std::exception&) {
+                throw std::runtime_error(fmt::format(
+                    "Table '{}', line {}: Unable to read value '{}'.", path, line_number, field));
+            }
+        }
+    }
+
+    // Axis values are the distinct values found in each axis column
+    std::vector<std::vector<double>> grid(number_of_axes);
+    std::size_t number_of_grid_points = 1;
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        auto& axis_values = grid[axis_index];
+        for (const auto& row : rows) {
+            axis_values.push_back(row[axis_index]);
+        }
+        std::sort(axis_values.begin(), axis_values.end());
+        axis_values.erase(std::unique(axis_values.begin(), axis_values.end()), axis_values.end());
+        number_of_grid_points *= axis_values.size();
+    }
+    if (rows.size() != number_of_grid_points) {
+        throw std::runtime_error(
+            fmt::format("Table '{}': Found {} rows. The grid of distinct axis values has {} "
+                        "points.",
+                        path,
+                        rows.size(),
+                        number_of_grid_points));
+    }
+
+    std::vector<GridPointDataSet> data_sets;
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        data_sets.emplace_back(std::vector<double>(number_of_grid_points),
+                               column_names[number_of_axes + data_set_index]);
+    }
+    std::vector<bool> is_filled(number_of_grid_points, false);
+    for (const auto& row : rows) {
+        std::size_t grid_point_index = 0;
+        for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+            const auto& axis_values = grid[axis_index];
+            auto coordinate =
+                std::lower_bound(axis_values.begin(), axis_values.end(), row[axis_index]) -
+                axis_values.begin();
+            grid_point_index =
+                grid_point_index * axis_values.size() + static_cast<std::size_t>(coordinate);
+        }
+        if (is_filled[grid_point_index]) {
+            throw std::runtime_error(fmt::format("Table '{}': Duplicate grid point.", path));
+        }
+        is_filled[grid_point_index] = true;
+        for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+             ++data_set_index) {
+            data_sets[data_set_index].data[grid_point_index] = row[number_of_axes + data_set_index];
+        }
+    }
+
+    std::vector<GridAxis> grid_axes;
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        grid_axes.emplace_back(grid[axis_index],
+                               InterpolationMethod::linear,
+                               ExtrapolationMethod::constant,
+                               std::pair<double, double> {-DBL_MAX, DBL_MAX},
+                               column_names[axis_index]);
+    }
+    return RegularGridInterpolator(grid_axes, data_sets, path);
+}
+
+void write_table_csv(const std::string& path, RegularGridInterpolator& interpolator)
+{
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error(fmt::format("Unable to open table '{}' for writing.", path));
+    }
+    const std::size_t number_of_axes = interpolator.get_number_of_dimensions();
+    const std::size_t number_of_data_sets = interpolator.get_number_of_grid_point_data_sets();
+    std::vector<std::string> column_names;
+    std::vector<const std::vector<double>*> axis_values;
+    for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+        const auto& grid_axis = interpolator.get_grid_axis(axis_index);
+        column_names.push_back(grid_axis.name);
+        axis_values.push_back(&grid_axis.get_values());
+    }
+    std::vector<std::vector<double>> data;
+    for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets; ++data_set_index) {
+        const auto& data_set = interpolator.get_grid_point_data_set(data_set_index);
+        column_names.push_back(data_set.name);
+        data.push_back(data_set.data);
+    }
+    file << fmt::format("{}\n", fmt::join(column_names, ","));
+
+    std::vector<std::size_t> coordinates(number_of_axes, 0);
+    std::vector<double> row(number_of_axes + number_of_data_sets);
+    for (std::size_t grid_point_index = 0;
+         grid_point_index < interpolator.get_number_of_grid_points();
+         ++grid_point_index) {
+        for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+            row[axis_index] = (*axis_values[axis_index])[coordinates[axis_index]];
+        }
+        for (std::size_t data_set_index = 0; data_set_index < number_of_data_sets;
+             ++data_set_index) {
+            row[number_of_axes + data_set_index] = data[data_set_index][grid_point_index];
+        }
+        file << fmt::format("{}\n", fmt::join(row, ","));
+        for (std::size_t axis_index = number_of_axes; axis_index-- > 0;) {
+            if (++coordinates[axis_index] < axis_values[axis_index]->size()) {
+                break;
+            }
+            coordinates[axis_index] = 0;
+        }
+    }
+}
+
+void write_table_csv(const std::string& path,
+                     const TableGenerator& generator,
+                     const TaskExecutor& executor)
+{
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error(fmt::format("Unable to open table '{}' for writing.", path));
+    }
+    const auto& grid_axes = generator.get_grid_axes();
+    const std::size_t number_of_axes = grid_axes.size();
+    std::vector<std::string> column_names;
+    for (const auto& grid_axis : grid_axes) {
+        column_names.push_back(grid_axis.name);
+    }
+    const auto& data_set_names = generator.get_data_set_names();
+    column_names.insert(column_names.end(), data_set_names.begin(), data_set_names.end());
+    file << fmt::format("{}\n", fmt::join(column_names, ","));
+
+    std::vector<std::size_t> coordinates(number_of_axes, 0);
+    std::vector<double> row(number_of_axes + data_set_names.size());
+    generator.generate(
+        [&](const std::vector<double>& grid_point_values) {
+            for (std::size_t axis_index = 0; axis_index < number_of_axes; ++axis_index) {
+                row[axis_index] = grid_axes[axis_index].get_values()[coordinates[axis_index]];
+            }
+            std::copy(
+                grid_point_values.begin(), grid_point_values.end(), row.begin() + number_of_axes);
+            file << fmt::format("{}\n", fmt::join(row, ","));
+            for (std::size_t axis_index = number_of_axes; axis_index-- > 0;) {
+                if (++coordinates[axis_index] < grid_axes[axis_index].get_values().size()) {
+                    break;
+                }
+                coordinates[axis_index] = 0;
+            }
+        },
+        executor);
+    if (!file) {
+        throw std::runtime_error(fmt::format("Unable to write table '{}'.", path));
+    }
+}
+
+} // namespace Btwxt
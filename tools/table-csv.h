@@ -0,0 +1,27 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+#pragma once
+
+// Standard
+#include <string>
+
+// btwxt
+#include <btwxt/btwxt.h>
+
+namespace Btwxt {
+
+// Tables are CSV files with a header row of column names. The first number_of_axes columns hold
+// the grid axis values of each grid point and the remaining columns hold the grid point data sets.
+// There is one row per grid point (in any order).
+RegularGridInterpolator read_table_csv(const std::string& path, std::size_t number_of_axes);
+
+// Rows are written in row-major order (last axis varies fastest)
+void write_table_csv(const std::string& path, RegularGridInterpolator& interpolator);
+
+// Streams a generated table (rows are written as chunks of grid points are evaluated)
+void write_table_csv(const std::string& path,
+                     const TableGenerator& generator,
+                     const TaskExecutor& executor = nullptr);
+
+} // namespace Btwxt
@@ -0,0 +1,70 @@
+/* Copyright (c) 2023 Big Ladder Software LLC. All rights reserved.
+ * See the LICENSE file for additional terms and conditions. */
+
+// Vendor
+#include <gtest/gtest.h>
+
+// btwxt
+#include "codegen-test-table.h"
+#include "header-generator.h"
+#include "table-csv.h"
+
+namespace Btwxt {
+
+class CodegenFixture : public testing::Test {
+  protected:
+    RegularGridInterpolator interpolator;
+
+    CodegenFixture() : interpolator(read_table_csv(CODEGEN_TEST_TABLE, 3))
+    {
+        // Same settings as the generated header (see tools/CMakeLists.txt)
+        interpolator.set_axis_interpolation_method(0, InterpolationMethod::cubic);
+        interpolator.set_axis_extrapolation_method(0, ExtrapolationMethod::linear);
+        interpolator.set_axis_extrapolation_limits(1, {-1.0, 5.0});
+    }
+};
+
+TEST_F(CodegenFixture, matches_runtime)
+{
+    static_assert(CodegenTestTable::number_of_axes == 3);
+    static_assert(CodegenTestTable::number_of_data_sets == 2);
+    // Includes grid points, interpolation, and extrapolation along each axis
+    for (double x = -1.0; x <= 6.0; x += 0.125) {
+        for (double y = -1.0; y <= 5.0; y += 0.25) {
+            for (double z : {0.0, 1.0, 2.0}) {
+                auto expected_results = interpolator.get_values_at_target({x, y, z});
+                auto results = CodegenTestTable::evaluate({x, y, z});
+                EXPECT_DOUBLE_EQ(results[0], expected_results[0]) << x << ", " << y << ", " << z;
+                EXPECT_DOUBLE_EQ(results[1], expected_results[1]) << x << ", " << y << ", " << z;
+            }
+        }
+    }
+}
+
+TEST_F(CodegenFixture, constant_evaluation)
+{
+    constexpr auto results = CodegenTestTable::evaluate({1.7, 2.5, 1.0});
+    auto expected_results = interpolator.get_values_at_target({1.7, 2.5, 1.0});
+    EXPECT_DOUBLE_EQ(results[0], expected_results[0]);
+    EXPECT_DOUBLE_EQ(results[1], expected_results[1]);
+}
+
+TEST_F(CodegenFixture, clamped_to_extrapolation_limits)
+{
+    auto results = CodegenTestTable::evaluate({1.7, 10.0, 1.0});
+    auto expected_results = interpolator.get_values_at_target({1.7, 5.0, 1.0});
+    EXPECT_DOUBLE_EQ(results[0], expected_results[0]);
+    EXPECT_DOUBLE_EQ(results[1], expected_results[1]);
+}
+
+TEST_F(CodegenFixture, simplex_axes)
+{
+    // Axis 2 has a single grid point
+    interpolator.set_axis_interpolation_method(1, InterpolationMethod::simplex);
+    interpolator.set_axis_interpolation_method(2, InterpolationMethod::simplex);
+    EXPECT_NO_THROW(generate_interpolator_header(interpolator, "SingleSimplexAxis"));
+    interpolator.set_axis_interpolation_method(0, InterpolationMethod::simplex);
+    EXPECT_THROW(generate_interpolator_header(interpolator, "SimplexAxes"), std::runtime_error);
+}
+
+} // namespace Btwxt